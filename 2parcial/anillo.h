@@ -0,0 +1,95 @@
+/**
+ * @file    anillo.h
+ * @version 1.0
+ * @date    19/10/2026
+ * @title   Anillo de tokens entre el analizador léxico y el sintáctico
+ * @brief   Cola acotada sin candados para un solo productor (Lexico, en su hilo) y un solo
+ *          consumidor (Sintactico, en otro hilo). Así el análisis sintáctico empieza con los
+ *          primeros tokens en lugar de esperar a que termine el léxico, y los tokens no se
+ *          guardan todos en memoria.
+ *
+ *          Cada lado guarda una copia del índice del otro y solo vuelve a leer el índice
+ *          compartido cuando su copia dice que el anillo está lleno (o vacío), de modo que la
+ *          línea de caché del otro lado se toca una vez por vuelta y no una vez por token.
+ */
+
+#ifndef ANILLO_H
+#define ANILLO_H
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+/// Número de tokens del anillo (potencia de 2): 64 KB con tokens de 16 bytes
+#define TAM_ANILLO 4096
+
+class AnilloTokens
+{
+    std::unique_ptr<Token[]> casillas{new Token[TAM_ANILLO]};
+
+    /// Lado del productor: siguiente casilla por escribir y copia de leido
+    alignas(64) std::atomic<size_t> escrito{0};
+    size_t leidoVisto = 0;
+    /// Lado del consumidor: siguiente casilla por leer y copia de escrito
+    alignas(64) std::atomic<size_t> leido{0};
+    size_t escritoVisto = 0;
+    /// El productor ya no agregará tokens
+    alignas(64) std::atomic<bool> cerrado{false};
+
+    /// Espera activa breve y después cede el procesador (con un solo núcleo girar no sirve)
+    static void esperar(unsigned &vueltas)
+    {
+        if (++vueltas < 64)
+            __builtin_ia32_pause();
+        else
+            std::this_thread::yield();
+    }
+
+public:
+    /// Agrega un token; espera si el anillo está lleno. Solo lo llama el productor.
+    void push_back(const Token &t)
+    {
+        size_t e = escrito.load(std::memory_order_relaxed);
+        unsigned vueltas = 0;
+        while (e - leidoVisto == TAM_ANILLO)
+        {
+            leidoVisto = leido.load(std::memory_order_acquire);
+            if (e - leidoVisto == TAM_ANILLO)
+                esperar(vueltas);
+        }
+        casillas[e & (TAM_ANILLO - 1)] = t;
+        escrito.store(e + 1, std::memory_order_release);
+    }
+
+    /// Indica que ya no habrá más tokens. Solo lo llama el productor.
+    void cerrar()
+    {
+        cerrado.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief Saca el siguiente token; espera si el anillo está vacío. Solo lo llama el consumidor.
+     * @return El token, o un token T_EOF cuando el productor cerró el anillo y ya no quedan tokens
+     */
+    Token sacar()
+    {
+        size_t l = leido.load(std::memory_order_relaxed);
+        unsigned vueltas = 0;
+        while (l == escritoVisto)
+        {
+            // cerrado se lee antes que escrito: si ya estaba cerrado, escrito es el definitivo
+            bool fin = cerrado.load(std::memory_order_acquire);
+            escritoVisto = escrito.load(std::memory_order_acquire);
+            if (l != escritoVisto)
+                break;
+            if (fin)
+                return Token{0, 0, T_EOF, SIN_SIMBOLO};
+            esperar(vueltas);
+        }
+        Token t = casillas[l & (TAM_ANILLO - 1)];
+        leido.store(l + 1, std::memory_order_release);
+        return t;
+    }
+};
+
+#endif
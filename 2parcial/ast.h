@@ -0,0 +1,155 @@
+/**
+ * @file    ast.h
+ * @version 1.0
+ * @date    19/10/2026
+ * @title   Árbol sintáctico
+ * @brief   Árbol sintáctico de un archivo guardado en un solo arreglo de nodos: cada nodo se
+ *          agrega al final (como en una arena) y se refiere a sus hijos con índices de 32 bits
+ *          en lugar de apuntadores. Cada nodo tiene su primer hijo y su siguiente hermano, así que
+ *          todos miden 16 bytes, y todo el árbol se libera de una vez.
+ *
+ *          Los identificadores y literales copian su token a una tabla aparte, de modo que el
+ *          árbol no depende del vector de tokens (que en la tubería con AnilloTokens no existe).
+ */
+
+#ifndef AST_H
+#define AST_H
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+/// Índice de un nodo o de un token del árbol
+typedef uint32_t Indice;
+
+/// Índice nulo: sin hijo, sin hermano o sin token
+#define NINGUNO 0xffffffffu
+
+enum TipoNodo : unsigned char
+{
+    N_PROGRAMA,    // hijos: funciones
+    N_FUNCION,     // op: tipo de retorno, token: nombre, hijos: parámetros y bloque
+    N_PARAMETRO,   // op: tipo, token: nombre
+    N_BLOQUE,      // hijos: instrucciones
+    N_DECLARACION, // op: tipo, hijos: variables
+    N_VARIABLE,    // token: nombre, hijo: valor inicial (opcional)
+    N_ASIGNACION,  // token: variable, hijo: expresión
+    N_SI,          // hijos: condición, instrucción, instrucción del else (opcional)
+    N_MIENTRAS,    // hijos: condición, instrucción
+    N_RETORNO,     // token: return, hijo: expresión (opcional)
+    N_LLAMADA,     // token: función, hijos: argumentos
+    N_BINARIA,     // op: operador, hijos: operandos
+    N_UNARIA,      // op: operador, hijo: operando
+    N_ID,          // token: identificador
+    N_ENTERO,      // token: literal
+    N_REAL,        // token: literal
+    N_CADENA,      // token: literal
+    N_NUM
+};
+
+/// Nombre con el que se muestra cada tipo de nodo
+const char nombreNodo[N_NUM][12] = {
+    "programa", "funcion", "parametro", "bloque", "declaracion", "variable", "asignacion", "si",
+    "mientras", "retorno", "llamada", "binaria", "unaria", "id", "entero", "real", "cadena"};
+
+/// Texto de las palabras reservadas y operadores, para mostrar el campo op
+const char textoTipo[T_NUM][7] = {
+    "", "", "", "", "",
+    "else", "float", "if", "int", "return", "void", "while",
+    "+", "-", "*", "/", "=", "<", ">", "!", "==", "!=", "<=", ">=", "&&", "||",
+    "{", "}", "(", ")", ",", ";"};
+
+struct Nodo
+{
+    TipoNodo tipo;
+    /// Operador de N_BINARIA y N_UNARIA, o tipo de dato de funciones, parámetros y declaraciones
+    Tipo op;
+    /// Índice en Ast::tokens del nombre o literal del nodo
+    Indice token;
+    Indice hijo;
+    Indice hermano;
+};
+static_assert(sizeof(Nodo) == 16, "Nodo debe medir 16 bytes");
+
+class Ast
+{
+public:
+    /// Nodos en el orden en que se crearon; la raíz (N_PROGRAMA) es el nodo 0
+    std::vector<Nodo> nodos;
+    /// Tokens de nombres y literales
+    std::vector<Token> tokens;
+
+    /// Descarta el árbol conservando la memoria reservada, para el siguiente archivo
+    void limpiar()
+    {
+        nodos.clear();
+        tokens.clear();
+    }
+
+    /// Agrega un nodo sin hijos; si tk no es nulo copia su token
+    Indice nuevo(TipoNodo tipo, Tipo op = T_EOF, const Token *tk = nullptr)
+    {
+        Indice t = NINGUNO;
+        if (tk)
+        {
+            t = tokens.size();
+            tokens.push_back(*tk);
+        }
+        nodos.push_back(Nodo{tipo, op, t, NINGUNO, NINGUNO});
+        return nodos.size() - 1;
+    }
+
+    /**
+     * @brief Agrega h como último hijo de padre.
+     * @param ultimo Último hijo agregado a padre hasta ahora (NINGUNO al inicio); se actualiza
+     */
+    void agregarHijo(Indice padre, Indice &ultimo, Indice h)
+    {
+        if (ultimo == NINGUNO)
+            nodos[padre].hijo = h;
+        else
+            nodos[ultimo].hermano = h;
+        ultimo = h;
+    }
+
+    const Nodo &operator[](Indice i) const
+    {
+        return nodos[i];
+    }
+
+    /// Token del nombre o literal de un nodo
+    const Token &token(Indice n) const
+    {
+        return tokens[nodos[n].token];
+    }
+
+    size_t size() const
+    {
+        return nodos.size();
+    }
+
+    /// Bytes que ocupa el árbol (nodos y tokens)
+    size_t bytes() const
+    {
+        return nodos.size() * sizeof(Nodo) + tokens.size() * sizeof(Token);
+    }
+
+    /// Muestra el subárbol de n con sangría, un nodo por línea
+    template <class Lex>
+    void imprimir(std::ostream &out, const Lex &lex, Indice n = 0, int nivel = 0) const
+    {
+        for (; n != NINGUNO; n = nodos[n].hermano)
+        {
+            const Nodo &x = nodos[n];
+            out << std::string(nivel * 2, ' ') << nombreNodo[x.tipo];
+            if (x.op != T_EOF)
+                out << " " << textoTipo[x.op];
+            if (x.token != NINGUNO)
+                out << " " << lex.texto(tokens[x.token]) << " (línea " << lex.linea(tokens[x.token]) << ")";
+            out << "\n";
+            imprimir(out, lex, x.hijo, nivel + 1);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,119 @@
+/**
+ * @file    bench_incremental.cpp
+ * @version 1.0
+ * @date    19/10/2026
+ * @brief   Mide LexicoIncremental::editar sobre un archivo de 100 000 líneas: simula que se teclea
+ *          en varios puntos del archivo (insertar y borrar caracteres, saltos de línea y comillas)
+ *          y compara el tiempo por edición contra volver a analizar todo. Cada cierto número de
+ *          ediciones verifica que los tokens sean idénticos a los de un análisis completo.
+ *
+ *          g++ -std=c++17 -O2 bench_incremental.cpp -o bench_incremental && ./bench_incremental > /dev/null
+ */
+
+#include <chrono>
+#include <random>
+#include <sstream>
+#include "incremental.h"
+
+/// Bloque válido del lenguaje que se repite para formar el archivo de prueba
+static const char *bloque =
+    "int suma(int a, int b){\n"
+    "\treturn a+b;\n"
+    "}\n"
+    "\n"
+    "void op(int test)\n"
+    "{\n"
+    "    int lt = 5<6;\n"
+    "    float r = 12.5 * 3.25 / 0.5;\n"
+    "    while(a || b && !c)\n"
+    "    {\n"
+    "        d = d + d - 10;\n"
+    "        printS(\"iteracion \\\"n\\\"\");\n"
+    "    }\n"
+    "}\n";
+
+#define LINEAS 100000
+#define EDICIONES 20000
+#define VERIFICAR_CADA 500
+
+/// Compara los tokens del analizador incremental con un análisis completo del mismo texto
+static bool verificar(const LexicoIncremental &inc)
+{
+    string_view codigo = inc.codigo();
+    std::istringstream in{std::string(codigo)};
+    Lexico lex;
+    lex.cargar(in);
+    std::vector<Token> completo, actual;
+    lex.analizar(completo);
+    inc.tokens(actual);
+    if (completo.size() != actual.size())
+        return false;
+    for (size_t i = 0; i < completo.size(); ++i)
+        if (completo[i].ini != actual[i].ini || completo[i].lon != actual[i].lon ||
+            completo[i].tipo != actual[i].tipo || lex.linea(completo[i]) != inc.linea(actual[i]))
+            return false;
+    return true;
+}
+
+int main()
+{
+    std::string fuente;
+    for (int l = 0; l < LINEAS; l += 14)
+        fuente += bloque;
+    std::istringstream in(fuente);
+
+    LexicoIncremental inc;
+    inc.cargar(in);
+    auto t0 = std::chrono::steady_clock::now();
+    inc.analizar();
+    double completo = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    std::cerr << "fuente: " << fuente.size() / 1e6 << " MB, " << inc.size() << " tokens\n";
+    std::cerr << "análisis completo: " << completo * 1e3 << " ms\n";
+
+    // ediciones: se teclea en un punto y de vez en cuando se salta a otro
+    const char teclas[] = "abz09 .+=;(\"\n";
+    std::mt19937 gen(34);
+    double total = 0, peor = 0;
+    std::vector<double> tiempos;
+    unsigned cursor = fuente.size() / 2;
+    bool ok = true;
+    for (int e = 1; e <= EDICIONES; ++e)
+    {
+        unsigned tam = inc.codigo().size();
+        if (gen() % 50 == 0)
+            cursor = gen() % tam;
+        cursor = std::min(cursor, tam);
+
+        auto t1 = std::chrono::steady_clock::now();
+        if (gen() % 4 == 0 && cursor > 0)
+        {
+            inc.editar(cursor - 1, cursor, "", 0); // retroceso
+            --cursor;
+        }
+        else
+        {
+            char c = teclas[gen() % (sizeof teclas - 1)];
+            inc.editar(cursor, cursor, &c, 1);
+            ++cursor;
+        }
+        double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - t1).count();
+        total += t;
+        tiempos.push_back(t);
+        peor = std::max(peor, t);
+
+        if (e % VERIFICAR_CADA == 0 && !verificar(inc))
+        {
+            std::cerr << "¡TOKENS DIFERENTES después de " << e << " ediciones!\n";
+            ok = false;
+            break;
+        }
+    }
+
+    std::sort(tiempos.begin(), tiempos.end());
+    std::cerr << "edición incremental: " << total / EDICIONES * 1e6 << " us en promedio, "
+              << tiempos[tiempos.size() / 2] * 1e6 << " us la mediana, " << peor * 1e6
+              << " us la peor (saltos lejanos del cursor)\n";
+    std::cerr << "aceleración: " << completo / (total / EDICIONES) << "x  "
+              << (ok ? "tokens idénticos al análisis completo\n" : "\n");
+    return ok ? 0 : EXIT_FAILURE;
+}
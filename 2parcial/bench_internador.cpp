@@ -0,0 +1,117 @@
+/**
+ * @file    bench_internador.cpp
+ * @version 1.0
+ * @date    19/10/2026
+ * @brief   Mide el Internador con varios hilos internando al mismo tiempo identificadores con
+ *          distribución de Zipf (pocos nombres muy repetidos), contra un unordered_map global con
+ *          un candado, y verifica que todos los hilos obtengan el mismo símbolo por nombre.
+ *
+ *          g++ -std=c++17 -O2 -pthread bench_internador.cpp -o bench_internador && ./bench_internador [hilos]
+ */
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include "internador.h"
+
+using namespace std;
+
+/// Nombres distintos y ocurrencias que interna cada hilo
+#define DISTINTOS 20000
+#define OCURRENCIAS 2000000
+
+/// Ejecuta f(h) en n hilos y devuelve los segundos transcurridos
+template <class F>
+static double enHilos(int n, F f)
+{
+    auto t0 = chrono::steady_clock::now();
+    vector<thread> hilos;
+    for (int h = 0; h < n; ++h)
+        hilos.emplace_back(f, h);
+    for (thread &t : hilos)
+        t.join();
+    return chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char *argv[])
+{
+    int nh = argc > 1 ? atoi(argv[1]) : max(4u, thread::hardware_concurrency());
+
+    mt19937 gen(2022);
+    vector<string> nombres;
+    uniform_int_distribution<int> letra('a', 'z'), lon(1, 12);
+    for (int i = 0; i < DISTINTOS; ++i)
+    {
+        string s;
+        for (int k = lon(gen); k > 0; --k)
+            s += char(letra(gen));
+        s += to_string(i); // garantiza que sean distintos
+        nombres.push_back(s);
+    }
+
+    // cada hilo recorre las ocurrencias en distinto orden
+    vector<double> pesos;
+    for (int i = 0; i < DISTINTOS; ++i)
+        pesos.push_back(1.0 / (i + 1));
+    discrete_distribution<int> zipf(pesos.begin(), pesos.end());
+    vector<vector<int>> ocurrencias(nh);
+    for (int h = 0; h < nh; ++h)
+        for (int k = 0; k < OCURRENCIAS; ++k)
+            ocurrencias[h].push_back(zipf(gen));
+
+    double total = double(nh) * OCURRENCIAS / 1e6;
+
+    // referencia: un solo mapa con un candado
+    {
+        mutex m;
+        unordered_map<string, uint32_t> mapa;
+        double t = enHilos(nh, [&](int h) {
+            for (int i : ocurrencias[h])
+            {
+                lock_guard<mutex> g(m);
+                mapa.emplace(nombres[i], mapa.size());
+            }
+        });
+        cout << "unordered_map + mutex      : " << total / t << " Mops/s\n";
+    }
+
+    bool ok = true;
+    for (int modo = 0; modo < 2; ++modo)
+    {
+        Internador in;
+        vector<vector<uint32_t>> ids(nh, vector<uint32_t>(DISTINTOS, SIN_SIMBOLO));
+        double t = enHilos(nh, [&](int h) {
+            CacheSimbolos cache;
+            for (int i : ocurrencias[h])
+            {
+                const string &s = nombres[i];
+                ids[h][i] = modo == 0 ? in.internar(s.data(), s.size()) : cache.internar(in, s.data(), s.size());
+            }
+        });
+        cout << (modo == 0 ? "Internador                 : " : "Internador + CacheSimbolos : ") << total / t << " Mops/s\n";
+
+        // todos los hilos deben coincidir y los símbolos deben ser densos
+        for (int i = 0; i < DISTINTOS; ++i)
+        {
+            uint32_t id = SIN_SIMBOLO;
+            for (int h = 0; h < nh; ++h)
+            {
+                if (ids[h][i] == SIN_SIMBOLO)
+                    continue;
+                if (id != SIN_SIMBOLO && ids[h][i] != id)
+                    ok = false;
+                id = ids[h][i];
+            }
+            if (id != SIN_SIMBOLO && (id >= in.size() || in.texto(id) != nombres[i]))
+                ok = false;
+        }
+        cout << "  símbolos: " << in.size() << "\n";
+    }
+
+    cout << "hilos: " << nh << (ok ? "  símbolos consistentes\n" : "  ¡SÍMBOLOS INCONSISTENTES!\n");
+    return ok ? 0 : EXIT_FAILURE;
+}
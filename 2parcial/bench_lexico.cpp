@@ -0,0 +1,268 @@
+/**
+ * @file    bench_lexico.cpp
+ * @version 1.0
+ * @date    19/10/2026
+ * @brief   Mide cada variante del analizador léxico (flujo, mmap, mmap con internador,
+ *          LexicoIncremental y caché de tokens) sobre un programa sintético generado con
+ *          generador.h: MB/s, tokens/s, reservas de memoria dinámica, pico del heap y pico de
+ *          memoria residente. Por separado mide las dos versiones del autómata generado por
+ *          genlex y el reconocimiento de palabras reservadas.
+ *
+ *          g++ -std=c++17 -O2 bench_lexico.cpp -o bench_lexico
+ *          ./bench_lexico [MB] [semilla] [nombre=valor ...]   (mezcla de tokens como en genfuente)
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <malloc.h>
+#include "generador.h"
+#include "incremental.h"
+
+// operator new de abajo reserva con malloc, así que liberar con free es correcto
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+/// Contadores de memoria dinámica de todo el programa
+static size_t reservas = 0, heapActual = 0, heapPico = 0;
+
+void *operator new(size_t n)
+{
+    void *p = malloc(n ? n : 1);
+    if (!p)
+        throw std::bad_alloc();
+    ++reservas;
+    heapActual += malloc_usable_size(p);
+    heapPico = std::max(heapPico, heapActual);
+    return p;
+}
+
+void operator delete(void *p) noexcept
+{
+    if (p)
+        heapActual -= malloc_usable_size(p);
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    operator delete(p);
+}
+
+/// Reinicia el pico de memoria residente del proceso (VmHWM) al valor actual
+static void reiniciarPicoRSS()
+{
+    FILE *f = fopen("/proc/self/clear_refs", "w");
+    if (f)
+    {
+        fputs("5", f);
+        fclose(f);
+    }
+}
+
+/// Pico de memoria residente del proceso en kB
+static long picoRSS()
+{
+    FILE *f = fopen("/proc/self/status", "r");
+    char linea[256];
+    long kb = -1;
+    while (f && fgets(linea, sizeof linea, f))
+        if (sscanf(linea, "VmHWM: %ld", &kb) == 1)
+            break;
+    if (f)
+        fclose(f);
+    return kb;
+}
+
+/// Recorre el fuente con una versión del autómata generado; devuelve una suma de control
+template <unsigned (*escanear)(const char *, const char *, int &)>
+static unsigned long recorrer(const std::string &fuente, double &seg)
+{
+    unsigned long suma = 0;
+    const char *p = fuente.data(), *fin = p + fuente.size();
+    int tipo;
+    auto t0 = std::chrono::steady_clock::now();
+    while (p < fin)
+    {
+        if (*p == ' ' || *p == '\t' || *p == '\n')
+        {
+            ++p;
+            continue;
+        }
+        unsigned lon = escanear(p, fin, tipo);
+        p += lon ? lon : 1;
+        suma += tipo;
+    }
+    seg = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    return suma;
+}
+
+/// Mide solo el autómata: versión con tabla contra versión codificada con goto
+static void medirAutomatas(const std::string &fuente)
+{
+    double tt, td;
+    unsigned long st = recorrer<afd::tabla::escanear>(fuente, tt);
+    unsigned long sd = recorrer<afd::directo::escanear>(fuente, td);
+
+    double tam = fuente.size() / 1e6;
+    std::cout << "autómata (tabla)  : " << tam / tt << " MB/s\n";
+    std::cout << "autómata (directo): " << tam / td << " MB/s"
+              << (st == sd ? "" : "  ¡DIFERENTES!") << "\n";
+}
+
+/// Búsqueda lineal con strcmp que usaba Lexico::isRW (referencia)
+static bool esReservadaLineal(const char *word)
+{
+    static const char pr[7][10] = {"else", "float", "if", "int", "return", "void", "while"};
+    for (int i = 0; i < 7; ++i)
+        if (strcmp(word, pr[i]) == 0)
+            return true;
+    return false;
+}
+
+/// Mide solo el reconocimiento de palabras reservadas sobre los identificadores del fuente
+static void medirPalabras(const std::string &fuente)
+{
+    std::vector<std::string> ids;
+    for (size_t i = 0; i < fuente.size();)
+    {
+        size_t j = i;
+        while (j < fuente.size() && isalpha((unsigned char)fuente[j]))
+            ++j;
+        if (j > i)
+            ids.push_back(fuente.substr(i, j - i));
+        i = j + 1;
+    }
+
+    unsigned long nl = 0, nh = 0;
+    auto t0 = std::chrono::steady_clock::now();
+    for (const std::string &w : ids)
+        nl += esReservadaLineal(w.c_str());
+    auto t1 = std::chrono::steady_clock::now();
+    for (const std::string &w : ids)
+        nh += buscarPR(w.data(), w.size()) != T_ID;
+    auto t2 = std::chrono::steady_clock::now();
+
+    double n = ids.size() / 1e6;
+    std::cout << "palabras reservadas (strcmp): " << n / std::chrono::duration<double>(t1 - t0).count() << " Mids/s\n";
+    std::cout << "palabras reservadas (hash)  : " << n / std::chrono::duration<double>(t2 - t1).count() << " Mids/s"
+              << (nl == nh ? "" : "  ¡DIFERENTES!") << "\n";
+}
+
+int main(int argc, char *argv[])
+{
+    double mb = argc > 1 ? atof(argv[1]) : 32;
+    const char *ruta = "/tmp/bench_lexico.c";
+    // umbral fijo para que malloc devuelva al sistema los bloques grandes al liberarlos y el pico
+    // de memoria residente de cada variante no incluya memoria retenida de la anterior
+    mallopt(M_MMAP_THRESHOLD, 1 << 17);
+    std::string rutaCache = std::string(ruta) + ".tok";
+
+    Mezcla mezcla;
+    uint64_t semilla = 2022;
+    for (int i = 2; i < argc; ++i)
+        if (!strchr(argv[i], '='))
+            semilla = std::stoull(argv[i]);
+        else if (!mezcla.asignar(argv[i]))
+        {
+            std::cout << "Error: no existe el elemento " << argv[i] << " en la mezcla\n";
+            return EXIT_FAILURE;
+        }
+
+    std::string fuente;
+    GeneradorPrograma(fuente, mezcla, semilla).generar(mb * 1e6);
+    FILE *f = fopen(ruta, "wb");
+    if (!f)
+    {
+        std::cout << "Error: no se pudo crear " << ruta << "\n";
+        return EXIT_FAILURE;
+    }
+    fwrite(fuente.data(), 1, fuente.size(), f);
+    fclose(f);
+    remove(rutaCache.c_str());
+
+    double tam = fuente.size() / 1e6;
+    std::cout << "fuente: " << tam << " MB\n";
+
+    // cada variante devuelve el número de tokens; los contadores de memoria cubren solo la variante
+    auto medir = [&](const char *nombre, std::function<size_t()> variante) {
+        double mejor = 1e30;
+        size_t ntokens = 0, nreservas = 0, pico = 0;
+        long rss = 0;
+        for (int r = 0; r < 3; ++r)
+        {
+            size_t base = heapActual;
+            reservas = 0;
+            heapPico = heapActual;
+            reiniciarPicoRSS();
+            long rssBase = picoRSS();
+            auto t0 = std::chrono::steady_clock::now();
+            ntokens = variante();
+            auto t1 = std::chrono::steady_clock::now();
+            mejor = std::min(mejor, std::chrono::duration<double>(t1 - t0).count());
+            nreservas = reservas;
+            pico = heapPico - base;
+            rss = picoRSS() - rssBase;
+        }
+        std::cout << nombre << ": " << tam / mejor << " MB/s  " << ntokens / mejor / 1e6 << " Mtokens/s  tokens: "
+                  << ntokens << "  reservas: " << nreservas << "  pico heap: " << pico / 1e6
+                  << " MB  pico RSS: +" << rss / 1e3 << " MB\n";
+    };
+
+    medir("fstream              ", [&] {
+        Lexico lex;
+        std::vector<Token> tokens;
+        std::fstream file(ruta);
+        lex.analizar(file, tokens);
+        return tokens.size();
+    });
+    medir("mmap                 ", [&] {
+        Lexico lex;
+        std::vector<Token> tokens;
+        lex.abrir(ruta);
+        lex.analizar(tokens);
+        return tokens.size();
+    });
+    medir("mmap + internador    ", [&] {
+        Lexico lex;
+        Internador in;
+        lex.usarInternador(&in);
+        std::vector<Token> tokens;
+        lex.abrir(ruta);
+        lex.analizar(tokens);
+        return tokens.size();
+    });
+    medir("incremental (inicial)", [&] {
+        LexicoIncremental inc;
+        inc.abrir(ruta);
+        inc.analizar();
+        return inc.size();
+    });
+    {
+        // crea la caché; las mediciones son aciertos
+        Lexico lex;
+        std::vector<Token> tokens;
+        CacheTokens c;
+        lex.abrir(ruta);
+        lex.analizar(tokens);
+        lex.escribirCache(rutaCache.c_str(), tokens, 0, c);
+    }
+    medir("caché de tokens      ", [&] {
+        Lexico lex;
+        CacheTokens c;
+        lex.abrir(ruta);
+        size_t n = 0;
+        if (lex.leerCache(rutaCache.c_str(), c))
+            for (const Token &t : c)
+                n += t.lon != 0;
+        return n;
+    });
+    std::cout << "Token: " << sizeof(Token) << " bytes  tokens por MB: " << unsigned(1e6 / sizeof(Token)) << "\n";
+
+    medirAutomatas(fuente);
+    medirPalabras(fuente);
+
+    remove(ruta);
+    remove(rutaCache.c_str());
+    return 0;
+}
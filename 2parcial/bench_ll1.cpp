@@ -0,0 +1,122 @@
+/**
+ * @file    bench_ll1.cpp
+ * @version 1.0
+ * @date    19/10/2026
+ * @brief   Compara el analizador LL(1) generado por genll (SintacticoLL1) con el descendente
+ *          recursivo (Sintactico) sobre los mismos tokens de un programa generado. Sintactico
+ *          además construye el árbol, así que su tiempo incluye crear los nodos; el LL(1) solo
+ *          reconoce el programa.
+ *
+ *          También comprueba que los dos aceptan y rechazan los mismos programas (quitando un
+ *          token al azar) y que el LL(1) analiza un anidamiento que desbordaría la pila de
+ *          llamadas de Sintactico.
+ *
+ *          g++ -std=c++17 -O2 -pthread bench_ll1.cpp -o bench_ll1
+ *          ./bench_ll1 [MB] [semilla] [nombre=valor ...]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include "generador.h"
+#include "sintactico.h"
+#include "sintactico.cpp"
+
+/// Mejor de 5 ejecuciones de a.analizar(vt), en segundos
+template <class Analizador>
+double medir(Analizador &a, const std::vector<Token> &vt, bool &ok)
+{
+    double mejor = 1e30;
+    for (int r = 0; r < 5; ++r)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        ok = a.analizar(vt);
+        mejor = std::min(mejor, std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+    }
+    return mejor;
+}
+
+int main(int argc, char *argv[])
+{
+    double mb = argc > 1 ? atof(argv[1]) : 32;
+    Mezcla mezcla;
+    uint64_t semilla = 2022;
+    for (int i = 2; i < argc; ++i)
+        if (!strchr(argv[i], '='))
+            semilla = std::stoull(argv[i]);
+        else if (!mezcla.asignar(argv[i]))
+        {
+            std::cout << "Error: no existe el elemento " << argv[i] << " en la mezcla\n";
+            return EXIT_FAILURE;
+        }
+
+    std::string fuente;
+    GeneradorPrograma(fuente, mezcla, semilla).generar(mb * 1e6);
+    std::istringstream in(fuente);
+    Lexico lex;
+    lex.cargar(in);
+    std::vector<Token> vt;
+    if (!lex.analizar(vt))
+        return EXIT_FAILURE;
+
+    Sintactico rd;
+    SintacticoLL1 ll;
+    rd.usarLexico(&lex);
+    ll.usarLexico(&lex);
+    bool okRd, okLl;
+    double tRd = medir(rd, vt, okRd);
+    double tLl = medir(ll, vt, okLl);
+    std::cout << "fuente: " << fuente.size() / 1e6 << " MB  tokens: " << vt.size() << "\n";
+    std::printf("%-28s %9.2f ms  %7.2f Mtokens/s%s\n", "descendente recursivo (AST)", tRd * 1e3,
+                vt.size() / tRd / 1e6, okRd ? "" : "  ¡ERRORES!");
+    std::printf("%-28s %9.2f ms  %7.2f Mtokens/s%s\n", "LL(1) con tabla", tLl * 1e3, vt.size() / tLl / 1e6,
+                okLl ? "" : "  ¡ERRORES!");
+
+    // programas pequeños con un token de menos: los dos deben coincidir en aceptar o rechazar
+    std::ostringstream descartar;
+    rd.usarSalida(descartar);
+    ll.usarSalida(descartar);
+    rd.usarLexico(nullptr);
+    ll.usarLexico(nullptr);
+    std::string chico;
+    GeneradorPrograma(chico, mezcla, semilla + 1).generar(4000);
+    std::istringstream inChico(chico);
+    Lexico lexChico;
+    lexChico.cargar(inChico);
+    std::vector<Token> base;
+    lexChico.analizar(base);
+    unsigned pruebas = 2000, rechazados = 0, diferentes = 0;
+    uint64_t x = semilla;
+    for (unsigned k = 0; k < pruebas; ++k)
+    {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        std::vector<Token> v = base;
+        v.erase(v.begin() + (x >> 33) % v.size());
+        bool a = rd.analizar(v), b = ll.analizar(v);
+        rechazados += !a;
+        diferentes += a != b;
+    }
+    std::cout << "sin un token: " << pruebas << " programas, " << rechazados << " rechazados, " << diferentes
+              << " con resultado distinto\n";
+
+    // int main() { x = ((...(1)...)); } con n paréntesis
+    auto anidado = [](size_t n) {
+        std::vector<Token> v = {{0, 0, T_INT, 0}, {0, 0, T_ID, 0}, {0, 0, T_PARA, 0}, {0, 0, T_PARC, 0},
+                                {0, 0, T_LLAVEA, 0}, {0, 0, T_ID, 0}, {0, 0, T_ASIG, 0}};
+        v.insert(v.end(), n, Token{0, 0, T_PARA, 0});
+        v.push_back(Token{0, 0, T_ENTERO, 0});
+        v.insert(v.end(), n, Token{0, 0, T_PARC, 0});
+        v.push_back(Token{0, 0, T_PYC, 0});
+        v.push_back(Token{0, 0, T_LLAVEC, 0});
+        return v;
+    };
+    for (size_t n : {1000, 1000000})
+    {
+        std::vector<Token> v = anidado(n);
+        auto t0 = std::chrono::steady_clock::now();
+        bool ok = ll.analizar(v);
+        double t = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        std::printf("LL(1) con %7zu paréntesis anidados: %s en %.2f ms\n", n, ok ? "aceptado" : "¡RECHAZADO!", t * 1e3);
+    }
+    std::cout << "(Sintactico usa unas 9 llamadas recursivas por paréntesis; con un millón desborda la pila)\n";
+    return okRd && okLl && !diferentes ? 0 : EXIT_FAILURE;
+}
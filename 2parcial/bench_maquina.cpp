@@ -0,0 +1,187 @@
+/**
+ * @file    bench_maquina.cpp
+ * @version 1.0
+ * @date    19/10/2026
+ * @brief   Mide la máquina virtual (maquina.h) con programas de prueba: un ciclo que suma
+ *          enteros, llamadas recursivas (suma y fib), núcleos aritméticos de float e int, un
+ *          ciclo que llama a una función hoja y otro con llamadas anidadas (programas_prueba.h).
+ *          Cada uno se compila directo a bytecode y también pasando por el optimizador SSA
+ *          (optimizador.h); de cada versión muestra las instrucciones ejecutadas, el tiempo
+ *          (mejor de 3) y las instrucciones por segundo, y revisa que escriba lo esperado. Luego
+ *          muestra cuántas instrucciones SSA deja cada paso del optimizador, y al final mide la
+ *          compilación de un programa generado.
+ *
+ *          g++ -std=c++17 -O2 -pthread bench_maquina.cpp -o bench_maquina
+ *          ./bench_maquina [MB del programa generado]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include "generador.h"
+#include "sintactico.h"
+#include "sintactico.cpp"
+#include "maquina.h"
+#include "optimizador.h"
+#include "programas_prueba.h"
+
+static double ahora()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// Analiza fuente hasta el semántico; false y los errores en diag si no se pudo
+static bool analizar(const std::string &fuente, Lexico &lex, Internador &internador, Sintactico &sin,
+                     Semantico &sem, std::ostream &diag)
+{
+    std::istringstream in(fuente);
+    lex.usarInternador(&internador);
+    lex.usarSalida(diag);
+    lex.cargar(in);
+    std::vector<Token> vt;
+    if (!lex.analizar(vt))
+        return false;
+    sin.usarLexico(&lex);
+    sin.usarSalida(diag);
+    return sin.analizar(vt) && sem.analizar(sin.arbol());
+}
+
+/// Compila el árbol ya analizado a bytecode, directo o con opt si no es nulo
+static bool compilar(Lexico &lex, Sintactico &sin, Semantico &sem, Programa &prog, Optimizador *opt,
+                     std::ostream &diag)
+{
+    if (!opt)
+    {
+        Compilador comp(lex, sem);
+        if (!comp.compilar(sin.arbol(), prog))
+        {
+            diag << comp.mensaje() << "\n";
+            return false;
+        }
+        return true;
+    }
+    ProgramaSsa ssa;
+    ConstructorSsa(lex, sem).construir(sin.arbol(), ssa);
+    opt->optimizar(ssa);
+    TraductorBytecode tr;
+    if (!tr.traducir(ssa, prog))
+    {
+        diag << tr.mensaje() << "\n";
+        return false;
+    }
+    return true;
+}
+
+struct Medicion
+{
+    size_t bytecode;
+    uint64_t ejecutadas;
+    double segundos;
+    std::string salida;
+};
+
+static Medicion medir(const Programa &prog)
+{
+    Medicion m{prog.codigo.size(), 0, 1e30, ""};
+    for (int r = 0; r < 3; ++r)
+    {
+        std::ostringstream out;
+        Maquina vm(prog, out);
+        int32_t resultado;
+        double t = ahora();
+        if (!vm.ejecutar(resultado))
+            out << " error: " << vm.mensaje();
+        m.segundos = std::min(m.segundos, ahora() - t);
+        m.salida = out.str();
+        m.ejecutadas = vm.nInstrucciones();
+    }
+    return m;
+}
+
+int main(int argc, char *argv[])
+{
+    double mb = argc > 1 ? atof(argv[1]) : 8;
+    bool ok = true;
+
+    std::vector<std::vector<Optimizador::Paso>> pasos;
+    std::printf("%-18s %-5s %8s %14s %10s %10s %8s\n", "programa", "", "bytecode", "ejecutadas", "ms",
+                "Minstr/s", "acel.");
+    for (const Prueba &p : pruebas)
+    {
+        Lexico lex;
+        Internador internador;
+        Sintactico sin;
+        std::ostringstream diag;
+        Semantico sem(lex, internador, diag);
+        if (!analizar(p.fuente, lex, internador, sin, sem, diag))
+        {
+            std::cout << p.nombre << ": no compila\n" << diag.str();
+            ok = false;
+            continue;
+        }
+        Optimizador opt;
+        double directo = 0;
+        for (Optimizador *o : {(Optimizador *)nullptr, &opt})
+        {
+            Programa prog;
+            if (!compilar(lex, sin, sem, prog, o, diag))
+            {
+                std::cout << p.nombre << ": no compila\n" << diag.str();
+                ok = false;
+                break;
+            }
+            Medicion m = medir(prog);
+            bool bien = m.salida == p.esperado;
+            ok = ok && bien;
+            if (!o)
+                directo = m.segundos;
+            std::printf("%-18s %-5s %8zu %14llu %10.2f %10.1f %7.2fx%s\n", o ? "" : p.nombre, o ? "-O" : "",
+                        m.bytecode, (unsigned long long)m.ejecutadas, m.segundos * 1e3,
+                        m.ejecutadas / m.segundos / 1e6, directo / m.segundos,
+                        bien ? "" : ("  ¡escribió " + m.salida + "!").c_str());
+        }
+        pasos.push_back(opt.estadisticas());
+    }
+
+    // instrucciones SSA después de cada paso y, entre paréntesis, lo que hizo el paso
+    std::printf("\n%-18s", "instrucciones SSA");
+    if (!pasos.empty())
+        for (const Optimizador::Paso &p : pasos[0])
+            std::printf(" %18s", p.nombre);
+    std::printf("\n");
+    for (size_t i = 0; i < pasos.size(); ++i)
+    {
+        std::printf("%-18s", pruebas[i].nombre);
+        for (const Optimizador::Paso &p : pasos[i])
+            std::printf(" %10zu (%5zu)", p.instrucciones, p.cambios);
+        std::printf("\n");
+    }
+
+    // compilación a bytecode de un programa generado (no se ejecuta: sus ciclos no terminan);
+    // main llama a todas las funciones y escribe la suma de sus resultados, así que con -O
+    // ninguna es código muerto
+    std::string fuente;
+    GeneradorPrograma(fuente, Mezcla(), 2022).generar(mb * 1e6, true);
+    Lexico lex;
+    Internador internador;
+    Sintactico sin;
+    Semantico sem(lex, internador, std::cout);
+    if (!analizar(fuente, lex, internador, sin, sem, std::cout))
+        return EXIT_FAILURE;
+    std::printf("\ncompilación de %.1f MB generados (%zu nodos):\n", fuente.size() / 1e6, sin.arbol().size());
+    for (bool optimizar : {false, true})
+    {
+        Programa prog;
+        double mejor = 1e30;
+        for (int r = 0; r < 3; ++r)
+        {
+            Optimizador opt;
+            double t = ahora();
+            if (!compilar(lex, sin, sem, prog, optimizar ? &opt : nullptr, std::cout))
+                return EXIT_FAILURE;
+            mejor = std::min(mejor, ahora() - t);
+        }
+        std::printf("  %-9s %zu instrucciones en %.2f ms (%.1f Mnodos/s)\n", optimizar ? "con -O:" : "directo:",
+                    prog.codigo.size(), mejor * 1e3, sin.arbol().size() / mejor / 1e6);
+    }
+    return ok ? 0 : EXIT_FAILURE;
+}
@@ -0,0 +1,224 @@
+/**
+ * @file    bench_modulo.cpp
+ * @version 1.0
+ * @date    19/10/2026
+ * @brief   Compara el arranque desde el código fuente con el arranque desde un módulo ya
+ *          compilado (modulo.h). Desde el fuente se cuenta leer el archivo, los análisis léxico,
+ *          sintáctico y semántico, la forma SSA, el optimizador y la traducción a bytecode (lo
+ *          que hace ejecutar -O antes de ejecutar); desde el módulo, abrirlo, mapearlo y verificar
+ *          su cabecera y su bytecode. En ambos casos se mide hasta que Maquina puede empezar
+ *          (mejor de 5), y en el programa generado también la ejecución, porque con -O su main
+ *          termina de inmediato. Los programas de programas_prueba.h se ejecutan una vez desde el
+ *          módulo para revisar que escriban lo esperado, y copias dañadas de sus módulos deben
+ *          ser rechazadas al abrirlas.
+ *
+ *          Los archivos se leen de la caché de páginas del sistema, no del disco.
+ *
+ *          g++ -std=c++17 -O2 -pthread bench_modulo.cpp -o bench_modulo
+ *          ./bench_modulo [MB del programa generado]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include "generador.h"
+#include "sintactico.h"
+#include "sintactico.cpp"
+#include "maquina.h"
+#include "optimizador.h"
+#include "modulo.h"
+#include "programas_prueba.h"
+
+static double ahora()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// Lo que hace ejecutar -O con un archivo fuente hasta tener el bytecode
+static bool compilarArchivo(const std::string &ruta, Programa &prog)
+{
+    Lexico lex;
+    Internador internador;
+    lex.usarInternador(&internador);
+    if (!lex.abrir(ruta.c_str()))
+        return false;
+    std::vector<Token> tokens;
+    if (!lex.analizar(tokens))
+        return false;
+    Sintactico sin;
+    sin.usarLexico(&lex);
+    if (!analizarEnParalelo(tokens, sin))
+        return false;
+    Semantico sem(lex, internador, std::cout);
+    if (!sem.analizar(sin.arbol()))
+        return false;
+    ProgramaSsa ssa;
+    ConstructorSsa(lex, sem).construir(sin.arbol(), ssa);
+    Optimizador().optimizar(ssa);
+    return TraductorBytecode().traducir(ssa, prog);
+}
+
+struct Arranque
+{
+    double fuente = 1e30, modulo = 1e30;
+    size_t bytesFuente, bytesModulo;
+    bool ok = true;
+};
+
+/// Mejor de 5 de cada arranque; con ejecutar también ejecuta el programa
+static Arranque medir(const std::string &fuente, const std::string &base, bool ejecutar)
+{
+    Arranque a;
+    std::string rutaFuente = base + ".c", rutaModulo = base + ".bc";
+    std::ofstream(rutaFuente) << fuente;
+    a.bytesFuente = fuente.size();
+    std::ostringstream nulo;
+    int32_t resultado;
+    for (int r = 0; r < 5; ++r)
+    {
+        double t = ahora();
+        Programa prog;
+        a.ok = compilarArchivo(rutaFuente, prog) && a.ok;
+        if (ejecutar)
+        {
+            Maquina vm(prog, nulo);
+            a.ok = vm.ejecutar(resultado) && a.ok;
+        }
+        a.fuente = std::min(a.fuente, ahora() - t);
+        if (r == 0)
+            a.ok = escribirModulo(rutaModulo.c_str(), prog) && a.ok;
+    }
+    for (int r = 0; r < 5; ++r)
+    {
+        double t = ahora();
+        ModuloBytecode m;
+        a.ok = m.abrir(rutaModulo.c_str()) && a.ok;
+        if (ejecutar && a.ok)
+        {
+            Maquina vm(m.vista(), nulo);
+            a.ok = vm.ejecutar(resultado) && a.ok;
+        }
+        a.modulo = std::min(a.modulo, ahora() - t);
+    }
+    a.bytesModulo = std::filesystem::file_size(rutaModulo);
+    return a;
+}
+
+/**
+ * @brief Daña el módulo de varias formas (un código inexistente, un salto, una llamada, el inicio
+ * de una función, un registro, una cadena y el orden de las cadenas) y revisa que abrir rechace
+ * cada copia dañada; las formas que no aplican al programa se omiten.
+ *
+ * @param rechazados Se suman las copias rechazadas
+ * @param total Se suman las copias probadas
+ */
+static void danar(const std::string &ruta, int &rechazados, int &total)
+{
+    std::ifstream in(ruta, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    CabeceraModulo cab;
+    memcpy(&cab, bytes.data(), sizeof cab);
+    SeccionesModulo s(cab);
+    std::string rutaDanado = ruta + ".danado";
+
+    // cambio recibe la copia como sus secciones y devuelve false si no encontró qué dañar
+    auto probar = [&](auto cambio) {
+        std::string b = bytes;
+        if (!cambio((Instr *)&b[s.codigo], (FuncionBC *)&b[s.funciones], (uint32_t *)&b[s.cadenas]))
+            return;
+        std::ofstream(rutaDanado, std::ios::binary).write(b.data(), b.size());
+        ModuloBytecode m;
+        rechazados += !m.abrir(rutaDanado.c_str()) && !m.mensaje().empty();
+        ++total;
+    };
+    // primera instrucción con alguno de los códigos
+    auto buscar = [&](Instr *codigo, std::initializer_list<CodigoOp> ops) -> Instr * {
+        for (uint32_t i = 0; i < cab.nCodigo; ++i)
+            for (CodigoOp op : ops)
+                if (codigo[i].op == op)
+                    return &codigo[i];
+        return nullptr;
+    };
+
+    probar([&](Instr *codigo, FuncionBC *, uint32_t *) {
+        codigo[0].op = CodigoOp(0xff);
+        return true;
+    });
+    probar([&](Instr *codigo, FuncionBC *, uint32_t *) {
+        Instr *x = buscar(codigo, {OP_SALTA, OP_SALTAF, OP_SALTAV});
+        return x && (x->k = cab.nCodigo, true);
+    });
+    probar([&](Instr *codigo, FuncionBC *, uint32_t *) {
+        Instr *x = buscar(codigo, {OP_LLAMA});
+        return x && (x->k = cab.nFunciones, true);
+    });
+    probar([&](Instr *, FuncionBC *funciones, uint32_t *) {
+        funciones[cab.nFunciones - 1].inicio = cab.nCodigo;
+        return true;
+    });
+    probar([&](Instr *codigo, FuncionBC *, uint32_t *) {
+        Instr *x = buscar(codigo, {OP_CARGA});
+        return x && (x->a = 0xffff, true);
+    });
+    probar([&](Instr *codigo, FuncionBC *, uint32_t *) {
+        Instr *x = buscar(codigo, {OP_PRINTS});
+        return x && (x->k = cab.nCadenas, true);
+    });
+    probar([&](Instr *, FuncionBC *, uint32_t *cadenas) {
+        return cab.nCadenas > 0 && cadenas[1] > 0 && (cadenas[0] = cadenas[1] + 1, true);
+    });
+    std::remove(rutaDanado.c_str());
+}
+
+static void mostrar(const char *nombre, const Arranque &a, const char *nota = "")
+{
+    std::printf("%-18s %12zu %12zu %12.3f %12.3f %9.0fx%s\n", nombre, a.bytesFuente, a.bytesModulo, a.fuente * 1e3,
+                a.modulo * 1e3, a.fuente / a.modulo, a.ok ? nota : "  ¡ERROR!");
+}
+
+int main(int argc, char *argv[])
+{
+    double mb = argc > 1 ? atof(argv[1]) : 8;
+    std::string dir = std::filesystem::temp_directory_path().string();
+    bool ok = true;
+
+    std::printf("%-18s %12s %12s %12s %12s %10s\n", "programa", "bytes .c", "bytes .bc", "fuente ms", "módulo ms",
+                "veces");
+    int rechazados = 0, danados = 0;
+    for (const Prueba &p : pruebas)
+    {
+        std::string base = dir + "/bench_modulo_" + std::to_string(&p - pruebas);
+        Arranque a = medir(p.fuente, base, false);
+
+        // el módulo se ejecuta tal cual desde las páginas mapeadas
+        ModuloBytecode m;
+        std::ostringstream out;
+        int32_t resultado;
+        bool bien = m.abrir((base + ".bc").c_str());
+        if (bien)
+        {
+            Maquina vm(m.vista(), out);
+            bien = vm.ejecutar(resultado) && out.str() == p.esperado;
+        }
+        a.ok = a.ok && bien;
+        ok = ok && a.ok;
+        mostrar(p.nombre, a);
+        danar(base + ".bc", rechazados, danados);
+        std::remove((base + ".c").c_str());
+        std::remove((base + ".bc").c_str());
+    }
+
+    std::string fuente;
+    GeneradorPrograma(fuente, Mezcla(), 2022).generar(mb * 1e6);
+    std::string base = dir + "/bench_modulo_generado";
+    Arranque a = medir(fuente, base, true);
+    ok = ok && a.ok;
+    mostrar("generado", a, "  (hasta el resultado)");
+    std::printf("módulos dañados rechazados: %d de %d%s\n", rechazados, danados,
+                rechazados == danados ? "" : "  ¡ERROR!");
+    ok = ok && rechazados == danados;
+    std::remove((base + ".c").c_str());
+    std::remove((base + ".bc").c_str());
+    return ok ? 0 : EXIT_FAILURE;
+}
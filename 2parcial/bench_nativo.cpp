@@ -0,0 +1,151 @@
+/**
+ * @file    bench_nativo.cpp
+ * @version 1.0
+ * @date    19/10/2026
+ * @brief   Compara el ejecutable x86-64 que genera nativo.h con la máquina virtual, usando los
+ *          programas de programas_prueba.h (ciclos while, llamadas recursivas y anidadas). Cada
+ *          programa corre en la máquina virtual compilado directo a bytecode y con el optimizador
+ *          SSA, y como ejecutable nativo; de cada uno muestra el tiempo (mejor de 3) y cuántas
+ *          veces más rápido es el nativo, y revisa que escriba lo esperado. El tiempo del
+ *          ejecutable incluye crear el proceso (menos de 1 ms).
+ *
+ *          Necesita el compilador de C del sistema ($CC, o cc) para ensamblar y enlazar.
+ *
+ *          g++ -std=c++17 -O2 -pthread bench_nativo.cpp -o bench_nativo
+ *          ./bench_nativo
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include "sintactico.h"
+#include "sintactico.cpp"
+#include "maquina.h"
+#include "optimizador.h"
+#include "nativo.h"
+#include "programas_prueba.h"
+
+static double ahora()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// Analiza fuente hasta el semántico; false y los errores en diag si no se pudo
+static bool analizar(const std::string &fuente, Lexico &lex, Internador &internador, Sintactico &sin,
+                     Semantico &sem, std::ostream &diag)
+{
+    std::istringstream in(fuente);
+    lex.usarInternador(&internador);
+    lex.usarSalida(diag);
+    lex.cargar(in);
+    std::vector<Token> vt;
+    if (!lex.analizar(vt))
+        return false;
+    sin.usarLexico(&lex);
+    sin.usarSalida(diag);
+    return sin.analizar(vt) && sem.analizar(sin.arbol());
+}
+
+/// Mejor de 3 en la máquina virtual; deja en salida lo que escribió el programa
+static double medirMaquina(const Programa &prog, std::string &salida)
+{
+    double mejor = 1e30;
+    for (int r = 0; r < 3; ++r)
+    {
+        std::ostringstream out;
+        Maquina vm(prog, out);
+        int32_t resultado;
+        double t = ahora();
+        if (!vm.ejecutar(resultado))
+            out << " error: " << vm.mensaje();
+        mejor = std::min(mejor, ahora() - t);
+        salida = out.str();
+    }
+    return mejor;
+}
+
+/// Mejor de 3 del ejecutable; deja en salida lo que escribió
+static double medirEjecutable(const std::string &ruta, std::string &salida)
+{
+    double mejor = 1e30;
+    for (int r = 0; r < 3; ++r)
+    {
+        double t = ahora();
+        FILE *p = popen(("'" + ruta + "'").c_str(), "r");
+        if (!p)
+            return 0;
+        salida.clear();
+        char buf[4096];
+        for (size_t n; (n = fread(buf, 1, sizeof buf, p)) > 0;)
+            salida.append(buf, n);
+        pclose(p);
+        mejor = std::min(mejor, ahora() - t);
+    }
+    return mejor;
+}
+
+int main()
+{
+    const char *cc = getenv("CC");
+    std::filesystem::path dir = std::filesystem::temp_directory_path();
+    bool ok = true;
+
+    std::printf("%-18s %12s %12s %12s %9s %9s %14s\n", "programa", "vm ms", "vm -O ms", "nativo ms", "vs vm",
+                "vs vm -O", "ensamblar ms");
+    for (const Prueba &p : pruebas)
+    {
+        Lexico lex;
+        Internador internador;
+        Sintactico sin;
+        std::ostringstream diag;
+        Semantico sem(lex, internador, diag);
+        if (!analizar(p.fuente, lex, internador, sin, sem, diag))
+        {
+            std::cout << p.nombre << ": no compila\n" << diag.str();
+            ok = false;
+            continue;
+        }
+
+        Programa directo, optimizado;
+        Compilador comp(lex, sem);
+        ProgramaSsa ssa;
+        ConstructorSsa(lex, sem).construir(sin.arbol(), ssa);
+        Optimizador().optimizar(ssa);
+        TraductorBytecode tr;
+        if (!comp.compilar(sin.arbol(), directo) || !tr.traducir(ssa, optimizado))
+        {
+            std::cout << p.nombre << ": no compila\n";
+            ok = false;
+            continue;
+        }
+
+        // el mismo ProgramaSsa optimizado va a bytecode y a x86-64
+        std::string base = (dir / ("bench_nativo_" + std::to_string(&p - pruebas))).string();
+        {
+            std::ofstream out(base + ".s");
+            TraductorX86().traducir(ssa, lex, sin.arbol(), out);
+        }
+        double t = ahora();
+        std::string orden = std::string(cc && *cc ? cc : "cc") + " -nostdlib -static -Wl,-e,rt.inicio -o '" +
+                            base + "' '" + base + ".s'";
+        if (std::system(orden.c_str()) != 0)
+        {
+            std::cout << p.nombre << ": falló " << orden << "\n";
+            ok = false;
+            continue;
+        }
+        double ensamblar = ahora() - t;
+
+        std::string sd, so, sn;
+        double td = medirMaquina(directo, sd), to = medirMaquina(optimizado, so), tn = medirEjecutable(base, sn);
+        std::remove(base.c_str());
+        std::remove((base + ".s").c_str());
+        bool bien = sd == p.esperado && so == p.esperado && sn == p.esperado;
+        ok = ok && bien;
+        std::printf("%-18s %12.2f %12.2f %12.2f %8.1fx %8.1fx %14.1f%s\n", p.nombre, td * 1e3, to * 1e3, tn * 1e3,
+                    td / tn, to / tn, ensamblar * 1e3,
+                    bien ? "" : ("  ¡escribió " + sd + " / " + so + " / " + sn + "!").c_str());
+    }
+    return ok ? 0 : EXIT_FAILURE;
+}
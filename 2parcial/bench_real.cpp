@@ -0,0 +1,95 @@
+/**
+ * @file    bench_real.cpp
+ * @version 1.0
+ * @date    19/10/2026
+ * @brief   Mide la conversión de literales reales con aReal (std::from_chars) contra strtod
+ *          sobre un corpus sintético con muchos flotantes, y verifica que ambos den el mismo
+ *          double bit a bit.
+ *
+ *          g++ -std=c++17 -O2 bench_real.cpp -o bench_real && ./bench_real [literales]
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include "real.h"
+
+using namespace std;
+
+/// Rango de un literal dentro del corpus
+struct Literal
+{
+    unsigned ini;
+    unsigned lon;
+};
+
+/**
+ * @brief Genera literales en las formas d+.d+, d+. y .d+ separados por espacios, como
+ * aparecerían en una lista de inicializaciones float.
+ */
+static void generarCorpus(size_t n, string &corpus, vector<Literal> &lits)
+{
+    mt19937 gen(2022);
+    uniform_int_distribution<int> digito(0, 9), entera(0, 9), fraccion(0, 12), forma(0, 9);
+
+    corpus.reserve(n * 12);
+    lits.reserve(n);
+    for (size_t k = 0; k < n; ++k)
+    {
+        int f = forma(gen);
+        int ne = f == 0 ? 0 : 1 + entera(gen) % 8;
+        int nf = f == 1 ? 0 : 1 + fraccion(gen);
+
+        Literal l{(unsigned)corpus.size(), 0};
+        for (int d = 0; d < ne; ++d)
+            corpus += char('0' + digito(gen));
+        corpus += '.';
+        for (int d = 0; d < nf; ++d)
+            corpus += char('0' + digito(gen));
+        l.lon = corpus.size() - l.ini;
+        lits.push_back(l);
+        corpus += (k % 8 == 7) ? '\n' : ' ';
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    size_t n = argc > 1 ? strtoul(argv[1], nullptr, 10) : 2000000;
+    string corpus;
+    vector<Literal> lits;
+    generarCorpus(n, corpus, lits);
+
+    vector<double> a(n), b(n);
+    const char *base = corpus.c_str();
+
+    auto t0 = chrono::steady_clock::now();
+    for (size_t k = 0; k < n; ++k)
+        a[k] = strtod(base + lits[k].ini, nullptr);
+    auto t1 = chrono::steady_clock::now();
+    size_t fallos = 0;
+    for (size_t k = 0; k < n; ++k)
+        if (!aReal(base + lits[k].ini, base + lits[k].ini + lits[k].lon, b[k]))
+            ++fallos;
+    auto t2 = chrono::steady_clock::now();
+
+    size_t distintos = 0;
+    for (size_t k = 0; k < n; ++k)
+        if (memcmp(&a[k], &b[k], sizeof(double)) != 0)
+            ++distintos;
+
+    double mb = corpus.size() / 1e6;
+    double ts = chrono::duration<double>(t1 - t0).count();
+    double tf = chrono::duration<double>(t2 - t1).count();
+
+    cout << "literales: " << n << "  corpus: " << mb << " MB\n";
+    cout << "strtod : " << ts * 1e9 / n << " ns/literal  " << mb / ts << " MB/s\n";
+    cout << "aReal  : " << tf * 1e9 / n << " ns/literal  " << mb / tf << " MB/s\n";
+    cout << "aceleración: " << ts / tf << "x  fallos: " << fallos << "  distintos: " << distintos << "\n";
+
+    return (fallos == 0 && distintos == 0) ? 0 : EXIT_FAILURE;
+}
@@ -0,0 +1,83 @@
+/**
+ * @file    bench_semantico.cpp
+ * @version 1.0
+ * @date    19/10/2026
+ * @brief   Mide semantico.h sobre un programa generado de un millón de líneas (o las que se
+ *          pidan): tiempo de cada etapa, líneas y nodos revisados por segundo y errores
+ *          encontrados, que deben ser 0 porque generador.h produce programas válidos.
+ *
+ *          g++ -std=c++17 -O2 -pthread bench_semantico.cpp -o bench_semantico
+ *          ./bench_semantico [millones de líneas] [semilla] [nombre=valor ...]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include "generador.h"
+#include "sintactico.h"
+#include "sintactico.cpp"
+#include "semantico.h"
+
+static double ahora()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int main(int argc, char *argv[])
+{
+    double millones = argc > 1 ? atof(argv[1]) : 1;
+    Mezcla mezcla;
+    uint64_t semilla = 2022;
+    for (int i = 2; i < argc; ++i)
+        if (!strchr(argv[i], '='))
+            semilla = std::stoull(argv[i]);
+        else if (!mezcla.asignar(argv[i]))
+        {
+            std::cout << "Error: no existe el elemento " << argv[i] << " en la mezcla\n";
+            return EXIT_FAILURE;
+        }
+
+    // el generador pide bytes: los bytes por línea se estiman con una muestra de 1 MB (con 3% de
+    // margen, porque la muestra no es exacta)
+    std::string fuente;
+    GeneradorPrograma(fuente, mezcla, semilla).generar(1e6);
+    double porLinea = double(fuente.size()) / std::count(fuente.begin(), fuente.end(), '\n');
+    fuente.clear();
+    GeneradorPrograma(fuente, mezcla, semilla).generar(millones * 1e6 * porLinea * 1.03);
+    size_t lineas = std::count(fuente.begin(), fuente.end(), '\n');
+
+    std::istringstream in(fuente);
+    Lexico lex;
+    Internador internador;
+    lex.usarInternador(&internador);
+    lex.cargar(in);
+    std::vector<Token> vt;
+    double t0 = ahora();
+    if (!lex.analizar(vt))
+        return EXIT_FAILURE;
+    double t1 = ahora();
+    Sintactico sin;
+    sin.usarLexico(&lex);
+    if (!sin.analizar(vt))
+        return EXIT_FAILURE;
+    double t2 = ahora();
+
+    Semantico sem(lex, internador, std::cout);
+    double mejor = 1e30;
+    bool ok = true;
+    for (int r = 0; r < 5; ++r)
+    {
+        double t = ahora();
+        ok = sem.analizar(sin.arbol());
+        mejor = std::min(mejor, ahora() - t);
+    }
+
+    size_t nodos = sin.arbol().size();
+    std::cout << "fuente: " << fuente.size() / 1e6 << " MB  líneas: " << lineas << "  tokens: " << vt.size()
+              << "  nodos: " << nodos << "  declaraciones: " << sem.nVariables() << "\n";
+    std::printf("léxico      %9.2f ms\n", (t1 - t0) * 1e3);
+    std::printf("sintáctico  %9.2f ms\n", (t2 - t1) * 1e3);
+    std::printf("semántico   %9.2f ms  %7.2f Mlíneas/s  %7.2f Mnodos/s  %u errores\n", mejor * 1e3,
+                lineas / mejor / 1e6, nodos / mejor / 1e6, sem.nErrores());
+    return ok ? 0 : EXIT_FAILURE;
+}
@@ -0,0 +1,121 @@
+/**
+ * @file    bench_sintactico.cpp
+ * @version 1.0
+ * @date    19/10/2026
+ * @brief   Mide Sintactico::analizar construyendo el árbol sintáctico sobre un programa generado
+ *          con generador.h: nodos por segundo, tokens por segundo y bytes por nodo (los nodos más
+ *          la tabla de tokens de nombres y literales). Después quita un token de cada cierto
+ *          número para medir el modo alarma: cuántos errores reporta en una pasada y cuánto
+ *          cuesta recuperarse. Al final mide analizarEnParalelo con 1, 2, 4... hilos hasta los
+ *          núcleos de la máquina y revisa que deje el mismo árbol que el análisis en orden.
+ *
+ *          g++ -std=c++17 -O2 -pthread bench_sintactico.cpp -o bench_sintactico
+ *          ./bench_sintactico [MB] [semilla] [nombre=valor ...]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include "generador.h"
+#include "sintactico.h"
+#include "sintactico.cpp"
+
+int main(int argc, char *argv[])
+{
+    double mb = argc > 1 ? atof(argv[1]) : 32;
+    Mezcla mezcla;
+    uint64_t semilla = 2022;
+    for (int i = 2; i < argc; ++i)
+        if (!strchr(argv[i], '='))
+            semilla = std::stoull(argv[i]);
+        else if (!mezcla.asignar(argv[i]))
+        {
+            std::cout << "Error: no existe el elemento " << argv[i] << " en la mezcla\n";
+            return EXIT_FAILURE;
+        }
+
+    std::string fuente;
+    GeneradorPrograma(fuente, mezcla, semilla).generar(mb * 1e6);
+    std::istringstream in(fuente);
+    Lexico lex;
+    lex.cargar(in);
+    std::vector<Token> vt;
+    if (!lex.analizar(vt))
+        return EXIT_FAILURE;
+
+    Sintactico sin;
+    sin.usarLexico(&lex);
+    double mejor = 1e30;
+    bool ok = true;
+    for (int r = 0; r < 5; ++r)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        ok = sin.analizar(vt) && ok;
+        mejor = std::min(mejor, std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+    }
+
+    const Ast &ast = sin.arbol();
+    size_t hojas = ast.tokens.size();
+    std::cout << "fuente: " << fuente.size() / 1e6 << " MB  tokens: " << vt.size() << "  nodos: " << ast.size()
+              << "  hojas: " << hojas << (ok ? "" : "  ¡ERRORES!") << "\n";
+    std::cout << "análisis sintáctico: " << mejor * 1e3 << " ms  " << ast.size() / mejor / 1e6 << " Mnodos/s  "
+              << vt.size() / mejor / 1e6 << " Mtokens/s  " << fuente.size() / mejor / 1e6 << " MB/s\n";
+    std::cout << "Nodo: " << sizeof(Nodo) << " bytes  árbol: " << ast.bytes() / 1e6 << " MB  "
+              << double(ast.bytes()) / ast.size() << " bytes por nodo (con tokens de hojas)\n";
+
+    // un token de menos cada 500: cada hueco debe dar un error y el análisis debe seguir
+    std::vector<Token> conHuecos;
+    conHuecos.reserve(vt.size());
+    size_t quitados = 0;
+    for (size_t i = 0; i < vt.size(); ++i)
+        if (i % 500 == 250)
+            ++quitados;
+        else
+            conHuecos.push_back(vt[i]);
+    std::ostringstream errores;
+    sin.usarSalida(errores);
+    double conErrores = 1e30;
+    for (int r = 0; r < 5; ++r)
+    {
+        errores.str("");
+        auto t0 = std::chrono::steady_clock::now();
+        sin.analizar(conHuecos);
+        conErrores = std::min(conErrores, std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+    }
+    std::cout << "modo alarma: " << quitados << " tokens quitados, " << sin.nErrores() << " errores reportados en "
+              << conErrores * 1e3 << " ms (" << conHuecos.size() / conErrores / 1e6 << " Mtokens/s)\n";
+
+    // funciones repartidas entre hilos; el árbol debe quedar idéntico, nodo por nodo
+    sin.usarSalida(std::cout);
+    sin.analizar(vt);
+    Ast enOrden = sin.arbol();
+    unsigned nucleos = std::max(1u, std::thread::hardware_concurrency());
+    std::cout << "en paralelo (" << nucleos << " núcleos):\n";
+    for (unsigned h = 1;; h = std::min(h * 2, nucleos))
+    {
+        Sintactico par;
+        par.usarLexico(&lex);
+        double t = 1e30;
+        bool bien = true;
+        for (int r = 0; r < 5; ++r)
+        {
+            auto t0 = std::chrono::steady_clock::now();
+            bien = analizarEnParalelo(vt, par, h) && bien;
+            t = std::min(t, std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+        }
+        const Ast &a = par.arbol();
+        bien = bien && a.nodos.size() == enOrden.nodos.size() && a.tokens.size() == enOrden.tokens.size();
+        for (size_t i = 0; bien && i < a.nodos.size(); ++i)
+        {
+            const Nodo &x = a.nodos[i], &y = enOrden.nodos[i];
+            bien = x.tipo == y.tipo && x.op == y.op && x.token == y.token && x.hijo == y.hijo && x.hermano == y.hermano;
+        }
+        for (size_t i = 0; bien && i < a.tokens.size(); ++i)
+            bien = a.tokens[i].ini == enOrden.tokens[i].ini && a.tokens[i].sym == enOrden.tokens[i].sym;
+        ok = ok && bien;
+        std::cout << "  " << h << " hilos: " << t * 1e3 << " ms  " << a.size() / t / 1e6 << " Mnodos/s  "
+                  << mejor / t << "x" << (bien ? "" : "  ¡ÁRBOL DISTINTO!") << "\n";
+        if (h == nucleos)
+            break;
+    }
+    return ok ? 0 : EXIT_FAILURE;
+}
@@ -0,0 +1,76 @@
+/**
+ * @file    bench_tubo.cpp
+ * @version 1.0
+ * @date    19/10/2026
+ * @brief   Compara el análisis léxico y sintáctico en serie (todos los tokens en un vector y
+ *          después el sintáctico) contra la tubería con AnilloTokens (el léxico en otro hilo
+ *          y el sintáctico consumiendo los tokens conforme llegan), sobre un programa generado.
+ *
+ *          g++ -std=c++17 -O2 -pthread bench_tubo.cpp -o bench_tubo && ./bench_tubo [MB]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include "generador.h"
+#include "sintactico.h"
+#include "sintactico.cpp"
+
+int main(int argc, char *argv[])
+{
+    double mb = argc > 1 ? atof(argv[1]) : 32;
+    const char *ruta = "/tmp/bench_tubo.c";
+
+    std::string fuente;
+    GeneradorPrograma(fuente, Mezcla(), 37).generar(mb * 1e6);
+    FILE *f = fopen(ruta, "wb");
+    if (!f)
+    {
+        std::cout << "Error: no se pudo crear " << ruta << "\n";
+        return EXIT_FAILURE;
+    }
+    fwrite(fuente.data(), 1, fuente.size(), f);
+    fclose(f);
+    double tam = fuente.size() / 1e6;
+    std::cout << "fuente: " << tam << " MB  núcleos: " << std::thread::hardware_concurrency() << "\n";
+
+    double lex = 1e30, sin = 1e30, serie = 1e30, tubo = 1e30;
+    bool ok = true;
+    size_t bytesTokens = 0;
+    for (int r = 0; r < 3; ++r)
+    {
+        {
+            Lexico l;
+            Sintactico s;
+            std::vector<Token> vt;
+            l.abrir(ruta);
+            auto t0 = std::chrono::steady_clock::now();
+            ok = l.analizar(vt) && ok;
+            auto t1 = std::chrono::steady_clock::now();
+            ok = s.analizar(vt) && ok;
+            auto t2 = std::chrono::steady_clock::now();
+            lex = std::min(lex, std::chrono::duration<double>(t1 - t0).count());
+            sin = std::min(sin, std::chrono::duration<double>(t2 - t1).count());
+            serie = std::min(serie, std::chrono::duration<double>(t2 - t0).count());
+            bytesTokens = vt.capacity() * sizeof(Token);
+        }
+        {
+            Lexico l;
+            Sintactico s;
+            l.abrir(ruta);
+            auto t0 = std::chrono::steady_clock::now();
+            ok = analizarEnTubo(l, s) && ok;
+            tubo = std::min(tubo, std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+        }
+    }
+
+    std::cout << "léxico      : " << lex * 1e3 << " ms\n";
+    std::cout << "sintáctico  : " << sin * 1e3 << " ms\n";
+    std::cout << "en serie    : " << serie * 1e3 << " ms  (" << tam / serie << " MB/s, vector de tokens "
+              << bytesTokens / 1e6 << " MB)\n";
+    std::cout << "en tubería  : " << tubo * 1e3 << " ms  (" << tam / tubo << " MB/s, anillo de tokens "
+              << TAM_ANILLO * sizeof(Token) / 1e3 << " KB)  max(léxico, sintáctico) = "
+              << std::max(lex, sin) * 1e3 << " ms\n";
+
+    remove(ruta);
+    return ok ? 0 : EXIT_FAILURE;
+}
@@ -0,0 +1,626 @@
+/**
+ * @file    bytecode.h
+ * @version 1.0
+ * @date    19/10/2026
+ * @title   Generación de bytecode
+ * @brief   Traduce el árbol revisado por Semantico a un bytecode de registros que ejecuta
+ *          Maquina (maquina.h).
+ *
+ *          Cada instrucción mide 8 bytes: el código, un registro destino y dos registros de
+ *          16 bits o una constante de 32. Las operaciones llevan el tipo en el código (SUMAI,
+ *          SUMAF...), porque Semantico ya sabe el tipo de cada expresión, y las conversiones de
+ *          int a float son instrucciones explícitas.
+ *
+ *          Los registros de una función son sus parámetros, sus variables (que se reutilizan al
+ *          cerrar cada bloque) y los temporales de las expresiones, que se asignan como una pila.
+ *          Los argumentos de una llamada se calculan en los temporales de más arriba y el marco
+ *          de la función llamada empieza ahí mismo, así que no se copian; el resultado queda en el
+ *          primer registro de ese marco.
+ */
+
+#ifndef BYTECODE_H
+#define BYTECODE_H
+
+#include <cmath>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "semantico.h"
+
+enum CodigoOp : unsigned char
+{
+    OP_MOV,      // a = b
+    OP_CARGA,    // a = k (los 32 bits de un int o de un float)
+    OP_SUMAI,    // a = b + c
+    OP_RESTAI,   // a = b - c
+    OP_MULI,     // a = b * c
+    OP_DIVI,     // a = b / c, error si c es 0
+    OP_SUMAIK,   // a = b + c, con c constante de 16 bits con signo
+    OP_SUMAF,
+    OP_RESTAF,
+    OP_MULF,
+    OP_DIVF,
+    OP_MENORI,   // a = b < c
+    OP_MAYORI,
+    OP_MENORIGI,
+    OP_MAYORIGI,
+    OP_IGUALI,
+    OP_DISTI,
+    OP_MENORF,
+    OP_MAYORF,
+    OP_MENORIGF,
+    OP_MAYORIGF,
+    OP_IGUALF,
+    OP_DISTF,
+    OP_NEGI,     // a = -b
+    OP_NEGF,
+    OP_NOTI,     // a = !b
+    OP_NOTF,
+    OP_LOGI,     // a = b != 0
+    OP_LOGF,
+    OP_AF,       // a = float(b)
+    OP_SALTA,    // salta a la instrucción k
+    OP_SALTAF,   // salta a k si a es 0
+    OP_SALTAV,   // salta a k si a no es 0
+    OP_LLAMA,    // llama a la función k con el marco en a (argumentos en a, a+1...)
+    OP_REGRESA,  // regresa a con el primer registro del marco
+    OP_REGRESAV, // regresa sin valor
+    OP_PRINTI,   // escribe el int a
+    OP_PRINTS,   // escribe la cadena k
+    OP_NUM
+};
+
+const char nombreOp[OP_NUM][10] = {
+    "mov", "carga", "sumai", "restai", "muli", "divi", "sumaik", "sumaf", "restaf", "mulf", "divf",
+    "menori", "mayori", "menorigi", "mayorigi", "iguali", "disti",
+    "menorf", "mayorf", "menorigf", "mayorigf", "igualf", "distf",
+    "negi", "negf", "noti", "notf", "logi", "logf", "af",
+    "salta", "saltaf", "saltav", "llama", "regresa", "regresav", "printi", "prints"};
+
+struct Instr
+{
+    CodigoOp op;
+    uint16_t a;
+    union
+    {
+        struct
+        {
+            uint16_t b, c;
+        } r;
+        int32_t k;
+        float f;
+    };
+};
+static_assert(sizeof(Instr) == 8, "Instr debe medir 8 bytes");
+
+struct FuncionBC
+{
+    /// Primera instrucción
+    uint32_t inicio;
+    /// Registros del marco y cuántos de ellos son parámetros
+    uint16_t registros, parametros;
+    /// Nodo N_FUNCION, para mostrar su nombre
+    Indice nodo;
+};
+
+/**
+ * @brief Lo que Maquina necesita de un programa, como arreglos planos: sirve igual para un
+ * Programa en memoria que para un módulo mapeado de disco (modulo.h), que no se convierte.
+ */
+struct VistaPrograma
+{
+    const Instr *codigo;
+    const FuncionBC *funciones;
+    /// Cadena k: texto[cadenas[k], cadenas[k + 1])
+    const uint32_t *cadenas;
+    const char *texto;
+    uint32_t principal;
+};
+
+class Programa
+{
+public:
+    std::vector<Instr> codigo;
+    std::vector<FuncionBC> funciones;
+    /// Literales de cadena ya sin comillas ni secuencias de escape
+    std::vector<std::string> cadenas;
+    /// Función main
+    uint32_t principal = 0;
+
+    void limpiar()
+    {
+        codigo.clear();
+        funciones.clear();
+        cadenas.clear();
+        principal = 0;
+    }
+
+    /// Muestra las instrucciones de cada función, una por línea
+    template <class Lex>
+    void desensamblar(std::ostream &out, const Lex &lex, const Ast &ast) const
+    {
+        for (size_t f = 0; f < funciones.size(); ++f)
+        {
+            const FuncionBC &fn = funciones[f];
+            size_t fin = f + 1 < funciones.size() ? funciones[f + 1].inicio : codigo.size();
+            out << lex.texto(ast.token(fn.nodo)) << " (" << fn.parametros << " parámetros, " << fn.registros
+                << " registros)\n";
+            for (size_t i = fn.inicio; i < fin; ++i)
+            {
+                const Instr &x = codigo[i];
+                out << "  " << i << "\t" << nombreOp[x.op];
+                switch (x.op)
+                {
+                case OP_CARGA:
+                    // el mismo código carga int y float: el valor como float se muestra si lo parece
+                    out << " r" << x.a << ", " << x.k;
+                    if (std::fpclassify(x.f) == FP_NORMAL)
+                        out << " (" << x.f << ")";
+                    break;
+                case OP_SUMAIK:
+                    out << " r" << x.a << ", r" << x.r.b << ", " << int16_t(x.r.c);
+                    break;
+                case OP_SALTA:
+                    out << " " << x.k;
+                    break;
+                case OP_SALTAF:
+                case OP_SALTAV:
+                    out << " r" << x.a << ", " << x.k;
+                    break;
+                case OP_LLAMA:
+                    out << " r" << x.a << ", " << lex.texto(ast.token(funciones[x.k].nodo));
+                    break;
+                case OP_REGRESA:
+                case OP_PRINTI:
+                    out << " r" << x.a;
+                    break;
+                case OP_REGRESAV:
+                    break;
+                case OP_PRINTS:
+                    out << " " << x.k;
+                    break;
+                case OP_MOV:
+                case OP_NEGI:
+                case OP_NEGF:
+                case OP_NOTI:
+                case OP_NOTF:
+                case OP_LOGI:
+                case OP_LOGF:
+                case OP_AF:
+                    out << " r" << x.a << ", r" << x.r.b;
+                    break;
+                default:
+                    out << " r" << x.a << ", r" << x.r.b << ", r" << x.r.c;
+                }
+                out << "\n";
+            }
+        }
+    }
+};
+
+/// Valor de un literal entero; como en C, se trunca a 32 bits
+inline int32_t valorEntero(std::string_view s)
+{
+    uint32_t v = 0;
+    for (char c : s)
+        v = v * 10 + (c - '0');
+    return int32_t(v);
+}
+
+inline float valorReal(std::string_view s)
+{
+    double v = 0;
+    aReal(s.data(), s.data() + s.size(), v);
+    return float(v);
+}
+
+/// Texto de un literal de cadena, sin las comillas y con los escapes resueltos
+inline std::string valorCadena(std::string_view s)
+{
+    std::string c;
+    for (size_t i = 1; i + 1 < s.size(); ++i)
+        if (s[i] != '\\')
+            c += s[i];
+        else
+            switch (s[++i])
+            {
+            case 'n':
+                c += '\n';
+                break;
+            case 't':
+                c += '\t';
+                break;
+            case '0':
+                c += '\0';
+                break;
+            default:
+                c += s[i];
+            }
+    return c;
+}
+
+/**
+ * @brief Compila un árbol sin errores semánticos a un Programa. Usa las anotaciones que dejó
+ * Semantico::analizar sobre ese mismo árbol.
+ */
+class Compilador
+{
+    const Lexico &lex;
+    const Semantico &sem;
+    const Ast *ast = nullptr;
+    Programa *prog = nullptr;
+
+    /// Registro de cada declaración y número de cada función, por nodo
+    std::vector<uint32_t> ranura;
+    /// Siguiente registro libre y máximo usado en la función actual
+    uint32_t libre = 0, maximo = 0;
+    /// Primer registro de la instrucción actual que no es de una variable visible
+    uint32_t primerTemporal = 0;
+    TipoDato retornoActual = D_VOID;
+    std::string error;
+
+    const Nodo &nodo(Indice n) const
+    {
+        return (*ast)[n];
+    }
+
+    uint16_t temporal()
+    {
+        if (libre == 0xffff)
+        {
+            error = "la función usa más de 65535 registros";
+            return 0;
+        }
+        maximo = std::max(maximo, libre + 1);
+        return libre++;
+    }
+
+    size_t emitir(CodigoOp op, uint16_t a = 0, uint16_t b = 0, uint16_t c = 0)
+    {
+        Instr x{op, a, {}};
+        x.r.b = b;
+        x.r.c = c;
+        prog->codigo.push_back(x);
+        return prog->codigo.size() - 1;
+    }
+
+    size_t emitirK(CodigoOp op, uint16_t a, int32_t k)
+    {
+        Instr x{op, a, {}};
+        x.k = k;
+        prog->codigo.push_back(x);
+        return prog->codigo.size() - 1;
+    }
+
+    /// Hace que el salto i vaya a la siguiente instrucción que se emita
+    void resolver(size_t i)
+    {
+        prog->codigo[i].k = prog->codigo.size();
+    }
+
+    int32_t entero(Indice n) const
+    {
+        return valorEntero(lex.texto(ast->token(n)));
+    }
+
+    float real(Indice n) const
+    {
+        return valorReal(lex.texto(ast->token(n)));
+    }
+
+    /// Agrega el literal de cadena n a prog->cadenas
+    int32_t cadena(Indice n)
+    {
+        prog->cadenas.push_back(valorCadena(lex.texto(ast->token(n))));
+        return prog->cadenas.size() - 1;
+    }
+
+    /// Registro con el valor de n: el de la variable si n es un nombre, si no un temporal nuevo
+    uint16_t operando(Indice n, TipoDato como)
+    {
+        if (nodo(n).tipo == N_ID && sem.tipo(n) == como)
+            return ranura[sem.enlace(n)];
+        uint16_t t = temporal();
+        expresion(n, t, como);
+        return t;
+    }
+
+    /// Registro distinto de 0 si la condición n es verdadera
+    uint16_t condicion(Indice n)
+    {
+        if (sem.tipo(n) == D_INT)
+            return operando(n, D_INT);
+        uint16_t t = temporal();
+        emitir(OP_LOGF, t, operando(n, D_FLOAT));
+        return t;
+    }
+
+    /**
+     * @brief Calcula la expresión n en el registro d, convertida al tipo como (solo puede ser
+     * de int a float). d solo se escribe con la última instrucción, así que puede ser una
+     * variable que aparece en la expresión.
+     */
+    void expresion(Indice n, uint16_t d, TipoDato como)
+    {
+        const Nodo &x = nodo(n);
+        TipoDato t = sem.tipo(n);
+        uint32_t marca = libre;
+        if (t != como)
+        {
+            if (x.tipo == N_ENTERO)
+            {
+                Instr c{OP_CARGA, d, {}};
+                c.f = float(entero(n));
+                prog->codigo.push_back(c);
+            }
+            else
+                emitir(OP_AF, d, operando(n, D_INT));
+            libre = marca;
+            return;
+        }
+        switch (x.tipo)
+        {
+        case N_ENTERO:
+            emitirK(OP_CARGA, d, entero(n));
+            break;
+        case N_REAL:
+        {
+            Instr c{OP_CARGA, d, {}};
+            c.f = real(n);
+            prog->codigo.push_back(c);
+            break;
+        }
+        case N_ID:
+            emitir(OP_MOV, d, ranura[sem.enlace(n)]);
+            break;
+        case N_LLAMADA:
+            llamada(n, d, true);
+            break;
+        case N_UNARIA:
+        {
+            TipoDato o = sem.tipo(x.hijo);
+            uint16_t a = operando(x.hijo, o);
+            if (x.op == T_NOT)
+                emitir(o == D_INT ? OP_NOTI : OP_NOTF, d, a);
+            else
+                emitir(o == D_INT ? OP_NEGI : OP_NEGF, d, a);
+            break;
+        }
+        case N_BINARIA:
+        {
+            Indice izq = x.hijo, der = nodo(izq).hermano;
+            if (x.op == T_AND || x.op == T_OR)
+            {
+                // con corto circuito: el resultado se arma en un temporal por si d aparece en der
+                uint16_t r = temporal();
+                emitir(sem.tipo(izq) == D_INT ? OP_LOGI : OP_LOGF, r, operando(izq, sem.tipo(izq)));
+                size_t salto = emitirK(x.op == T_AND ? OP_SALTAF : OP_SALTAV, r, 0);
+                emitir(sem.tipo(der) == D_INT ? OP_LOGI : OP_LOGF, r, operando(der, sem.tipo(der)));
+                resolver(salto);
+                emitir(OP_MOV, d, r);
+                break;
+            }
+            // las comparaciones se hacen en float si algún operando es float
+            TipoDato o = sem.tipo(izq) == D_FLOAT || sem.tipo(der) == D_FLOAT ? D_FLOAT : D_INT;
+            bool real = o == D_FLOAT;
+            if (!real && (x.op == T_MAS || x.op == T_MENOS) && nodo(der).tipo == N_ENTERO)
+            {
+                int32_t k = entero(der);
+                if (x.op == T_MENOS)
+                    k = int32_t(0u - uint32_t(k));
+                if (k >= -32768 && k <= 32767)
+                {
+                    emitir(OP_SUMAIK, d, operando(izq, o), uint16_t(k));
+                    break;
+                }
+            }
+            uint16_t a = operando(izq, o), b = operando(der, o);
+            CodigoOp op;
+            switch (x.op)
+            {
+            case T_MAS:
+                op = real ? OP_SUMAF : OP_SUMAI;
+                break;
+            case T_MENOS:
+                op = real ? OP_RESTAF : OP_RESTAI;
+                break;
+            case T_POR:
+                op = real ? OP_MULF : OP_MULI;
+                break;
+            case T_ENTRE:
+                op = real ? OP_DIVF : OP_DIVI;
+                break;
+            case T_MENOR:
+                op = real ? OP_MENORF : OP_MENORI;
+                break;
+            case T_MAYOR:
+                op = real ? OP_MAYORF : OP_MAYORI;
+                break;
+            case T_MENORIG:
+                op = real ? OP_MENORIGF : OP_MENORIGI;
+                break;
+            case T_MAYORIG:
+                op = real ? OP_MAYORIGF : OP_MAYORIGI;
+                break;
+            case T_IGUAL:
+                op = real ? OP_IGUALF : OP_IGUALI;
+                break;
+            default:
+                op = real ? OP_DISTF : OP_DISTI;
+            }
+            emitir(op, d, a, b);
+            break;
+        }
+        default:
+            break;
+        }
+        libre = marca;
+    }
+
+    /// Compila la llamada n; si valor, su resultado queda en d
+    void llamada(Indice n, uint16_t d, bool valor)
+    {
+        Indice f = sem.enlace(n);
+        Indice arg = nodo(n).hijo;
+        uint32_t marca = libre;
+        if (f == PREDEFINIDA(P_PRINTI))
+            emitir(OP_PRINTI, operando(arg, D_INT));
+        else if (f == PREDEFINIDA(P_PRINTS))
+            emitirK(OP_PRINTS, 0, cadena(arg)); // solo los literales son cadenas
+        else
+        {
+            // cada argumento en el siguiente temporal; el marco de f empieza en el primero. Si d
+            // es el último temporal pedido, el marco empieza en d y el resultado queda ahí
+            uint16_t base = libre;
+            if (valor && d >= primerTemporal && d + 1u == libre)
+                libre = base = d;
+            Indice p = nodo(f).hijo;
+            for (; arg != NINGUNO; arg = nodo(arg).hermano, p = nodo(p).hermano)
+            {
+                uint16_t t = temporal();
+                expresion(arg, t, sem.tipo(p));
+                libre = t + 1;
+            }
+            if (libre == base)
+                temporal(); // el resultado necesita un registro aunque no haya argumentos
+            emitirK(OP_LLAMA, base, ranura[f]);
+            if (valor && d != base)
+                emitir(OP_MOV, d, base);
+        }
+        libre = marca;
+    }
+
+    void instruccion(Indice n)
+    {
+        const Nodo &x = nodo(n);
+        uint32_t marca = libre;
+        primerTemporal = libre;
+        switch (x.tipo)
+        {
+        case N_BLOQUE:
+            for (Indice i = x.hijo; i != NINGUNO; i = nodo(i).hermano)
+                instruccion(i);
+            break;
+        case N_DECLARACION:
+            for (Indice v = x.hijo; v != NINGUNO; v = nodo(v).hermano)
+            {
+                uint16_t r = temporal();
+                primerTemporal = r; // la variable no es visible en su valor inicial
+                TipoDato t = x.op == T_FLOAT ? D_FLOAT : D_INT;
+                if (nodo(v).hijo != NINGUNO)
+                    expresion(nodo(v).hijo, r, t);
+                else
+                    emitirK(OP_CARGA, r, 0); // los registros se reutilizan: se empieza en 0
+                ranura[v] = r;
+            }
+            return; // las variables siguen vivas hasta que cierre el bloque
+        case N_ASIGNACION:
+        {
+            Indice v = sem.enlace(n);
+            expresion(x.hijo, ranura[v], sem.tipo(v));
+            break;
+        }
+        case N_SI:
+        {
+            Indice entonces = nodo(x.hijo).hermano, sino = nodo(entonces).hermano;
+            size_t salto = emitirK(OP_SALTAF, condicion(x.hijo), 0);
+            libre = marca;
+            instruccion(entonces);
+            if (sino != NINGUNO)
+            {
+                size_t fin = emitirK(OP_SALTA, 0, 0);
+                resolver(salto);
+                instruccion(sino);
+                resolver(fin);
+            }
+            else
+                resolver(salto);
+            return; // una declaración sin bloque en el if sigue viva después, como en Semantico
+        }
+        case N_MIENTRAS:
+        {
+            size_t inicio = prog->codigo.size();
+            size_t salto = emitirK(OP_SALTAF, condicion(x.hijo), 0);
+            libre = marca;
+            instruccion(nodo(x.hijo).hermano);
+            emitirK(OP_SALTA, 0, inicio);
+            resolver(salto);
+            return;
+        }
+        case N_RETORNO:
+            if (x.hijo == NINGUNO)
+                emitir(OP_REGRESAV);
+            else
+                emitir(OP_REGRESA, operando(x.hijo, retornoActual));
+            break;
+        case N_LLAMADA:
+            llamada(n, 0, false);
+            break;
+        default:
+            break;
+        }
+        libre = marca;
+    }
+
+    void funcion(Indice f)
+    {
+        const Nodo &x = nodo(f);
+        FuncionBC &fn = prog->funciones[ranura[f]];
+        fn.inicio = prog->codigo.size();
+        retornoActual = x.op == T_FLOAT ? D_FLOAT : x.op == T_INT ? D_INT : D_VOID;
+        libre = maximo = 0;
+        for (Indice h = x.hijo; h != NINGUNO; h = nodo(h).hermano)
+            if (nodo(h).tipo == N_PARAMETRO)
+                ranura[h] = temporal();
+            else
+                instruccion(h);
+        // al final de la función sin return: una función int o float regresa 0
+        if (retornoActual == D_VOID)
+            emitir(OP_REGRESAV);
+        else
+        {
+            uint16_t t = temporal();
+            emitirK(OP_CARGA, t, 0);
+            emitir(OP_REGRESA, t);
+        }
+        fn.parametros = 0;
+        for (Indice h = x.hijo; h != NINGUNO && nodo(h).tipo == N_PARAMETRO; h = nodo(h).hermano)
+            ++fn.parametros;
+        fn.registros = std::max(maximo, 1u);
+    }
+
+public:
+    Compilador(const Lexico &lex, const Semantico &sem) : lex(lex), sem(sem) {}
+
+    /**
+     * @brief Compila arbol, que ya revisó sem sin errores.
+     * @return false si alguna función no cabe en 65535 registros (ver mensaje())
+     */
+    bool compilar(const Ast &arbol, Programa &p)
+    {
+        TRAZA("Compilador::compilar");
+        ast = &arbol;
+        prog = &p;
+        p.limpiar();
+        error.clear();
+        ranura.assign(arbol.size(), 0);
+        for (Indice f = arbol[0].hijo; f != NINGUNO; f = arbol[f].hermano)
+        {
+            ranura[f] = p.funciones.size();
+            p.funciones.push_back(FuncionBC{0, 0, 0, f});
+            if (lex.texto(arbol.token(f)) == "main")
+                p.principal = ranura[f];
+        }
+        for (Indice f = arbol[0].hijo; f != NINGUNO && error.empty(); f = arbol[f].hermano)
+            funcion(f);
+        return error.empty();
+    }
+
+    const std::string &mensaje() const
+    {
+        return error;
+    }
+};
+
+#endif
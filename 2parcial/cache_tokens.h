@@ -0,0 +1,220 @@
+/**
+ * @file    cache_tokens.h
+ * @version 1.0
+ * @date    19/10/2026
+ * @title   Caché de tokens en disco
+ * @brief   Formato binario con el que Lexico guarda junto al código fuente los tokens ya
+ *          reconocidos. El archivo se identifica con un hash del contenido del fuente y una huella
+ *          del analizador léxico; si ambos coinciden en la siguiente ejecución los tokens se
+ *          mapean con mmap y se usan directamente, sin volver a analizar.
+ *
+ *          Disposición del archivo (todas las secciones alineadas a 64 bytes):
+ *            CabeceraCache | Token[nTokens] | unsigned lineas[nLineas] | unsigned simbolos[nSimbolos]
+ */
+
+#ifndef CACHE_TOKENS_H
+#define CACHE_TOKENS_H
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/// Se incrementa cada vez que cambia el formato del archivo
+#define VERSION_CACHE 1
+
+/// Alineación de cada sección del archivo
+#define ALINEACION_CACHE 64
+
+struct CabeceraCache
+{
+    char magia[4];
+    uint32_t version;
+    /// Huella del analizador léxico que generó los tokens (autómata, palabras reservadas, Token)
+    uint64_t huella;
+    /// hashBytes del código fuente y su tamaño
+    uint64_t hash;
+    uint64_t tamFuente;
+    uint32_t nTokens;
+    uint32_t nLineas;
+    /// Número de símbolos locales; el campo sym de los tokens es un índice local al archivo
+    uint32_t nSimbolos;
+    /// 1 si los tokens se generaron con internador (sym válido), 0 si todos son SIN_SIMBOLO
+    uint32_t conSimbolos;
+    /// Nanosegundos que tardó Lexico::analizar al crear la caché
+    uint64_t nsAnalisis;
+    /// Veces que la caché se usó y veces que se tuvo que regenerar
+    uint32_t aciertos;
+    uint32_t fallos;
+};
+
+/// Redondea una posición a la siguiente sección alineada
+inline uint64_t alinearCache(uint64_t x)
+{
+    return (x + ALINEACION_CACHE - 1) & ~(uint64_t)(ALINEACION_CACHE - 1);
+}
+
+/**
+ * @brief Archivo de caché abierto. Los tokens, líneas y símbolos apuntan a las páginas mapeadas,
+ * salvo cuando hubo que renumerar los símbolos para otro internador (ver Lexico::leerCache).
+ */
+class CacheTokens
+{
+    const char *mapa = nullptr;
+    size_t tamMapa = 0;
+    /// Tokens con los símbolos renumerados al internador del proceso
+    std::vector<Token> remapeados;
+
+public:
+    /// Cabecera leída; en ceros si el archivo no existe o no es una caché válida
+    CabeceraCache cab = {};
+    const Token *tokens = nullptr;
+    const unsigned *lineas = nullptr;
+    /// Índice del primer token de cada símbolo local
+    const unsigned *simbolos = nullptr;
+
+    CacheTokens() = default;
+    CacheTokens(const CacheTokens &) = delete;
+    CacheTokens &operator=(const CacheTokens &) = delete;
+    ~CacheTokens() { cerrar(); }
+
+    void cerrar()
+    {
+        if (mapa)
+            munmap((void *)mapa, tamMapa);
+        mapa = nullptr;
+        tamMapa = 0;
+        remapeados.clear();
+        tokens = nullptr;
+        lineas = simbolos = nullptr;
+    }
+
+    /**
+     * @brief Mapea un archivo de caché y verifica su formato (no que corresponda al fuente).
+     *
+     * @param ruta Ruta del archivo de caché
+     * @return false si no existe, es de otra versión o está truncado | true en otro caso
+     */
+    bool abrir(const char *ruta)
+    {
+        cerrar();
+        cab = CabeceraCache{};
+        int fd = open(ruta, O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(CabeceraCache))
+        {
+            close(fd);
+            return false;
+        }
+        void *m = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (m == MAP_FAILED)
+            return false;
+        mapa = (const char *)m;
+        tamMapa = st.st_size;
+
+        memcpy(&cab, mapa, sizeof cab);
+        if (memcmp(cab.magia, "TOKC", 4) != 0 || cab.version != VERSION_CACHE)
+        {
+            cab = CabeceraCache{};
+            cerrar();
+            return false;
+        }
+        uint64_t t = alinearCache(sizeof(CabeceraCache));
+        uint64_t l = alinearCache(t + (uint64_t)cab.nTokens * sizeof(Token));
+        uint64_t s = alinearCache(l + (uint64_t)cab.nLineas * sizeof(unsigned));
+        if (s + (uint64_t)cab.nSimbolos * sizeof(unsigned) != tamMapa)
+        {
+            cerrar();
+            return false;
+        }
+        tokens = (const Token *)(mapa + t);
+        lineas = (const unsigned *)(mapa + l);
+        simbolos = (const unsigned *)(mapa + s);
+        return true;
+    }
+
+    /**
+     * @brief Verifica que el contenido del archivo sea coherente con un fuente de cab.tamFuente
+     * bytes, para que un archivo dañado no haga leer fuera del fuente o de los tokens: cada token
+     * dentro del fuente y con un tipo válido, cada símbolo local en rango y apuntando a un token, y
+     * las líneas empezando en 0, crecientes y dentro del fuente. Recorre todo el archivo (como el
+     * hash recorre todo el fuente).
+     *
+     * @return false si algo está fuera de rango | true en otro caso
+     */
+    bool coherente() const
+    {
+        uint64_t tam = cab.tamFuente;
+        for (uint32_t i = 0; i < cab.nTokens; ++i)
+        {
+            const Token &t = tokens[i];
+            if ((uint64_t)t.ini + t.lon > tam || t.tipo >= T_NUM ||
+                (t.sym != SIN_SIMBOLO && (!cab.conSimbolos || t.sym >= cab.nSimbolos)))
+                return false;
+        }
+        for (uint32_t i = 0; i < cab.nSimbolos; ++i)
+            if (simbolos[i] >= cab.nTokens)
+                return false;
+        if (cab.nLineas == 0 || lineas[0] != 0)
+            return false;
+        for (uint32_t i = 1; i < cab.nLineas; ++i)
+            if (lineas[i] < lineas[i - 1] || lineas[i] > tam)
+                return false;
+        return true;
+    }
+
+    /// Sustituye los tokens mapeados por una copia (se usa al renumerar símbolos)
+    std::vector<Token> &copiarTokens()
+    {
+        remapeados.assign(tokens, tokens + cab.nTokens);
+        tokens = remapeados.data();
+        return remapeados;
+    }
+
+    const Token *begin() const { return tokens; }
+    const Token *end() const { return tokens + cab.nTokens; }
+    size_t size() const { return cab.nTokens; }
+};
+
+/**
+ * @brief Escribe un archivo de caché completo. Se escribe primero en ruta.tmp y luego se renombra,
+ * para que otra ejecución nunca mapee un archivo a medio escribir.
+ *
+ * @return false si no se pudo escribir | true en otro caso
+ */
+inline bool escribirCacheTokens(const char *ruta, const CabeceraCache &cab, const Token *tokens,
+                                const unsigned *lineas, const unsigned *simbolos)
+{
+    std::string tmp = std::string(ruta) + ".tmp";
+    FILE *f = fopen(tmp.c_str(), "wb");
+    if (!f)
+        return false;
+
+    static const char ceros[ALINEACION_CACHE] = {};
+    uint64_t pos = 0;
+    bool ok = true;
+    auto seccion = [&](const void *p, uint64_t n) {
+        uint64_t relleno = alinearCache(pos) - pos;
+        ok = ok && fwrite(ceros, 1, relleno, f) == relleno && fwrite(p, 1, n, f) == n;
+        pos += relleno + n;
+    };
+    seccion(&cab, sizeof cab);
+    seccion(tokens, (uint64_t)cab.nTokens * sizeof(Token));
+    seccion(lineas, (uint64_t)cab.nLineas * sizeof(unsigned));
+    seccion(simbolos, (uint64_t)cab.nSimbolos * sizeof(unsigned));
+
+    ok = fclose(f) == 0 && ok;
+    if (ok && rename(tmp.c_str(), ruta) == 0)
+        return true;
+    remove(tmp.c_str());
+    return false;
+}
+
+#endif
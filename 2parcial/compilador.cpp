@@ -1,11 +1,13 @@
 #include "lexico.h"
 #include "lexico.cpp"
+#include <chrono>
+#include <string>
 
 int main(int argc, char *argv[])
 {
     Lexico lex;
     std::vector<Token> tokens;
-    int j;
+    size_t j;
 
     if (argc < 2)
     {
@@ -14,27 +16,49 @@ int main(int argc, char *argv[])
     }
 
     // se abre el archivo que se pasa por parametro
-    std::fstream file(argv[1]);
-
-    if (!file)
+    if (!lex.abrir(argv[1]))
     {
         std::cout << "Error: no se pudo abrir el archivo.\n\n";
         return 0;
     }
 
-    // retorna false si existe algun error en el analisis y termina la ejecución
-    if (!lex.analizar(file, tokens))
+    // si el código fuente no cambió desde la última ejecución se usan los tokens de la caché
+    std::string rutaCache = std::string(argv[1]) + ".tok";
+    CacheTokens cache;
+    const Token *tk;
+    size_t n;
+    auto t0 = std::chrono::steady_clock::now();
+    if (lex.leerCache(rutaCache.c_str(), cache))
+    {
+        double seg = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        tk = cache.begin();
+        n = cache.size();
+        std::cerr << "caché de tokens: acierto (" << cache.cab.aciertos << " de "
+                  << cache.cab.aciertos + cache.cab.fallos << " ejecuciones), carga " << seg * 1e3
+                  << " ms, ahorro " << (cache.cab.nsAnalisis / 1e9 - seg) * 1e3 << " ms\n";
+    }
+    else
     {
-        cout << "hubo errores en el analisis Léxico";
-        return EXIT_FAILURE;
+        // retorna false si existe algun error en el analisis y termina la ejecución
+        if (!lex.analizar(tokens))
+        {
+            cout << "hubo errores en el analisis Léxico";
+            return EXIT_FAILURE;
+        }
+        double seg = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        if (lex.escribirCache(rutaCache.c_str(), tokens, seg, cache))
+            std::cerr << "caché de tokens: fallo (" << cache.cab.aciertos << " de "
+                      << cache.cab.aciertos + cache.cab.fallos + 1 << " ejecuciones), análisis "
+                      << seg * 1e3 << " ms\n";
+        tk = tokens.data();
+        n = tokens.size();
     }
 
     cout << "\n----------------------\n\n";
-    for (j = 0; j < tokens.size(); ++j)
+    for (j = 0; j < n; ++j)
     {
-        std::cout << tokens[j].ln << " : " << tokens[j].token << " : " << tokens[j].type << "\n";
+        std::cout << lex.linea(tk[j]) << " : " << lex.texto(tk[j]) << " : " << nombreTipo[tk[j].tipo] << "\n";
     }
 
-    file.close();
     return 0;
 }
\ No newline at end of file
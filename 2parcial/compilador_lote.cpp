@@ -0,0 +1,147 @@
+/**
+ * @file    compilador_lote.cpp
+ * @version 1.0
+ * @date    19/10/2026
+ * @brief   Compila muchos archivos a la vez. Recibe archivos y directorios (en estos busca los .c
+ *          recursivamente) y por cada archivo encadena las etapas léxico -> sintáctico ->
+ *          semántico como tareas de un grupo de hilos con robo de tareas (tareas.h). Los errores
+ *          de cada archivo se guardan aparte y se muestran en el orden de los archivos, igual sin
+ *          importar cuántos hilos se usen.
+ *
+ *          g++ -std=c++17 -O2 -pthread compilador_lote.cpp -o compilador_lote
+ *          ./compilador_lote [-j hilos] archivo.c... directorio...
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <sstream>
+#include "sintactico.h"
+#include "sintactico.cpp"
+#include "semantico.h"
+#include "tareas.h"
+
+namespace fs = std::filesystem;
+
+/// Estado de un archivo mientras pasa por las etapas
+struct Archivo
+{
+    std::string ruta;
+    std::unique_ptr<Lexico> lex;
+    std::vector<Token> tokens;
+    Ast ast;
+    /// Errores del archivo, en el orden en que los reportan las etapas
+    std::ostringstream diag;
+    bool ok = true;
+    bool listo = false;
+};
+
+int main(int argc, char *argv[])
+{
+    unsigned nh = std::thread::hardware_concurrency();
+    std::vector<std::string> rutas;
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string a = argv[i];
+        if (a == "-j" && i + 1 < argc)
+            nh = std::max(1, atoi(argv[++i]));
+        else if (fs::is_directory(a))
+        {
+            std::vector<std::string> encontrados;
+            for (auto &e : fs::recursive_directory_iterator(a))
+                if (e.is_regular_file() && e.path().extension() == ".c")
+                    encontrados.push_back(e.path().string());
+            std::sort(encontrados.begin(), encontrados.end());
+            rutas.insert(rutas.end(), encontrados.begin(), encontrados.end());
+        }
+        else
+            rutas.push_back(a);
+    }
+    if (rutas.empty())
+    {
+        std::cout << "Necesita indicar los archivos o directorios por compilar.\n";
+        return 0;
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    std::vector<Archivo> archivos(rutas.size());
+    Internador internador;
+    std::mutex m;
+    std::condition_variable listo;
+
+    // última etapa de un archivo: libera su memoria y avisa que ya se pueden mostrar sus errores
+    auto terminar = [&](Archivo &a) {
+        a.lex.reset();
+        std::vector<Token>().swap(a.tokens);
+        a.ast = Ast();
+        std::lock_guard<std::mutex> g(m);
+        a.listo = true;
+        listo.notify_all();
+    };
+
+    {
+        PoolTareas pool(nh);
+        for (size_t i = 0; i < rutas.size(); ++i)
+        {
+            archivos[i].ruta = rutas[i];
+            pool.agregar([&, i] {
+                Archivo &a = archivos[i];
+                a.lex.reset(new Lexico());
+                a.lex->usarSalida(a.diag);
+                a.lex->usarInternador(&internador);
+                if (!a.lex->abrir(a.ruta.c_str()))
+                {
+                    a.diag << "Error: no se pudo abrir el archivo.\n";
+                    a.ok = false;
+                    terminar(a);
+                    return;
+                }
+                // con tokens inválidos no se sigue, igual que en compilador.cpp
+                if (!a.lex->analizar(a.tokens))
+                {
+                    a.ok = false;
+                    terminar(a);
+                    return;
+                }
+
+                pool.agregar([&, i] {
+                    Archivo &a = archivos[i];
+                    Sintactico sin;
+                    sin.usarLexico(a.lex.get());
+                    sin.usarSalida(a.diag);
+                    if (!sin.analizar(a.tokens))
+                    {
+                        a.ok = false;
+                        terminar(a);
+                        return;
+                    }
+                    a.ast = std::move(sin.arbol());
+
+                    pool.agregar([&, i] {
+                        Archivo &a = archivos[i];
+                        Semantico sem(*a.lex, internador, a.diag);
+                        a.ok = sem.analizar(a.ast);
+                        terminar(a);
+                    });
+                });
+            });
+        }
+
+        // los errores se muestran en el orden de los archivos conforme estos terminan
+        for (Archivo &a : archivos)
+        {
+            std::unique_lock<std::mutex> g(m);
+            listo.wait(g, [&] { return a.listo; });
+            g.unlock();
+            if (!a.ok)
+                std::cout << a.ruta << ":\n" << a.diag.str();
+        }
+        pool.esperar();
+    }
+
+    size_t errores = std::count_if(archivos.begin(), archivos.end(), [](const Archivo &a) { return !a.ok; });
+    double seg = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    std::cerr << archivos.size() << " archivos, " << errores << " con errores, " << internador.size()
+              << " símbolos, " << seg * 1e3 << " ms con " << nh << " hilos\n";
+    return errores ? EXIT_FAILURE : 0;
+}
@@ -0,0 +1,163 @@
+/**
+ * @file    ejecutar.cpp
+ * @version 1.0
+ * @date    19/10/2026
+ * @brief   Compila un programa a bytecode (bytecode.h) y lo ejecuta en la máquina virtual
+ *          (maquina.h). Con -O pasa antes por la forma SSA y el optimizador (ssa.h,
+ *          optimizador.h). Con -d muestra el bytecode en lugar de ejecutarlo (y con -O también
+ *          la forma SSA optimizada); con -e muestra al final las instrucciones ejecutadas y el
+ *          tiempo, y con -O las instrucciones SSA después de cada paso. El programa termina con
+ *          el valor que devuelve main. En archivos grandes el análisis sintáctico reparte las
+ *          funciones entre los núcleos (analizarEnParalelo).
+ *
+ *          Con -c no ejecuta el programa: guarda el bytecode como módulo (modulo.h) en archivo.bc.
+ *          Si el archivo que recibe es un módulo, lo mapea y lo ejecuta directamente, sin
+ *          analizar ni compilar nada; si el módulo está dañado, reporta por qué y no lo ejecuta.
+ *
+ *          Compilado con -DCON_TRAZA y con TRAZA=traza.json en el ambiente, escribe cuánto tardó
+ *          cada etapa en traza.json (comun/traza.h), que se abre en chrome://tracing o en
+ *          Perfetto. Con -DCON_CONTADORES y CONTADORES=1, muestra al final los contadores del
+ *          procesador de cada etapa por token (comun/contadores.h).
+ *
+ *          g++ -std=c++17 -O2 -pthread ejecutar.cpp -o ejecutar
+ *          ./ejecutar [-O] [-d] [-e] [-c] archivo.c
+ *          ./ejecutar [-e] archivo.bc
+ */
+
+#include <chrono>
+#include "sintactico.h"
+#include "sintactico.cpp"
+#include "maquina.h"
+#include "optimizador.h"
+#include "modulo.h"
+
+/// Ejecuta el programa que ya tiene vm; con estadisticas las muestra en cerr al terminar
+static int ejecutar(Maquina &vm, bool estadisticas, size_t nCodigo)
+{
+    int32_t resultado;
+    auto t0 = std::chrono::steady_clock::now();
+    bool ok = vm.ejecutar(resultado);
+    double seg = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    std::cout.flush();
+    if (!ok)
+    {
+        std::cerr << "Error de ejecución: " << vm.mensaje() << "\n";
+        return EXIT_FAILURE;
+    }
+    if (estadisticas)
+        std::cerr << nCodigo << " instrucciones de bytecode, " << vm.nInstrucciones() << " ejecutadas en "
+                  << seg * 1e3 << " ms (" << vm.nInstrucciones() / seg / 1e6 << " Minstrucciones/s)\n";
+    return resultado;
+}
+
+int main(int argc, char *argv[])
+{
+    bool desensamblar = false, estadisticas = false, optimizar = false, guardar = false;
+    const char *ruta = nullptr;
+    for (int i = 1; i < argc; ++i)
+        if (!strcmp(argv[i], "-d"))
+            desensamblar = true;
+        else if (!strcmp(argv[i], "-e"))
+            estadisticas = true;
+        else if (!strcmp(argv[i], "-O"))
+            optimizar = true;
+        else if (!strcmp(argv[i], "-c"))
+            guardar = true;
+        else
+            ruta = argv[i];
+    if (!ruta)
+    {
+        std::cout << "Necesita indicar el nombre del código fuente.\n";
+        return 0;
+    }
+
+    ModuloBytecode modulo;
+    if (modulo.abrir(ruta))
+    {
+        if (desensamblar || guardar)
+        {
+            std::cout << "Error: " << ruta << " ya es un módulo compilado.\n";
+            return EXIT_FAILURE;
+        }
+        Maquina vm(modulo.vista(), std::cout);
+        return ejecutar(vm, estadisticas, modulo.cab.nCodigo);
+    }
+    if (!modulo.mensaje().empty())
+    {
+        std::cout << "Error: " << ruta << ": " << modulo.mensaje() << ".\n";
+        return EXIT_FAILURE;
+    }
+
+    Lexico lex;
+    Internador internador;
+    lex.usarInternador(&internador);
+    if (!lex.abrir(ruta))
+    {
+        std::cout << "Error: no se pudo abrir el archivo.\n";
+        return EXIT_FAILURE;
+    }
+    std::vector<Token> tokens;
+    if (!lex.analizar(tokens))
+        return EXIT_FAILURE;
+    Sintactico sin;
+    sin.usarLexico(&lex);
+    if (!analizarEnParalelo(tokens, sin))
+        return EXIT_FAILURE;
+    Semantico sem(lex, internador, std::cout);
+    if (!sem.analizar(sin.arbol()))
+        return EXIT_FAILURE;
+
+    Programa prog;
+    if (optimizar)
+    {
+        ProgramaSsa ssa;
+        ConstructorSsa(lex, sem).construir(sin.arbol(), ssa);
+        Optimizador opt;
+        opt.optimizar(ssa);
+        if (estadisticas)
+            for (const Optimizador::Paso &p : opt.estadisticas())
+                std::cerr << p.nombre << ": " << p.instrucciones << " instrucciones SSA (" << p.cambios
+                          << " cambios)\n";
+        if (desensamblar)
+            for (const FuncionSsa &f : ssa.funciones)
+                if (f.viva)
+                    f.imprimir(std::cout, lex, sin.arbol());
+        TraductorBytecode tr;
+        if (!tr.traducir(ssa, prog))
+        {
+            std::cout << "Error: " << tr.mensaje() << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+    else
+    {
+        Compilador comp(lex, sem);
+        if (!comp.compilar(sin.arbol(), prog))
+        {
+            std::cout << "Error: " << comp.mensaje() << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+    if (desensamblar)
+    {
+        prog.desensamblar(std::cout, lex, sin.arbol());
+        return 0;
+    }
+    if (guardar)
+    {
+        std::string salida = ruta;
+        size_t punto = salida.rfind('.');
+        if (punto != std::string::npos && salida.find('/', punto) == std::string::npos)
+            salida.resize(punto);
+        salida += ".bc";
+        if (!escribirModulo(salida.c_str(), prog))
+        {
+            std::cout << "Error: no se pudo escribir " << salida << "\n";
+            return EXIT_FAILURE;
+        }
+        return 0;
+    }
+
+    Maquina vm(prog, std::cout);
+    return ejecutar(vm, estadisticas, prog.codigo.size());
+}
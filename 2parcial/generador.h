@@ -0,0 +1,419 @@
+/**
+ * @file    generador.h
+ * @version 1.0
+ * @date    19/10/2026
+ * @title   Generador de programas sintéticos
+ * @brief   Genera programas válidos del lenguaje, del tamaño que se pida, para medir el
+ *          analizador léxico (y más adelante el sintáctico) con algo más grande que exa.c. Los
+ *          programas tienen funciones con parámetros, declaraciones, asignaciones, if/else,
+ *          while, return, llamadas a funciones y literales enteros, reales y cadenas. La
+ *          proporción de cada elemento se ajusta con Mezcla.
+ *
+ *          Los programas también son válidos para semantico.h: cada variable se declara antes de
+ *          usarse, a un int solo se le asignan expresiones int, las cadenas solo van en printS y
+ *          los return corresponden al tipo de la función.
+ */
+
+#ifndef GENERADOR_H
+#define GENERADOR_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Pesos relativos de cada elemento del programa generado. Un peso de 0 elimina el
+ * elemento; los pesos solo se comparan con los de su mismo grupo.
+ */
+struct Mezcla
+{
+    // instrucciones
+    unsigned declaracion = 3;
+    unsigned asignacion = 4;
+    unsigned si = 2;
+    unsigned mientras = 1;
+    unsigned llamada = 2;
+    unsigned retorno = 1;
+
+    // operandos de las expresiones (cadena es el peso de printS entre las llamadas)
+    unsigned id = 5;
+    unsigned entero = 3;
+    unsigned real = 2;
+    unsigned cadena = 1;
+
+    /// Probabilidad (en %) de que un operando sea a su vez una operación
+    unsigned operacion = 45;
+
+    /// Profundidad máxima de expresiones y de bloques anidados
+    unsigned profundidad = 3;
+
+    /// Longitud máxima de los identificadores y de las cadenas
+    unsigned lonId = 10;
+    unsigned lonCadena = 24;
+
+    /// Instrucciones por función (máximo)
+    unsigned instrucciones = 12;
+
+    /**
+     * @brief Cambia un peso a partir de un texto nombre=valor (p. ej. "cadena=5").
+     * @return false si el nombre no existe
+     */
+    bool asignar(const std::string &par)
+    {
+        size_t i = par.find('=');
+        if (i == std::string::npos)
+            return false;
+        std::string n = par.substr(0, i);
+        unsigned v = std::stoul(par.substr(i + 1));
+        struct
+        {
+            const char *nombre;
+            unsigned Mezcla::*campo;
+        } campos[] = {{"declaracion", &Mezcla::declaracion}, {"asignacion", &Mezcla::asignacion},
+                      {"si", &Mezcla::si}, {"mientras", &Mezcla::mientras},
+                      {"llamada", &Mezcla::llamada}, {"retorno", &Mezcla::retorno},
+                      {"id", &Mezcla::id}, {"entero", &Mezcla::entero},
+                      {"real", &Mezcla::real}, {"cadena", &Mezcla::cadena},
+                      {"operacion", &Mezcla::operacion}, {"profundidad", &Mezcla::profundidad},
+                      {"lonId", &Mezcla::lonId}, {"lonCadena", &Mezcla::lonCadena},
+                      {"instrucciones", &Mezcla::instrucciones}};
+        for (auto &c : campos)
+            if (n == c.nombre)
+            {
+                this->*c.campo = v;
+                return true;
+            }
+        return false;
+    }
+};
+
+class GeneradorPrograma
+{
+    Mezcla m;
+    /// Estado del generador pseudoaleatorio (xorshift64*), para que la salida dependa solo de la semilla
+    uint64_t estado;
+    std::string &s;
+    struct Funcion
+    {
+        std::string nombre;
+        /// true en los parámetros float
+        std::vector<bool> reales;
+        /// Tipo de retorno: 'i', 'f' o 'v'
+        char tipo;
+    };
+    /// Funciones generadas hasta ahora, para llamarlas
+    std::vector<Funcion> funciones;
+    /// Variables visibles en la función actual; true si son float
+    std::vector<std::pair<std::string, bool>> variables;
+    /// Tipo de retorno de la función actual: "int ", "float " o "void "
+    const char *retorno = "int ";
+
+    uint64_t azar()
+    {
+        estado ^= estado >> 12;
+        estado ^= estado << 25;
+        estado ^= estado >> 27;
+        return estado * 0x2545F4914F6CDD1DULL;
+    }
+
+    /// Número en [0, n)
+    unsigned hasta(unsigned n)
+    {
+        return n ? azar() % n : 0;
+    }
+
+    /// Elige un índice con probabilidad proporcional a su peso; -1 si todos son 0
+    int elegir(std::initializer_list<unsigned> pesos)
+    {
+        unsigned total = 0;
+        for (unsigned p : pesos)
+            total += p;
+        if (total == 0)
+            return -1;
+        unsigned r = hasta(total), i = 0;
+        for (unsigned p : pesos)
+        {
+            if (r < p)
+                return i;
+            r -= p;
+            ++i;
+        }
+        return -1;
+    }
+
+    void sangria(unsigned nivel)
+    {
+        s.append(nivel * 4, ' ');
+    }
+
+    /// Identificador nuevo que no es palabra reservada (todos terminan en un dígito)
+    std::string nombre()
+    {
+        std::string n;
+        unsigned lon = 1 + hasta(m.lonId > 1 ? m.lonId - 1 : 1);
+        n += char('a' + hasta(26));
+        for (unsigned i = 1; i < lon; ++i)
+        {
+            unsigned c = hasta(62);
+            n += char(c < 26 ? 'a' + c : c < 52 ? 'A' + c - 26 : '0' + c - 52);
+        }
+        n += char('0' + hasta(10));
+        return n;
+    }
+
+    /// Literal de cadena con comillas y saltos de línea escapados
+    void cadena()
+    {
+        s += '"';
+        unsigned lon = hasta(m.lonCadena + 1);
+        for (unsigned i = 0; i < lon; ++i)
+        {
+            unsigned c = hasta(40);
+            if (c == 0)
+                s += "\\\"";
+            else if (c == 1)
+                s += "\\n";
+            else
+                s += char(c < 20 ? 'a' + c : ' ');
+        }
+        s += '"';
+    }
+
+    /// Operando de tipo float si real, si no de tipo int
+    /// Nombre que no tiene ninguna variable visible
+    std::string nombreVariable()
+    {
+        for (;;)
+        {
+            std::string n = nombre();
+            bool usado = false;
+            for (auto &v : variables)
+                usado = usado || v.first == n;
+            if (!usado)
+                return n;
+        }
+    }
+
+    void operando(unsigned nivel, bool real)
+    {
+        if (nivel < m.profundidad && hasta(100) < m.operacion)
+        {
+            expresion(nivel + 1, real);
+            return;
+        }
+        switch (elegir({variables.empty() ? 0 : m.id, m.entero, real ? m.real : 0}))
+        {
+        case 0:
+        {
+            // a una expresión int no le sirve una variable float: se cambia por un entero
+            auto &v = variables[hasta(variables.size())];
+            if (v.second && !real)
+                s += std::to_string(hasta(100000));
+            else
+                s += v.first;
+            break;
+        }
+        case 2:
+            s += std::to_string(hasta(10000));
+            s += '.';
+            s += std::to_string(hasta(1000));
+            break;
+        default:
+            s += std::to_string(hasta(100000));
+        }
+    }
+
+    /// operando (operador operando)*, a veces entre paréntesis o negada; de tipo float si real
+    void expresion(unsigned nivel, bool real)
+    {
+        static const char *op[] = {" + ", " - ", " * ", " / ", " < ", " > ", " <= ", " >= ",
+                                   " == ", " != ", " && ", " || "};
+        bool agrupar = nivel > 0;
+        if (agrupar)
+            s += hasta(8) == 0 ? "!(" : "(";
+        operando(nivel, real);
+        for (unsigned k = hasta(3); k > 0; --k)
+        {
+            s += op[hasta(12)];
+            operando(nivel, real);
+        }
+        if (agrupar)
+            s += ')';
+    }
+
+    void bloque(unsigned nivel)
+    {
+        sangria(nivel - 1);
+        s += "{\n";
+        size_t visibles = variables.size();
+        for (unsigned k = 1 + hasta(m.instrucciones); k > 0; --k)
+            instruccion(nivel);
+        variables.resize(visibles);
+        sangria(nivel - 1);
+        s += "}\n";
+    }
+
+    void instruccion(unsigned nivel)
+    {
+        bool anidar = nivel <= m.profundidad;
+        int i = elegir({m.declaracion, variables.empty() ? 0 : m.asignacion, anidar ? m.si : 0,
+                        anidar ? m.mientras : 0, m.llamada, m.retorno});
+        sangria(nivel);
+        switch (i)
+        {
+        case 0:
+        {
+            std::string n = nombreVariable();
+            bool real = hasta(2) == 0;
+            s += real ? "float " : "int ";
+            s += n;
+            if (hasta(3))
+            {
+                s += " = ";
+                expresion(0, real);
+            }
+            s += ";\n";
+            variables.emplace_back(n, real);
+            break;
+        }
+        case 1:
+        {
+            auto &v = variables[hasta(variables.size())];
+            s += v.first;
+            s += " = ";
+            expresion(0, v.second);
+            s += ";\n";
+            break;
+        }
+        case 2:
+            s += "if (";
+            expresion(0, true);
+            s += ")\n";
+            bloque(nivel + 1);
+            if (hasta(2))
+            {
+                sangria(nivel);
+                s += "else\n";
+                bloque(nivel + 1);
+            }
+            break;
+        case 3:
+            s += "while (";
+            expresion(0, true);
+            s += ")\n";
+            bloque(nivel + 1);
+            break;
+        case 4:
+            llamada();
+            s += ";\n";
+            break;
+        default:
+            if (retorno[0] == 'v')
+                s += "return;\n";
+            else
+            {
+                s += "return ";
+                expresion(0, retorno[0] == 'f');
+                s += ";\n";
+            }
+        }
+    }
+
+    void llamada()
+    {
+        if (funciones.empty() || hasta(m.cadena + 3) < m.cadena)
+        {
+            s += "printS(";
+            cadena();
+            s += ')';
+            return;
+        }
+        auto &f = funciones[hasta(funciones.size())];
+        s += f.nombre;
+        s += '(';
+        for (size_t p = 0; p < f.reales.size(); ++p)
+        {
+            if (p)
+                s += ", ";
+            expresion(0, f.reales[p]);
+        }
+        s += ')';
+    }
+
+    void funcion(const std::string &n, bool principal)
+    {
+        static const char *tipo[] = {"int ", "float ", "void "};
+        variables.clear();
+        retorno = principal ? "int " : tipo[hasta(3)];
+        s += retorno;
+        s += n;
+        s += '(';
+        Funcion f{n, {}, retorno[0]};
+        unsigned np = principal ? 0 : hasta(4);
+        for (unsigned p = 0; p < np; ++p)
+        {
+            std::string v = nombreVariable();
+            bool real = hasta(2) == 0;
+            s += p ? ", " : "";
+            s += real ? "float " : "int ";
+            s += v;
+            variables.emplace_back(v, real);
+            f.reales.push_back(real);
+        }
+        s += ")\n";
+        bloque(1);
+        s += '\n';
+        if (!principal)
+            funciones.push_back(f);
+    }
+
+public:
+    /**
+     * @param salida Cadena donde se agrega el programa
+     * @param mezcla Proporción de cada elemento
+     * @param semilla Misma semilla y mezcla producen el mismo programa
+     */
+    GeneradorPrograma(std::string &salida, const Mezcla &mezcla = Mezcla(), uint64_t semilla = 2022)
+        : m(mezcla), estado(semilla * 0x9E3779B97F4A7C15ULL + 1), s(salida)
+    {
+    }
+
+    /**
+     * @brief Agrega funciones hasta que la salida tenga al menos bytes caracteres y termina el
+     * programa con main.
+     *
+     * @param usarTodas Si es true, main no es aleatorio: llama a cada función y acumula sus
+     * resultados en el valor que escribe y devuelve, así que un optimizador no puede quitar
+     * ninguna como código muerto (el programa no está hecho para ejecutarse: sus ciclos pueden
+     * no terminar)
+     */
+    void generar(size_t bytes, bool usarTodas = false)
+    {
+        s.reserve(bytes + 4096);
+        // el número después de la última x hace único el nombre de cada función
+        while (s.size() < bytes)
+            funcion(nombre() + "x" + std::to_string(funciones.size()), false);
+        if (!usarTodas)
+        {
+            funcion("main", true);
+            return;
+        }
+        s += "int main()\n{\n    int suma = 0;\n";
+        for (const Funcion &f : funciones)
+        {
+            std::string llamada = f.nombre + "(";
+            for (size_t p = 0; p < f.reales.size(); ++p)
+                llamada += std::string(p ? ", " : "") + (f.reales[p] ? "1.5" : "3");
+            llamada += ")";
+            if (f.tipo == 'i')
+                s += "    suma = suma + " + llamada + ";\n";
+            else if (f.tipo == 'f')
+                s += "    if (" + llamada + " < 0.5)\n    {\n        suma = suma + 1;\n    }\n";
+            else
+                s += "    " + llamada + ";\n";
+        }
+        s += "    printI(suma);\n    return suma;\n}\n";
+    }
+};
+
+#endif
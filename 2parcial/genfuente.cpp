@@ -0,0 +1,51 @@
+/**
+ * @file    genfuente.cpp
+ * @version 1.0
+ * @date    19/10/2026
+ * @brief   Escribe un programa sintético del lenguaje del tamaño pedido (ver generador.h).
+ *
+ *          g++ -std=c++17 -O2 genfuente.cpp -o genfuente
+ *          ./genfuente MB salida.c [semilla] [nombre=valor ...]
+ *
+ *          Ejemplo con más cadenas y sin ciclos: ./genfuente 64 grande.c 7 cadena=6 mientras=0
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include "generador.h"
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        std::cout << "uso: " << argv[0] << " MB salida.c [semilla] [nombre=valor ...]\n";
+        return EXIT_FAILURE;
+    }
+
+    Mezcla m;
+    uint64_t semilla = 2022;
+    for (int i = 3; i < argc; ++i)
+    {
+        std::string a = argv[i];
+        if (a.find('=') == std::string::npos)
+            semilla = std::stoull(a);
+        else if (!m.asignar(a))
+        {
+            std::cout << "Error: no existe el elemento " << a << " en la mezcla\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::string fuente;
+    GeneradorPrograma(fuente, m, semilla).generar(atof(argv[1]) * 1e6);
+
+    FILE *f = fopen(argv[2], "wb");
+    if (!f || fwrite(fuente.data(), 1, fuente.size(), f) != fuente.size())
+    {
+        std::cout << "Error: no se pudo escribir " << argv[2] << "\n";
+        return EXIT_FAILURE;
+    }
+    fclose(f);
+    return 0;
+}
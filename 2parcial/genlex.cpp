@@ -0,0 +1,676 @@
+/**
+ * @file    genlex.cpp
+ * @version 1.0
+ * @date    19/10/2026
+ * @brief   Generador del analizador léxico. Lee las reglas de los tokens (expresiones regulares
+ *          con prioridad), construye el AFN de Thompson, lo convierte en AFD por subconjuntos,
+ *          lo minimiza y escribe un encabezado C++ con dos versiones del mismo autómata:
+ *          una con tabla de transiciones compacta y otra codificada directamente con goto.
+ *
+ *          g++ -std=c++17 -O2 genlex.cpp -o genlex && ./genlex lexico.reglas lexico_afd.h
+ */
+
+#include <algorithm>
+#include <bitset>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+typedef bitset<256> Conjunto;
+
+/// Regla léxica leída del archivo de especificación
+struct Regla
+{
+    /// true si la regla describe un token inválido
+    bool error;
+    /// Tipo del token o nombre del error
+    string nombre;
+    /// A igual longitud gana la regla con menor prioridad
+    int prioridad;
+    string expresion;
+    int linea;
+};
+
+/// Estado del AFN: transiciones vacías y a lo más una transición con un conjunto de bytes
+struct EstadoAFN
+{
+    vector<int> vacias;
+    Conjunto cs;
+    int sig = -1;
+    /// regla que acepta este estado, -1 si no es final
+    int regla = -1;
+};
+
+/// Fragmento de AFN con un estado inicial y uno final
+struct Fragmento
+{
+    int ini, fin;
+};
+
+vector<EstadoAFN> afn;
+
+int nuevoEstado()
+{
+    afn.push_back(EstadoAFN());
+    return afn.size() - 1;
+}
+
+/**
+ * @brief Analizador descendente recursivo de expresiones regulares que construye el AFN:
+ *   alt -> cat ('|' cat)*
+ *   cat -> rep*
+ *   rep -> atomo ('*' | '+' | '?')*
+ *   atomo -> '(' alt ')' | '[' clase ']' | '.' | '\' escape | caracter
+ */
+class Expresion
+{
+    const string &s;
+    size_t i = 0;
+    string error;
+
+    void fallar(const string &msg)
+    {
+        if (error.empty())
+            error = msg + " en la posición " + to_string(i);
+    }
+
+    int escape(char c)
+    {
+        switch (c)
+        {
+        case 'n':
+            return '\n';
+        case 't':
+            return '\t';
+        case 'r':
+            return '\r';
+        case '0':
+            return 0;
+        }
+        return (unsigned char)c;
+    }
+
+    Fragmento conjunto(const Conjunto &cs)
+    {
+        Fragmento f{nuevoEstado(), nuevoEstado()};
+        afn[f.ini].cs = cs;
+        afn[f.ini].sig = f.fin;
+        return f;
+    }
+
+    Fragmento vacio()
+    {
+        Fragmento f{nuevoEstado(), nuevoEstado()};
+        afn[f.ini].vacias.push_back(f.fin);
+        return f;
+    }
+
+    Fragmento clase()
+    {
+        Conjunto cs;
+        bool negada = i < s.size() && s[i] == '^';
+        if (negada)
+            ++i;
+        bool primero = true;
+        while (i < s.size() && (s[i] != ']' || primero))
+        {
+            primero = false;
+            int a = (unsigned char)s[i++];
+            if (a == '\\' && i < s.size())
+                a = escape(s[i++]);
+            int b = a;
+            if (i + 1 < s.size() && s[i] == '-' && s[i + 1] != ']')
+            {
+                ++i;
+                b = (unsigned char)s[i++];
+                if (b == '\\' && i < s.size())
+                    b = escape(s[i++]);
+            }
+            for (int c = a; c <= b; ++c)
+                cs.set(c);
+        }
+        if (i >= s.size())
+            fallar("falta ']'");
+        ++i;
+        return conjunto(negada ? ~cs : cs);
+    }
+
+    Fragmento atomo()
+    {
+        char c = s[i++];
+        if (c == '(')
+        {
+            Fragmento f = alternativa();
+            if (i >= s.size() || s[i] != ')')
+                fallar("falta ')'");
+            ++i;
+            return f;
+        }
+        if (c == '[')
+            return clase();
+        Conjunto cs;
+        if (c == '.')
+        {
+            cs.set();
+            cs.reset('\n');
+        }
+        else if (c == '\\' && i < s.size())
+            cs.set(escape(s[i++]));
+        else
+            cs.set((unsigned char)c);
+        return conjunto(cs);
+    }
+
+    Fragmento repeticion()
+    {
+        Fragmento f = atomo();
+        while (i < s.size() && (s[i] == '*' || s[i] == '+' || s[i] == '?'))
+        {
+            char op = s[i++];
+            Fragmento r{nuevoEstado(), nuevoEstado()};
+            afn[r.ini].vacias.push_back(f.ini);
+            afn[f.fin].vacias.push_back(r.fin);
+            if (op != '+')
+                afn[r.ini].vacias.push_back(r.fin);
+            if (op != '?')
+                afn[f.fin].vacias.push_back(f.ini);
+            f = r;
+        }
+        return f;
+    }
+
+    Fragmento concatenacion()
+    {
+        if (i >= s.size() || s[i] == '|' || s[i] == ')')
+            return vacio();
+        Fragmento f = repeticion();
+        while (i < s.size() && s[i] != '|' && s[i] != ')')
+        {
+            Fragmento g = repeticion();
+            afn[f.fin].vacias.push_back(g.ini);
+            f.fin = g.fin;
+        }
+        return f;
+    }
+
+    Fragmento alternativa()
+    {
+        Fragmento f = concatenacion();
+        while (i < s.size() && s[i] == '|')
+        {
+            ++i;
+            Fragmento g = concatenacion();
+            Fragmento r{nuevoEstado(), nuevoEstado()};
+            afn[r.ini].vacias = {f.ini, g.ini};
+            afn[f.fin].vacias.push_back(r.fin);
+            afn[g.fin].vacias.push_back(r.fin);
+            f = r;
+        }
+        return f;
+    }
+
+public:
+    explicit Expresion(const string &texto) : s(texto) {}
+
+    /// Construye el AFN de la expresión; devuelve false y el mensaje si es inválida
+    bool construir(Fragmento &f, string &msg)
+    {
+        f = alternativa();
+        if (i != s.size())
+            fallar("caracter inesperado '" + string(1, s[i]) + "'");
+        msg = error;
+        return error.empty();
+    }
+};
+
+/// Cerradura vacía de un conjunto de estados del AFN
+vector<int> cerradura(vector<int> estados)
+{
+    vector<bool> visto(afn.size());
+    vector<int> pila = estados;
+    for (int e : estados)
+        visto[e] = true;
+    while (!pila.empty())
+    {
+        int e = pila.back();
+        pila.pop_back();
+        for (int v : afn[e].vacias)
+            if (!visto[v])
+            {
+                visto[v] = true;
+                estados.push_back(v);
+                pila.push_back(v);
+            }
+    }
+    sort(estados.begin(), estados.end());
+    return estados;
+}
+
+/// Autómata determinista: transiciones por clase de bytes y regla aceptada por estado
+struct AFD
+{
+    vector<vector<int>> trans;
+    vector<int> acepta;
+};
+
+/**
+ * @brief Agrupa los 256 bytes en clases de equivalencia: dos bytes quedan en la misma clase
+ * si pertenecen exactamente a los mismos conjuntos del AFN.
+ */
+int clasesBytes(vector<int> &clase, vector<int> &representante)
+{
+    vector<Conjunto> conjuntos;
+    for (const EstadoAFN &e : afn)
+        if (e.sig >= 0)
+            conjuntos.push_back(e.cs);
+
+    map<vector<bool>, int> firmas;
+    clase.assign(256, 0);
+    representante.clear();
+    for (int c = 0; c < 256; ++c)
+    {
+        vector<bool> firma;
+        for (const Conjunto &cs : conjuntos)
+            firma.push_back(cs.test(c));
+        auto it = firmas.find(firma);
+        if (it == firmas.end())
+        {
+            it = firmas.emplace(firma, representante.size()).first;
+            representante.push_back(c);
+        }
+        clase[c] = it->second;
+    }
+    return representante.size();
+}
+
+/// Construcción por subconjuntos; el estado 0 es el inicial y -1 indica que no hay transición
+AFD subconjuntos(int inicio, const vector<int> &representante, const vector<Regla> &reglas)
+{
+    AFD d;
+    map<vector<int>, int> numero;
+    vector<vector<int>> pendientes;
+
+    auto agregar = [&](const vector<int> &est) {
+        auto it = numero.find(est);
+        if (it != numero.end())
+            return it->second;
+        int n = d.trans.size();
+        numero[est] = n;
+        d.trans.push_back(vector<int>(representante.size(), -1));
+        int mejor = -1;
+        for (int e : est)
+        {
+            int r = afn[e].regla;
+            if (r >= 0 && (mejor < 0 || reglas[r].prioridad < reglas[mejor].prioridad ||
+                           (reglas[r].prioridad == reglas[mejor].prioridad && r < mejor)))
+                mejor = r;
+        }
+        d.acepta.push_back(mejor);
+        pendientes.push_back(est);
+        return n;
+    };
+
+    agregar(cerradura({inicio}));
+    for (size_t n = 0; n < pendientes.size(); ++n)
+    {
+        vector<int> est = pendientes[n];
+        for (size_t k = 0; k < representante.size(); ++k)
+        {
+            vector<int> sig;
+            for (int e : est)
+                if (afn[e].sig >= 0 && afn[e].cs.test(representante[k]))
+                    sig.push_back(afn[e].sig);
+            if (!sig.empty())
+            {
+                int t = agregar(cerradura(sig));
+                d.trans[n][k] = t;
+            }
+        }
+    }
+    return d;
+}
+
+/// Elimina los estados desde los que no se llega a ningún estado final
+void podar(AFD &d)
+{
+    int n = d.trans.size();
+    vector<bool> util(n);
+    for (bool cambio = true; cambio;)
+    {
+        cambio = false;
+        for (int e = 0; e < n; ++e)
+        {
+            if (util[e])
+                continue;
+            bool u = d.acepta[e] >= 0;
+            for (int t : d.trans[e])
+                u = u || (t >= 0 && util[t]);
+            if (u)
+                util[e] = cambio = true;
+        }
+    }
+    for (int e = 0; e < n; ++e)
+        for (int &t : d.trans[e])
+            if (t >= 0 && !util[t])
+                t = -1;
+}
+
+/**
+ * @brief Minimización por refinamiento de particiones (Moore): parte de los grupos de estados
+ * que aceptan la misma regla y los divide hasta que todos los estados de un grupo van a los
+ * mismos grupos con cada clase. El grupo del estado inicial queda como estado 0.
+ */
+AFD minimizar(const AFD &d)
+{
+    int n = d.trans.size();
+    vector<int> grupo(n);
+    for (int e = 0; e < n; ++e)
+        grupo[e] = d.acepta[e] + 1;
+
+    int ngrupos = 0;
+    for (;;)
+    {
+        map<vector<int>, int> firmas;
+        vector<int> nuevo(n);
+        for (int e = 0; e < n; ++e)
+        {
+            vector<int> firma{grupo[e]};
+            for (int t : d.trans[e])
+                firma.push_back(t < 0 ? -1 : grupo[t]);
+            auto it = firmas.emplace(firma, firmas.size()).first;
+            nuevo[e] = it->second;
+        }
+        bool estable = (int)firmas.size() == ngrupos;
+        ngrupos = firmas.size();
+        grupo = nuevo;
+        if (estable)
+            break;
+    }
+
+    // se renumeran los grupos en orden de descubrimiento desde el estado inicial
+    vector<int> orden(ngrupos, -1);
+    vector<int> cola{0};
+    orden[grupo[0]] = 0;
+    int siguiente = 1;
+    AFD m;
+    for (size_t k = 0; k < cola.size(); ++k)
+        for (int t : d.trans[cola[k]])
+            if (t >= 0 && orden[grupo[t]] < 0)
+            {
+                orden[grupo[t]] = siguiente++;
+                cola.push_back(t);
+            }
+
+    m.trans.assign(siguiente, vector<int>());
+    m.acepta.assign(siguiente, -1);
+    for (int e : cola)
+    {
+        int g = orden[grupo[e]];
+        m.acepta[g] = d.acepta[e];
+        m.trans[g].clear();
+        for (int t : d.trans[e])
+            m.trans[g].push_back(t < 0 ? -1 : orden[grupo[t]]);
+    }
+    return m;
+}
+
+/// Nombre con el que el código generado se refiere a lo que acepta un estado
+string nombreAcepta(const vector<Regla> &reglas, int r)
+{
+    if (r < 0)
+        return "T_EOF";
+    if (reglas[r].error)
+    {
+        string n = reglas[r].nombre;
+        transform(n.begin(), n.end(), n.begin(), ::toupper);
+        return "E_" + n;
+    }
+    return reglas[r].nombre;
+}
+
+/// Escribe una lista de valores separada por comas con saltos de línea cada 16 elementos
+template <class T>
+void lista(ostream &os, const vector<T> &v, const string &sangria)
+{
+    for (size_t i = 0; i < v.size(); ++i)
+    {
+        if (i % 16 == 0)
+            os << (i ? ",\n" : "") << sangria;
+        else
+            os << ", ";
+        os << v[i];
+    }
+    os << "\n";
+}
+
+void emitir(ostream &os, const string &origen, const vector<Regla> &reglas, const AFD &m,
+            const vector<int> &clase, int nclases)
+{
+    int n = m.trans.size();
+    const char *tipoEstado = n < 128 ? "signed char" : "short";
+
+    os << "/**\n"
+       << " * @file    lexico_afd.h\n"
+       << " * @brief   Autómata del analizador léxico generado por genlex a partir de " << origen << ".\n"
+       << " *          No editar a mano: modificar las reglas y volver a generar.\n"
+       << " *          " << n << " estados, " << nclases << " clases de bytes.\n"
+       << " */\n\n"
+       << "#ifndef LEXICO_AFD_H\n#define LEXICO_AFD_H\n\n";
+
+    // errores
+    vector<string> errores;
+    for (const Regla &r : reglas)
+        if (r.error)
+            errores.push_back(r.nombre);
+    os << "/// Tokens inválidos; se numeran después de los tipos de token válidos\n"
+       << "enum ErrorLexico : unsigned char\n{\n";
+    for (size_t i = 0; i < errores.size(); ++i)
+    {
+        string n = errores[i];
+        transform(n.begin(), n.end(), n.begin(), ::toupper);
+        os << "    E_" << n << (i == 0 ? " = T_NUM" : "") << ",\n";
+    }
+    os << "    E_NUM\n};\n\n";
+    os << "/// Nombre con el que se reporta cada token inválido\n"
+       << "const char nombreError[E_NUM - T_NUM][10] = {";
+    for (size_t i = 0; i < errores.size(); ++i)
+        os << (i ? ", " : "") << "\"" << errores[i] << "\"";
+    os << "};\n\n";
+
+    os << "namespace afd\n{\n\n";
+    os << "/// Clase de equivalencia de cada byte de entrada\n"
+       << "static const unsigned char clase[256] = {\n";
+    lista(os, clase, "    ");
+    os << "};\n\n";
+
+    // tabla con filas fusionadas
+    vector<vector<int>> filas;
+    vector<int> fila(n);
+    for (int e = 0; e < n; ++e)
+    {
+        auto it = find(filas.begin(), filas.end(), m.trans[e]);
+        fila[e] = it - filas.begin();
+        if (it == filas.end())
+            filas.push_back(m.trans[e]);
+    }
+    vector<string> acepta;
+    for (int e = 0; e < n; ++e)
+        acepta.push_back(nombreAcepta(reglas, m.acepta[e]));
+
+    os << "/// Autómata con tabla de transiciones: las filas repetidas se guardan una sola vez\n"
+       << "namespace tabla\n{\n\n"
+       << "/// Filas distintas de la tabla de transiciones (-1: sin transición)\n"
+       << "static const " << tipoEstado << " trans[" << filas.size() << "][" << nclases << "] = {\n";
+    for (size_t f = 0; f < filas.size(); ++f)
+    {
+        os << "    {";
+        for (int c = 0; c < nclases; ++c)
+            os << (c ? ", " : "") << filas[f][c];
+        os << "}" << (f + 1 < filas.size() ? "," : "") << "\n";
+    }
+    os << "};\n\n"
+       << "/// Fila de trans que usa cada estado\n"
+       << "static const unsigned char fila[" << n << "] = {\n";
+    lista(os, fila, "    ");
+    os << "};\n\n"
+       << "/// Tipo aceptado por cada estado (T_EOF si el estado no es final)\n"
+       << "static const unsigned char acepta[" << n << "] = {\n";
+    lista(os, acepta, "    ");
+    os << "};\n\n"
+       << "/**\n"
+       << " * @brief Reconoce el lexema más largo que empieza en p.\n"
+       << " *\n"
+       << " * @param tipo Tipo o error aceptado, T_EOF si ningún prefijo es válido\n"
+       << " * @return Longitud del lexema, 0 si ningún prefijo es válido\n"
+       << " */\n"
+       << "inline unsigned escanear(const char *p, const char *fin, int &tipo)\n{\n"
+       << "    const char *q = p, *ultimo = p;\n"
+       << "    int e = 0;\n"
+       << "    tipo = T_EOF;\n"
+       << "    while (q < fin && (e = trans[fila[e]][clase[(unsigned char)*q]]) >= 0)\n"
+       << "    {\n"
+       << "        ++q;\n"
+       << "        if (acepta[e] != T_EOF)\n"
+       << "        {\n"
+       << "            tipo = acepta[e];\n"
+       << "            ultimo = q;\n"
+       << "        }\n"
+       << "    }\n"
+       << "    return ultimo - p;\n"
+       << "}\n\n"
+       << "} // namespace tabla\n\n";
+
+    // código directo
+    os << "/// Autómata codificado directamente: cada estado es una etiqueta y cada transición un goto\n"
+       << "namespace directo\n{\n\n"
+       << "/**\n"
+       << " * @brief Reconoce el lexema más largo que empieza en p.\n"
+       << " *\n"
+       << " * @param tipo Tipo o error aceptado, T_EOF si ningún prefijo es válido\n"
+       << " * @return Longitud del lexema, 0 si ningún prefijo es válido\n"
+       << " */\n"
+       << "inline unsigned escanear(const char *p, const char *fin, int &tipo)\n{\n"
+       << "    const char *q = p, *ultimo = p;\n"
+       << "    tipo = T_EOF;\n"
+       << "    goto e0;\n";
+    for (int e = 0; e < n; ++e)
+    {
+        os << "e" << e << ":\n";
+        if (m.acepta[e] >= 0)
+            os << "    tipo = " << acepta[e] << ";\n"
+               << "    ultimo = q;\n";
+        map<int, vector<int>> destinos;
+        for (int c = 0; c < nclases; ++c)
+            if (m.trans[e][c] >= 0)
+                destinos[m.trans[e][c]].push_back(c);
+        if (destinos.empty())
+        {
+            os << "    return ultimo - p;\n";
+            continue;
+        }
+        os << "    if (q == fin)\n"
+           << "        return ultimo - p;\n"
+           << "    switch (clase[(unsigned char)*q++])\n"
+           << "    {\n";
+        for (auto &d : destinos)
+        {
+            os << "   ";
+            for (int c : d.second)
+                os << " case " << c << ":";
+            os << "\n        goto e" << d.first << ";\n";
+        }
+        os << "    }\n"
+           << "    return ultimo - p;\n";
+    }
+    os << "}\n\n"
+       << "} // namespace directo\n\n"
+       << "} // namespace afd\n\n"
+       << "#endif\n";
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        cout << "Uso: genlex <reglas> <salida.h>\n";
+        return EXIT_FAILURE;
+    }
+
+    ifstream entrada(argv[1]);
+    if (!entrada)
+    {
+        cout << "Error: no se pudo abrir " << argv[1] << "\n";
+        return EXIT_FAILURE;
+    }
+
+    vector<Regla> reglas;
+    string linea;
+    for (int ln = 1; getline(entrada, linea); ++ln)
+    {
+        size_t k = linea.find_first_not_of(" \t");
+        if (k == string::npos || linea[k] == '#')
+            continue;
+        istringstream is(linea);
+        string clase;
+        Regla r;
+        r.linea = ln;
+        if (!(is >> clase >> r.nombre >> r.prioridad) || (clase != "token" && clase != "error"))
+        {
+            cout << argv[1] << ":" << ln << ": se esperaba 'token|error nombre prioridad expresion'\n";
+            return EXIT_FAILURE;
+        }
+        r.error = clase == "error";
+        getline(is >> ws, r.expresion);
+        while (!r.expresion.empty() && (r.expresion.back() == ' ' || r.expresion.back() == '\r'))
+            r.expresion.pop_back();
+        reglas.push_back(r);
+    }
+
+    // AFN: un estado inicial con transiciones vacías al AFN de cada regla
+    int inicio = nuevoEstado();
+    for (size_t r = 0; r < reglas.size(); ++r)
+    {
+        Fragmento f;
+        string msg;
+        Expresion ex(reglas[r].expresion);
+        if (!ex.construir(f, msg))
+        {
+            cout << argv[1] << ":" << reglas[r].linea << ": " << msg << "\n";
+            return EXIT_FAILURE;
+        }
+        afn[inicio].vacias.push_back(f.ini);
+        afn[f.fin].regla = r;
+    }
+
+    vector<int> clase, representante;
+    int nclases = clasesBytes(clase, representante);
+    AFD d = subconjuntos(inicio, representante, reglas);
+    podar(d);
+    AFD m = minimizar(d);
+
+    // reglas que nunca ganan a otra
+    set<int> usadas(m.acepta.begin(), m.acepta.end());
+    for (size_t r = 0; r < reglas.size(); ++r)
+        if (!usadas.count(r))
+            cerr << argv[1] << ":" << reglas[r].linea << ": aviso: la regla " << reglas[r].nombre << " nunca se acepta\n";
+
+    ofstream salida(argv[2]);
+    if (!salida)
+    {
+        cout << "Error: no se pudo crear " << argv[2] << "\n";
+        return EXIT_FAILURE;
+    }
+    string origen = argv[1];
+    origen = origen.substr(origen.find_last_of('/') + 1);
+    emitir(salida, origen, reglas, m, clase, nclases);
+
+    cerr << "AFN: " << afn.size() << " estados  AFD: " << d.trans.size() << " estados  minimo: "
+         << m.trans.size() << " estados  clases: " << nclases << "\n";
+    return 0;
+}
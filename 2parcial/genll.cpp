@@ -0,0 +1,587 @@
+/**
+ * @file    genll.cpp
+ * @version 1.0
+ * @date    19/10/2026
+ * @brief   Generador del analizador sintáctico LL(1). Lee la gramática (terminales, no terminales
+ *          y producciones), calcula los conjuntos FIRST y FOLLOW, arma la tabla de análisis LL(1)
+ *          y escribe un encabezado C++ con la tabla y un analizador con pila explícita, que no usa
+ *          la pila de llamadas aunque el programa anide miles de paréntesis o bloques.
+ *
+ *          g++ -std=c++17 -O2 genll.cpp -o genll && ./genll sintactico.gramatica sintactico_ll1.h
+ */
+
+#include <algorithm>
+#include <bitset>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/// Conjunto de terminales (por su número)
+typedef bitset<256> Conjunto;
+
+struct Simbolo
+{
+    string nombre;
+    /// Cómo se menciona en los errores
+    string texto;
+    bool terminal;
+    /// Línea donde se declaró o donde aparece por primera vez a la izquierda
+    int linea = 0;
+};
+
+struct Produccion
+{
+    int izq;
+    vector<int> der;
+    int linea;
+};
+
+vector<Simbolo> simbolos;
+map<string, int> porNombre;
+vector<Produccion> producciones;
+
+/// No terminal donde se usa el modo alarma y terminales que se agregan o quitan a su conjunto
+struct Alarma
+{
+    string nombre;
+    vector<string> mas, menos;
+    int linea;
+};
+vector<Alarma> alarmas;
+/// Los terminales son los simbolos [0, nTerminales)
+int nTerminales = 0;
+
+int simbolo(const string &nombre, bool terminal, int linea)
+{
+    auto it = porNombre.find(nombre);
+    if (it != porNombre.end())
+        return it->second;
+    simbolos.push_back(Simbolo{nombre, nombre, terminal, linea});
+    porNombre[nombre] = simbolos.size() - 1;
+    return simbolos.size() - 1;
+}
+
+string mayusculas(string n)
+{
+    transform(n.begin(), n.end(), n.begin(), ::toupper);
+    return n;
+}
+
+/// Nombre del no terminal en el código generado: NT_ y el nombre en mayúsculas
+string nombreEnum(const Simbolo &s)
+{
+    return "NT_" + mayusculas(s.nombre);
+}
+
+/// Escribe una cadena como literal de C++
+string literal(const string &s)
+{
+    string r = "\"";
+    for (char c : s)
+    {
+        if (c == '"' || c == '\\')
+            r += '\\';
+        r += c;
+    }
+    return r + "\"";
+}
+
+/// Escribe una lista de valores separada por comas con saltos de línea cada 16 elementos
+template <class T>
+void lista(ostream &os, const vector<T> &v, const string &sangria)
+{
+    for (size_t i = 0; i < v.size(); ++i)
+    {
+        if (i % 16 == 0)
+            os << (i ? ",\n" : "") << sangria;
+        else
+            os << ", ";
+        os << v[i];
+    }
+    os << "\n";
+}
+
+/**
+ * @brief Lee la gramática. Los terminales se declaran antes de usarse; cualquier otro nombre es
+ * un no terminal y debe tener al menos una producción.
+ */
+bool leer(istream &entrada, const string &archivo)
+{
+    string linea;
+    int izq = -1;
+    for (int ln = 1; getline(entrada, linea); ++ln)
+    {
+        while (!linea.empty() && (linea.back() == ' ' || linea.back() == '\r'))
+            linea.pop_back();
+        size_t k = linea.find_first_not_of(" \t");
+        if (k == string::npos || linea[k] == '#')
+            continue;
+        istringstream is(linea);
+        string primera;
+        is >> primera;
+        if (primera == "alarma")
+        {
+            Alarma a;
+            a.linea = ln;
+            string t;
+            if (!(is >> a.nombre))
+            {
+                cout << archivo << ":" << ln << ": falta el no terminal del modo alarma\n";
+                return false;
+            }
+            while (is >> t)
+            {
+                if (t.size() < 2 || (t[0] != '+' && t[0] != '-'))
+                {
+                    cout << archivo << ":" << ln << ": se esperaba +terminal o -terminal\n";
+                    return false;
+                }
+                (t[0] == '+' ? a.mas : a.menos).push_back(t.substr(1));
+            }
+            alarmas.push_back(a);
+            continue;
+        }
+        if (primera == "terminal" || primera == "noterminal")
+        {
+            string nombre, texto;
+            if (!(is >> nombre))
+            {
+                cout << archivo << ":" << ln << ": falta el nombre del símbolo\n";
+                return false;
+            }
+            getline(is >> ws, texto);
+            bool terminal = primera == "terminal";
+            if (terminal && porNombre.count(nombre))
+            {
+                cout << archivo << ":" << ln << ": " << nombre << " ya estaba declarado\n";
+                return false;
+            }
+            if (terminal && nTerminales != (int)simbolos.size())
+            {
+                cout << archivo << ":" << ln << ": los terminales se declaran antes que todo lo demás\n";
+                return false;
+            }
+            int s = simbolo(nombre, terminal, ln);
+            if (simbolos[s].terminal != terminal)
+            {
+                cout << archivo << ":" << ln << ": " << nombre << " es un terminal\n";
+                return false;
+            }
+            nTerminales += terminal;
+            if (!texto.empty())
+                simbolos[s].texto = texto;
+            continue;
+        }
+
+        if (primera != "|")
+        {
+            string flecha;
+            if (!(is >> flecha) || flecha != "->")
+            {
+                cout << archivo << ":" << ln << ": se esperaba 'nombre -> símbolos'\n";
+                return false;
+            }
+            izq = simbolo(primera, false, ln);
+            if (simbolos[izq].terminal)
+            {
+                cout << archivo << ":" << ln << ": " << primera << " es un terminal\n";
+                return false;
+            }
+            if (!simbolos[izq].linea)
+                simbolos[izq].linea = ln;
+        }
+        else if (izq < 0)
+        {
+            cout << archivo << ":" << ln << ": alternativa sin producción\n";
+            return false;
+        }
+
+        // alternativas separadas por |
+        Produccion p{izq, {}, ln};
+        string s;
+        bool vacia = false;
+        while (is >> s)
+        {
+            if (s == "|")
+            {
+                producciones.push_back(p);
+                p.der.clear();
+                vacia = false;
+            }
+            else if (s == "vacio")
+                vacia = true;
+            else
+                p.der.push_back(simbolo(s, false, 0));
+            if (vacia && !p.der.empty())
+            {
+                cout << archivo << ":" << ln << ": vacio debe ir solo en su alternativa\n";
+                return false;
+            }
+        }
+        producciones.push_back(p);
+    }
+
+    for (size_t s = nTerminales; s < simbolos.size(); ++s)
+        if (none_of(producciones.begin(), producciones.end(), [&](const Produccion &p) { return p.izq == (int)s; }))
+        {
+            cout << archivo << ": " << simbolos[s].nombre << " no es un terminal declarado ni tiene producciones\n";
+            return false;
+        }
+    if (producciones.empty())
+    {
+        cout << archivo << ": la gramática no tiene producciones\n";
+        return false;
+    }
+    return true;
+}
+
+/// FIRST de una secuencia de símbolos; anulable indica si toda la secuencia deriva vacío
+Conjunto primeros(const vector<int> &der, size_t desde, const vector<Conjunto> &first,
+                  const vector<bool> &anulables, bool &anulable)
+{
+    Conjunto c;
+    for (size_t i = desde; i < der.size(); ++i)
+    {
+        int s = der[i];
+        if (s < nTerminales)
+        {
+            c.set(s);
+            anulable = false;
+            return c;
+        }
+        c |= first[s];
+        if (!anulables[s])
+        {
+            anulable = false;
+            return c;
+        }
+    }
+    anulable = true;
+    return c;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        cout << "Uso: genll <gramatica> <salida.h>\n";
+        return EXIT_FAILURE;
+    }
+
+    ifstream entrada(argv[1]);
+    if (!entrada)
+    {
+        cout << "Error: no se pudo abrir " << argv[1] << "\n";
+        return EXIT_FAILURE;
+    }
+    string origen = argv[1];
+    origen = origen.substr(origen.find_last_of('/') + 1);
+    if (!leer(entrada, argv[1]))
+        return EXIT_FAILURE;
+    if (!porNombre.count("T_EOF") || porNombre["T_EOF"] != 0)
+    {
+        cout << argv[1] << ": el primer terminal debe ser T_EOF\n";
+        return EXIT_FAILURE;
+    }
+
+    // anulables, FIRST y FOLLOW por punto fijo
+    size_t n = simbolos.size();
+    vector<bool> anulables(n, false);
+    vector<Conjunto> first(n), follow(n);
+    int inicial = producciones[0].izq;
+    follow[inicial].set(0);
+    for (bool cambio = true; cambio;)
+    {
+        cambio = false;
+        for (const Produccion &p : producciones)
+        {
+            bool anulable;
+            Conjunto c = primeros(p.der, 0, first, anulables, anulable);
+            if ((first[p.izq] | c) != first[p.izq] || (anulable && !anulables[p.izq]))
+            {
+                first[p.izq] |= c;
+                anulables[p.izq] = anulables[p.izq] || anulable;
+                cambio = true;
+            }
+            for (size_t i = 0; i < p.der.size(); ++i)
+            {
+                int s = p.der[i];
+                if (s < nTerminales)
+                    continue;
+                Conjunto f = primeros(p.der, i + 1, first, anulables, anulable);
+                if (anulable)
+                    f |= follow[p.izq];
+                if ((follow[s] | f) != follow[s])
+                {
+                    follow[s] |= f;
+                    cambio = true;
+                }
+            }
+        }
+    }
+
+    // tabla: A con t usa la primera producción de A cuyo FIRST (o FOLLOW, si es anulable) tiene t
+    int nNoTerminales = n - nTerminales;
+    vector<vector<int>> tabla(nNoTerminales, vector<int>(nTerminales, -1));
+    int conflictos = 0;
+    for (size_t k = 0; k < producciones.size(); ++k)
+    {
+        const Produccion &p = producciones[k];
+        bool anulable;
+        Conjunto c = primeros(p.der, 0, first, anulables, anulable);
+        if (anulable)
+            c |= follow[p.izq];
+        for (int t = 0; t < nTerminales; ++t)
+        {
+            if (!c[t])
+                continue;
+            int &e = tabla[p.izq - nTerminales][t];
+            if (e >= 0)
+            {
+                cerr << argv[1] << ":" << p.linea << ": aviso: conflicto LL(1) en " << simbolos[p.izq].nombre
+                     << " con " << simbolos[t].nombre << ", gana la alternativa anterior (línea "
+                     << producciones[e].linea << ")\n";
+                ++conflictos;
+                continue;
+            }
+            e = k;
+        }
+    }
+
+    // un no terminal anulable usa su alternativa vacía con cualquier otro token: el error se
+    // detecta un poco después, en el siguiente terminal, y el mensaje dice qué terminal faltaba
+    for (int a = 0; a < nNoTerminales; ++a)
+    {
+        if (!anulables[nTerminales + a])
+            continue;
+        int vacia = -1;
+        for (size_t k = 0; k < producciones.size() && vacia < 0; ++k)
+        {
+            bool anulable;
+            if (producciones[k].izq == nTerminales + a)
+            {
+                primeros(producciones[k].der, 0, first, anulables, anulable);
+                if (anulable)
+                    vacia = k;
+            }
+        }
+        for (int &e : tabla[a])
+            if (e < 0)
+                e = vacia;
+    }
+
+    // conjuntos de sincronización: FIRST y FOLLOW del no terminal, con los cambios indicados;
+    // el fin de archivo siempre detiene la búsqueda
+    vector<pair<string, Conjunto>> sincronizacion;
+    if (nTerminales > 64)
+    {
+        cout << argv[1] << ": los conjuntos se guardan en 64 bits y hay " << nTerminales << " terminales\n";
+        return EXIT_FAILURE;
+    }
+    for (const Alarma &a : alarmas)
+    {
+        auto it = porNombre.find(a.nombre);
+        if (it == porNombre.end() || it->second < nTerminales)
+        {
+            cout << argv[1] << ":" << a.linea << ": " << a.nombre << " no es un no terminal\n";
+            return EXIT_FAILURE;
+        }
+        Conjunto c = first[it->second] | follow[it->second];
+        c.set(0);
+        for (int signo = 0; signo < 2; ++signo)
+            for (const string &t : signo ? a.menos : a.mas)
+            {
+                auto jt = porNombre.find(t);
+                if (jt == porNombre.end() || jt->second >= nTerminales)
+                {
+                    cout << argv[1] << ":" << a.linea << ": " << t << " no es un terminal\n";
+                    return EXIT_FAILURE;
+                }
+                c.set(jt->second, !signo);
+            }
+        sincronizacion.emplace_back(a.nombre, c);
+    }
+
+    // no terminales sin texto: se mencionan por los terminales con los que pueden empezar
+    for (size_t s = nTerminales; s < n; ++s)
+        if (simbolos[s].texto == simbolos[s].nombre)
+        {
+            string texto;
+            for (int t = 0; t < nTerminales; ++t)
+                if (first[s][t])
+                    texto += (texto.empty() ? "" : " o ") + simbolos[t].texto;
+            simbolos[s].texto = texto;
+        }
+
+    // lado derecho de cada producción al revés, que es el orden en que se apila
+    vector<int> derecho, inicio;
+    for (const Produccion &p : producciones)
+    {
+        inicio.push_back(derecho.size());
+        for (auto it = p.der.rbegin(); it != p.der.rend(); ++it)
+            derecho.push_back(*it);
+    }
+    inicio.push_back(derecho.size());
+    if (n > 256)
+    {
+        cout << argv[1] << ": demasiados símbolos (" << n << ")\n";
+        return EXIT_FAILURE;
+    }
+    const char *tipoProd = producciones.size() < 128 ? "signed char" : "short";
+
+    ofstream os(argv[2]);
+    if (!os)
+    {
+        cout << "Error: no se pudo crear " << argv[2] << "\n";
+        return EXIT_FAILURE;
+    }
+    os << "/**\n"
+       << " * @file    sintactico_ll1.h\n"
+       << " * @brief   Tabla LL(1) del analizador sintáctico generada por genll a partir de " << origen << ".\n"
+       << " *          No editar a mano: modificar la gramática y volver a generar.\n"
+       << " *          " << nNoTerminales << " no terminales, " << producciones.size()
+       << " producciones, conflictos resueltos por orden: " << conflictos << ".\n"
+       << " */\n\n"
+       << "#ifndef SINTACTICO_LL1_H\n#define SINTACTICO_LL1_H\n\n"
+       << "#include <cstdint>\n"
+       << "#include <vector>\n\n"
+       << "namespace ll1\n{\n\n";
+
+    os << "// las columnas de la tabla son los valores de Tipo en el orden en que se declararon\n";
+    for (int t = 0; t < nTerminales; ++t)
+        os << "static_assert(" << simbolos[t].nombre << " == " << t << ", \"terminal fuera de orden en "
+           << origen << "\");\n";
+    os << "static_assert(T_NUM == " << nTerminales << ", \"faltan terminales en " << origen << "\");\n\n";
+
+    os << "/// No terminales; se numeran después de los tipos de token para apilarlos juntos\n"
+       << "enum NoTerminal : unsigned char\n{\n";
+    for (size_t s = nTerminales; s < n; ++s)
+        os << "    " << nombreEnum(simbolos[s]) << (s == (size_t)nTerminales ? " = T_NUM" : "") << ",\n";
+    os << "    NT_NUM\n};\n\n";
+
+    vector<string> textos;
+    for (const Simbolo &s : simbolos)
+        textos.push_back(literal(s.texto));
+    os << "/// Cómo se menciona cada símbolo en los errores (\"se esperaba ...\")\n"
+       << "static const char *const texto[NT_NUM] = {\n";
+    lista(os, textos, "    ");
+    os << "};\n\n";
+
+    auto mascara = [](const Conjunto &c) {
+        ostringstream h;
+        h << "0x" << hex << (c & Conjunto(~0ULL)).to_ullong() << "ULL";
+        return h.str();
+    };
+    vector<string> fs, ws;
+    for (size_t s = nTerminales; s < n; ++s)
+    {
+        fs.push_back(mascara(first[s]));
+        ws.push_back(mascara(follow[s]));
+    }
+    os << "/// FIRST de cada no terminal: el bit t indica el terminal t\n"
+       << "static const uint64_t primeros[NT_NUM - T_NUM] = {\n";
+    lista(os, fs, "    ");
+    os << "};\n\n"
+       << "/// FOLLOW de cada no terminal\n"
+       << "static const uint64_t siguientes[NT_NUM - T_NUM] = {\n";
+    lista(os, ws, "    ");
+    os << "};\n\n";
+    if (!sincronizacion.empty())
+        os << "// Conjuntos de sincronización del modo alarma: tras un error dentro del no terminal se\n"
+           << "// saltan los tokens que no están en su conjunto\n";
+    for (auto &sc : sincronizacion)
+    {
+        string t;
+        for (int k = 0; k < nTerminales; ++k)
+            if (sc.second[k])
+                t += " " + simbolos[k].texto;
+        os << "static const uint64_t SINC_" << mayusculas(sc.first) << " = " << mascara(sc.second)
+           << "; //" << t << "\n";
+    }
+    if (!sincronizacion.empty())
+        os << "\n";
+
+    vector<string> der;
+    for (int s : derecho)
+        der.push_back(s < nTerminales ? simbolos[s].nombre : nombreEnum(simbolos[s]));
+    os << "/// Lado derecho de cada producción, al revés\n"
+       << "static const unsigned char derecho[" << max<size_t>(der.size(), 1) << "] = {\n";
+    lista(os, der, "    ");
+    os << "};\n\n"
+       << "/// La producción p apila derecho[inicio[p]] ... derecho[inicio[p + 1] - 1]\n"
+       << "static const unsigned short inicio[" << inicio.size() << "] = {\n";
+    lista(os, inicio, "    ");
+    os << "};\n\n"
+       << "/// Producción que se aplica a cada no terminal con cada token (-1: error)\n"
+       << "static const " << tipoProd << " tabla[NT_NUM - T_NUM][T_NUM] = {\n";
+    for (int a = 0; a < nNoTerminales; ++a)
+    {
+        os << "    {";
+        for (int t = 0; t < nTerminales; ++t)
+            os << (t ? ", " : "") << tabla[a][t];
+        os << "}" << (a + 1 < nNoTerminales ? "," : "") << " // " << simbolos[nTerminales + a].nombre << "\n";
+    }
+    os << "};\n\n";
+
+    os << "/**\n"
+       << " * @brief Reconoce tk[0..n) con la tabla y una pila explícita.\n"
+       << " *\n"
+       << " * @param pila Pila de símbolos; se reutiliza entre llamadas para no pedir memoria\n"
+       << " * @param pos Índice del token donde se detectó el error\n"
+       << " * @param esperado Símbolo que se esperaba en pos (su texto está en texto[esperado])\n"
+       << " */\n"
+       << "inline bool analizar(const Token *tk, size_t n, std::vector<unsigned char> &pila, size_t &pos,\n"
+       << "                     unsigned char &esperado)\n{\n"
+       << "    // la pila se maneja con un apuntador y solo se revisa su tamaño al apilar\n"
+       << "    if (pila.size() < 256)\n"
+       << "        pila.resize(256);\n"
+       << "    unsigned char *base = pila.data(), *tope = base;\n"
+       << "    *tope++ = T_EOF;\n"
+       << "    *tope++ = " << nombreEnum(simbolos[inicial]) << ";\n"
+       << "    pos = 0;\n"
+       << "    unsigned char t = n ? tk[0].tipo : T_EOF;\n"
+       << "    for (;;)\n"
+       << "    {\n"
+       << "        unsigned char x = *--tope;\n"
+       << "        if (x < T_NUM)\n"
+       << "        {\n"
+       << "            if (x != t)\n"
+       << "            {\n"
+       << "                esperado = x;\n"
+       << "                return false;\n"
+       << "            }\n"
+       << "            if (x == T_EOF)\n"
+       << "                return true;\n"
+       << "            t = ++pos < n ? tk[pos].tipo : T_EOF;\n"
+       << "            continue;\n"
+       << "        }\n"
+       << "        int p = tabla[x - T_NUM][t];\n"
+       << "        if (p < 0)\n"
+       << "        {\n"
+       << "            esperado = x;\n"
+       << "            return false;\n"
+       << "        }\n"
+       << "        const unsigned char *d = derecho + inicio[p], *f = derecho + inicio[p + 1];\n"
+       << "        if (size_t(tope - base) + (f - d) > pila.size())\n"
+       << "        {\n"
+       << "            size_t k = tope - base;\n"
+       << "            pila.resize(pila.size() * 2);\n"
+       << "            base = pila.data();\n"
+       << "            tope = base + k;\n"
+       << "        }\n"
+       << "        while (d < f)\n"
+       << "            *tope++ = *d++;\n"
+       << "    }\n"
+       << "}\n\n"
+       << "} // namespace ll1\n\n"
+       << "#endif\n";
+
+    cerr << "terminales: " << nTerminales << "  no terminales: " << nNoTerminales << "  producciones: "
+         << producciones.size() << "  conflictos: " << conflictos << "\n";
+    return 0;
+}
@@ -0,0 +1,233 @@
+/**
+ * @file    incremental.h
+ * @version 1.0
+ * @date    19/10/2026
+ * @title   Análisis léxico incremental
+ * @brief   Mantiene los tokens de un código fuente que se edita (p. ej. desde un editor) y después
+ *          de cada edición vuelve a analizar solo las líneas afectadas.
+ *
+ *          Los puntos de control son los inicios de línea: ningún token del lenguaje contiene un
+ *          salto de línea y el autómata no tiene transiciones con '\n', así que en cada inicio de
+ *          línea el autómata está en su estado inicial sin importar lo anterior. Una edición se
+ *          vuelve a analizar desde el inicio de su primera línea hasta el primer salto de línea
+ *          posterior al texto insertado; a partir de ahí el texto y el estado son los mismos que
+ *          antes y los tokens viejos se conservan, solo desplazados.
+ *
+ *          Los tokens se guardan en un buffer con hueco: los anteriores al hueco guardan su
+ *          posición desde el inicio del código fuente y los posteriores desde el final, de modo
+ *          que insertar o borrar texto no obliga a actualizar los tokens de todo el resto del
+ *          archivo. Las ediciones cercanas entre sí (como teclear) solo mueven el hueco unos
+ *          cuantos tokens.
+ */
+
+#ifndef INCREMENTAL_H
+#define INCREMENTAL_H
+
+#include "lexico.h"
+#include "lexico.cpp"
+
+/**
+ * @brief Verifica que el autómata generado no tenga transiciones con '\n', que es lo que permite
+ * usar los inicios de línea como puntos de control.
+ */
+inline bool lineasIndependientes()
+{
+    int c = afd::clase[(unsigned char)'\n'];
+    for (unsigned e = 0; e < sizeof afd::tabla::fila; ++e)
+        if (afd::tabla::trans[afd::tabla::fila[e]][c] >= 0)
+            return false;
+    return true;
+}
+
+class LexicoIncremental : public Lexico
+{
+    /// Buffer con hueco de tokens; en [finHueco, size) el campo ini guarda tam - ini
+    vector<Token> tk;
+    size_t hueco = 0, finHueco = 0;
+
+    /// Lleva el hueco a la posición lógica k
+    void moverHueco(size_t k)
+    {
+        while (hueco > k)
+        {
+            Token t = tk[--hueco];
+            t.ini = tam - t.ini;
+            tk[--finHueco] = t;
+        }
+        while (hueco < k)
+        {
+            Token t = tk[finHueco++];
+            t.ini = tam - t.ini;
+            tk[hueco++] = t;
+        }
+    }
+
+    /// Asegura que quepan n tokens en el hueco
+    void reservarHueco(size_t n)
+    {
+        if (finHueco - hueco >= n)
+            return;
+        size_t despues = tk.size() - finHueco;
+        size_t nuevo = max(tk.size() * 2, hueco + n + despues + 1024);
+        vector<Token> v(nuevo);
+        copy(tk.begin(), tk.begin() + hueco, v.begin());
+        copy(tk.begin() + finHueco, tk.end(), v.end() - despues);
+        tk.swap(v);
+        finHueco = tk.size() - despues;
+    }
+
+    /// Posición lógica del primer token que empieza en pos o después
+    size_t buscar(unsigned pos) const
+    {
+        size_t a = 0, b = size();
+        while (a < b)
+        {
+            size_t m = (a + b) / 2;
+            if ((*this)[m].ini < pos)
+                a = m + 1;
+            else
+                b = m;
+        }
+        return a;
+    }
+
+    /// Copia el código fuente a la memoria propia del analizador para poder modificarlo
+    void hacerEditable()
+    {
+        if (!mapeado)
+            return;
+        vector<char> v(fuente, fuente + tam);
+        cerrar();
+        copia.swap(v);
+        tam = copia.size();
+        fuente = copia.data();
+    }
+
+    /// Reemplaza fuente[ini, fin) por nuevo[0, n) moviendo una sola vez el resto del texto
+    void reemplazar(unsigned ini, unsigned fin, const char *nuevo, unsigned n)
+    {
+        hacerEditable();
+        size_t resto = tam - fin;
+        if (n > fin - ini)
+            copia.resize(tam + n - (fin - ini));
+        memmove(copia.data() + ini + n, copia.data() + fin, resto);
+        copia.resize(ini + n + resto);
+        memcpy(copia.data() + ini, nuevo, n);
+        tam = copia.size();
+        fuente = copia.data();
+    }
+
+public:
+    /**
+     * @brief Analiza por completo el código fuente cargado con abrir o cargar; es el punto de
+     * partida de las ediciones.
+     *
+     * @return False si existe algun error en el analisis | True si no hubo ningun error
+     */
+    bool analizar()
+    {
+        tk.clear();
+        bool ok = Lexico::analizar(tk);
+        hueco = finHueco = tk.size();
+        return ok;
+    }
+
+    /**
+     * @brief Reemplaza el texto fuente[ini, fin) por nuevo[0, n) y actualiza los tokens volviendo a
+     * analizar solo las líneas afectadas. Los tokens inválidos de esas líneas se reportan igual
+     * que en analizar.
+     *
+     * @param ini Inicio del texto reemplazado
+     * @param fin Fin del texto reemplazado (ini == fin para insertar)
+     * @param nuevo Texto nuevo
+     * @param n Número de caracteres del texto nuevo (0 para borrar)
+     * @return Número de tokens inválidos en las líneas analizadas de nuevo
+     */
+    int editar(unsigned ini, unsigned fin, const char *nuevo, unsigned n)
+    {
+        if (!lineasIndependientes())
+        {
+            // el autómata dejó de garantizar los puntos de control: se analiza todo
+            reemplazar(ini, fin, nuevo, n);
+            tk.clear();
+            lineas.assign(1, 0);
+            int errores = analizarRango(0, tam, tk, lineas, 0);
+            hueco = finHueco = tk.size();
+            return errores;
+        }
+
+        // línea donde empieza la edición; su inicio es el punto de control
+        unsigned l0 = upper_bound(lineas.begin(), lineas.end(), ini) - lineas.begin() - 1;
+        unsigned r = lineas[l0];
+        // las líneas [l0 + 1, l1) empiezan dentro del texto reemplazado y desaparecen; la línea
+        // l1 empieza después del primer salto de línea posterior a fin, donde termina el análisis
+        unsigned l1 = upper_bound(lineas.begin(), lineas.end(), fin) - lineas.begin();
+
+        // se descartan los tokens viejos de [r, lineas[l1]); el hueco se mueve antes de modificar
+        // el texto porque los tokens que cruzan el hueco se convierten con el tam actual
+        size_t a = buscar(r);
+        size_t b = l1 < lineas.size() ? buscar(lineas[l1]) : size();
+        moverHueco(b);
+        hueco = a;
+
+        long delta = (long)n - (long)(fin - ini);
+        reemplazar(ini, fin, nuevo, n);
+
+        // fin del nuevo análisis: después del primer salto de línea al final del texto insertado
+        const char *nl = (const char *)memchr(fuente + ini + n, '\n', tam - ini - n);
+        unsigned q = nl ? nl - fuente + 1 : tam;
+
+        vector<Token> nuevos;
+        vector<unsigned> lin;
+        int errores = analizarRango(r, q, nuevos, lin, l0 + 1);
+        reservarHueco(nuevos.size());
+        copy(nuevos.begin(), nuevos.end(), tk.begin() + hueco);
+        hueco += nuevos.size();
+
+        // q ya estaba en lineas (es la línea l1 desplazada)
+        if (nl)
+            lin.pop_back();
+        for (size_t l = l1; l < lineas.size(); ++l)
+            lineas[l] += delta;
+        if (lin.size() == l1 - l0 - 1)
+            copy(lin.begin(), lin.end(), lineas.begin() + l0 + 1);
+        else
+        {
+            lineas.erase(lineas.begin() + l0 + 1, lineas.begin() + l1);
+            lineas.insert(lineas.begin() + l0 + 1, lin.begin(), lin.end());
+        }
+        return errores;
+    }
+
+    /// Número de tokens válidos
+    size_t size() const
+    {
+        return tk.size() - (finHueco - hueco);
+    }
+
+    /// Token en la posición lógica i, con su posición desde el inicio del código fuente
+    Token operator[](size_t i) const
+    {
+        if (i < hueco)
+            return tk[i];
+        Token t = tk[i + finHueco - hueco];
+        t.ini = tam - t.ini;
+        return t;
+    }
+
+    /// Copia los tokens en orden al vector vt (para el análisis sintáctico)
+    void tokens(vector<Token> &vt) const
+    {
+        vt.resize(size());
+        for (size_t i = 0; i < vt.size(); ++i)
+            vt[i] = (*this)[i];
+    }
+
+    /// Código fuente actual
+    string_view codigo() const
+    {
+        return string_view(fuente, tam);
+    }
+};
+
+#endif
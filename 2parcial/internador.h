@@ -0,0 +1,248 @@
+/**
+ * @file    internador.h
+ * @version 1.0
+ * @date    19/10/2026
+ * @title   Internado de identificadores y cadenas
+ * @brief   Asigna a cada identificador o cadena distinta un número de símbolo denso y guarda su
+ *          texto una sola vez en una arena. Varios analizadores léxicos pueden internar al mismo
+ *          tiempo: la tabla está dividida en fragmentos con su propio candado y el directorio
+ *          símbolo -> texto se lee sin bloqueo.
+ */
+
+#ifndef INTERNADOR_H
+#define INTERNADOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+/// Símbolo de los tokens que no son identificadores ni cadenas
+#define SIN_SIMBOLO 0xffffffffu
+
+/**
+ * @brief Hash de 64 bits para cadenas cortas: procesa 8 bytes por multiplicación.
+ */
+inline uint64_t hashBytes(const char *p, size_t n)
+{
+    const uint64_t m = 0x9E3779B97F4A7C15ULL;
+    uint64_t h = n * m, w;
+    for (; n >= 8; p += 8, n -= 8)
+    {
+        memcpy(&w, p, 8);
+        h = (h ^ w) * m;
+        h ^= h >> 29;
+    }
+    if (n)
+    {
+        w = 0;
+        memcpy(&w, p, n);
+        h = (h ^ w) * m;
+        h ^= h >> 29;
+    }
+    h *= 0xBF58476D1CE4E5B9ULL;
+    return h ^ (h >> 32);
+}
+
+/**
+ * @brief Arena de bytes: reserva bloques grandes y entrega trozos consecutivos. Todo se libera
+ * junto al destruirla.
+ */
+class Arena
+{
+    std::vector<char *> bloques;
+    char *actual = nullptr;
+    size_t libre = 0;
+
+public:
+    Arena() = default;
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+    ~Arena()
+    {
+        for (char *b : bloques)
+            delete[] b;
+    }
+
+    /// Copia n bytes a la arena y devuelve la copia
+    const char *copiar(const char *p, size_t n)
+    {
+        if (n > libre)
+        {
+            libre = std::max<size_t>(n, 1 << 16);
+            actual = new char[libre];
+            bloques.push_back(actual);
+        }
+        char *r = actual;
+        memcpy(r, p, n);
+        actual += n;
+        libre -= n;
+        return r;
+    }
+};
+
+class Internador
+{
+    /// Texto de un símbolo
+    struct Simbolo
+    {
+        const char *txt;
+        uint32_t lon;
+    };
+
+    /// Fragmento de la tabla: direccionamiento abierto con su candado y su arena
+    struct alignas(64) Fragmento
+    {
+        std::mutex m;
+        /// (32 bits del hash << 32) | (símbolo + 1); 0 es una casilla vacía
+        std::vector<uint64_t> tabla = std::vector<uint64_t>(256);
+        size_t usados = 0;
+        Arena arena;
+    };
+
+    static const int BITS_FRAGMENTOS = 6;
+    static const int BITS_SEG0 = 10;
+    static const int SEGMENTOS = 32 - BITS_SEG0;
+
+    Fragmento fragmentos[1 << BITS_FRAGMENTOS];
+
+    /// Directorio símbolo -> texto; el segmento k tiene 2^(k + BITS_SEG0) entradas
+    std::atomic<Simbolo *> segmentos[SEGMENTOS] = {};
+
+    /// Siguiente símbolo por asignar
+    std::atomic<uint32_t> siguiente{0};
+
+    /// Entrada del directorio de un símbolo; crea su segmento si todavía no existe
+    Simbolo &entrada(uint32_t id, bool crear)
+    {
+        uint64_t x = (uint64_t)id + (1u << BITS_SEG0);
+        int b = 63 - __builtin_clzll(x);
+        int seg = b - BITS_SEG0;
+        Simbolo *s = segmentos[seg].load(std::memory_order_acquire);
+        if (!s && crear)
+        {
+            Simbolo *nuevo = new Simbolo[(size_t)1 << b];
+            if (segmentos[seg].compare_exchange_strong(s, nuevo, std::memory_order_acq_rel))
+                s = nuevo;
+            else
+                delete[] nuevo;
+        }
+        return s[x - ((uint64_t)1 << b)];
+    }
+
+    /// Duplica la tabla de un fragmento; el hash se recalcula a partir del texto
+    void crecer(Fragmento &f)
+    {
+        std::vector<uint64_t> vieja(f.tabla.size() * 2);
+        vieja.swap(f.tabla);
+        size_t mascara = f.tabla.size() - 1;
+        for (uint64_t e : vieja)
+        {
+            if (!e)
+                continue;
+            Simbolo &s = entrada(uint32_t(e) - 1, false);
+            size_t i = hashBytes(s.txt, s.lon) & mascara;
+            while (f.tabla[i])
+                i = (i + 1) & mascara;
+            f.tabla[i] = e;
+        }
+    }
+
+public:
+    Internador() = default;
+    Internador(const Internador &) = delete;
+    Internador &operator=(const Internador &) = delete;
+    ~Internador()
+    {
+        for (auto &s : segmentos)
+            delete[] s.load();
+    }
+
+    /**
+     * @brief Obtiene el símbolo de un texto, asignándole uno nuevo si es la primera vez que aparece.
+     *
+     * @param p Inicio del texto
+     * @param n Número de caracteres
+     * @param h hashBytes(p, n)
+     * @return Número de símbolo, denso a partir de 0
+     */
+    uint32_t internar(const char *p, uint32_t n, uint64_t h)
+    {
+        Fragmento &f = fragmentos[h >> (64 - BITS_FRAGMENTOS)];
+        uint64_t marca = h << 32;
+        std::lock_guard<std::mutex> candado(f.m);
+
+        size_t mascara = f.tabla.size() - 1;
+        size_t i = h & mascara;
+        for (uint64_t e; (e = f.tabla[i]) != 0; i = (i + 1) & mascara)
+        {
+            if ((e & 0xffffffff00000000ULL) != marca)
+                continue;
+            uint32_t id = uint32_t(e) - 1;
+            Simbolo &s = entrada(id, false);
+            if (s.lon == n && memcmp(s.txt, p, n) == 0)
+                return id;
+        }
+
+        uint32_t id = siguiente.fetch_add(1, std::memory_order_relaxed);
+        entrada(id, true) = Simbolo{f.arena.copiar(p, n), n};
+        f.tabla[i] = marca | (id + 1);
+        if (++f.usados * 2 > f.tabla.size())
+            crecer(f);
+        return id;
+    }
+
+    uint32_t internar(const char *p, uint32_t n)
+    {
+        return internar(p, n, hashBytes(p, n));
+    }
+
+    /// Texto de un símbolo ya asignado
+    std::string_view texto(uint32_t id)
+    {
+        Simbolo &s = entrada(id, false);
+        return std::string_view(s.txt, s.lon);
+    }
+
+    /// Número de símbolos asignados
+    uint32_t size() const
+    {
+        return siguiente.load(std::memory_order_acquire);
+    }
+};
+
+/**
+ * @brief Caché de un solo hilo delante de un Internador: recuerda los últimos símbolos por hash
+ * para que los identificadores repetidos no tomen el candado del fragmento.
+ */
+class CacheSimbolos
+{
+    struct Casilla
+    {
+        uint64_t h;
+        uint32_t id;
+    };
+
+    static const int BITS = 12;
+    std::vector<Casilla> casillas = std::vector<Casilla>(1 << BITS, Casilla{0, SIN_SIMBOLO});
+
+public:
+    uint32_t internar(Internador &in, const char *p, uint32_t n)
+    {
+        uint64_t h = hashBytes(p, n);
+        Casilla &c = casillas[h & ((1 << BITS) - 1)];
+        if (c.h == h && c.id != SIN_SIMBOLO)
+        {
+            std::string_view t = in.texto(c.id);
+            if (t.size() == n && memcmp(t.data(), p, n) == 0)
+                return c.id;
+        }
+        c = Casilla{h, in.internar(p, n, h)};
+        return c.id;
+    }
+};
+
+#endif
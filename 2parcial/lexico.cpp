@@ -7,247 +7,505 @@
  * @return EXIT_FAILURE si existe algún error en el análisis y termina la ejecución
  */
 
+#ifndef LEXICO_CPP
+#define LEXICO_CPP
+
 #include "lexico.h"
 
 using namespace std;
 
 struct Token
 {
-    /** Valor del token ej. int, float, ||, &&, etc. */
-    char token[256];
-    /** Tipo del token.  */
-    char type[10];
-    /** Número de línea en el que se encuentra el token. */
-    unsigned int ln;
-    /**
-     * @brief Sobrecarga del operador '=' 
-     *
-     * @param other
-     * @return Token&
-     */
-    Token &operator=(const Token &other)
+    /** Posición del primer caracter del token en el código fuente. */
+    unsigned ini;
+    /** Número de caracteres del token. */
+    unsigned lon;
+    /** Tipo del token ej. T_INT, T_OR, T_ID, etc. */
+    Tipo tipo;
+    /** Símbolo internado de los identificadores y cadenas, SIN_SIMBOLO en los demás tokens. */
+    unsigned sym;
+};
+
+#include "cache_tokens.h"
+#include "anillo.h"
+
+/**
+ * @brief Palabra reservada del lenguaje y el tipo de token que le corresponde.
+ */
+struct PalabraReservada
+{
+    const char *txt;
+    Tipo tipo;
+};
+
+/// Lista de palabras reservadas dentro de nuestro lenguaje; una nueva se agrega aquí y en Tipo
+constexpr PalabraReservada palabrasReservadas[] = {
+    {"else", T_ELSE}, {"float", T_FLOAT}, {"if", T_IF}, {"int", T_INT},
+    {"return", T_RETURN}, {"void", T_VOID}, {"while", T_WHILE}};
+
+/// Número de casillas de la tabla hash de palabras reservadas (potencia de 2)
+#define TAM_PR 16
+
+/// Función hash de una palabra: su longitud, su primer y su último caracter
+constexpr unsigned hashPR(const char *w, unsigned lon)
+{
+    return (lon + (unsigned char)w[0] + (unsigned char)w[lon - 1] * 6) & (TAM_PR - 1);
+}
+
+/// Longitud de una cadena en tiempo de compilación
+constexpr unsigned longitud(const char *w)
+{
+    unsigned n = 0;
+    while (w[n])
+        ++n;
+    return n;
+}
+
+/**
+ * @brief Tabla hash perfecta de palabras reservadas generada en compilación. Cada casilla
+ * guarda la palabra empaquetada en 8 bytes (rellena con ceros) para confirmarla con una sola
+ * comparación de 64 bits.
+ */
+struct TablaPR
+{
+    unsigned long long txt[TAM_PR];
+    Tipo tipo[TAM_PR];
+    /// longitud de la palabra reservada más larga
+    unsigned maxLon;
+    /// true si dos palabras caen en la misma casilla
+    bool colision;
+
+    constexpr TablaPR() : txt(), tipo(), maxLon(0), colision(false)
     {
-        if (this == &other)
-            return *this;
-        strcpy(token, other.token);
-        strcpy(type, other.type);
-        ln = other.ln;
-        return *this;
+        for (const PalabraReservada &p : palabrasReservadas)
+        {
+            unsigned lon = longitud(p.txt);
+            unsigned h = hashPR(p.txt, lon);
+            if (txt[h] != 0 || lon > 8)
+                colision = true;
+            for (unsigned i = 0; i < lon; ++i)
+                txt[h] |= (unsigned long long)(unsigned char)p.txt[i] << (8 * i);
+            tipo[h] = p.tipo;
+            maxLon = lon > maxLon ? lon : maxLon;
+        }
     }
 };
 
+constexpr TablaPR tablaPR{};
+static_assert(!tablaPR.colision, "hashPR no es perfecta para palabrasReservadas: ajustar la función o TAM_PR");
+static_assert(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__, "buscarPR empaqueta las palabras en orden little-endian");
+
+/**
+ * @brief Busca una palabra en la tabla de palabras reservadas.
+ *
+ * @param word Inicio de la palabra por buscar
+ * @param lon Número de caracteres de la palabra
+ * @return Tipo de la palabra reservada | T_ID si la palabra no es reservada
+ */
+inline Tipo buscarPR(const char *word, unsigned lon)
+{
+    if (lon > tablaPR.maxLon)
+        return T_ID;
+    unsigned h = hashPR(word, lon);
+    unsigned long long w = 0;
+    memcpy(&w, word, lon);
+    return tablaPR.txt[h] == w ? tablaPR.tipo[h] : T_ID;
+}
+
+/**
+ * @brief Huella del analizador léxico: cambia si se regenera el autómata, se modifican las palabras
+ * reservadas o cambia la estructura Token, e invalida así las cachés de tokens anteriores.
+ */
+inline uint64_t huellaLexico()
+{
+    uint64_t h = hashBytes((const char *)afd::clase, sizeof afd::clase);
+    h ^= hashBytes((const char *)afd::tabla::trans, sizeof afd::tabla::trans) * 3;
+    h ^= hashBytes((const char *)afd::tabla::fila, sizeof afd::tabla::fila) * 5;
+    h ^= hashBytes((const char *)afd::tabla::acepta, sizeof afd::tabla::acepta) * 7;
+    h ^= hashBytes((const char *)tablaPR.txt, sizeof tablaPR.txt) * 11;
+    return h ^ (sizeof(Token) << 8 | T_NUM);
+}
+
+/// Tamaño de los bloques con que se lee un archivo que no se puede mapear en memoria
+#define BLOQUE_LECTURA (1 << 20)
+
 class Lexico
 {
+protected:
+    /// Código fuente analizado; los tokens guardan posiciones dentro de él
+    const char *fuente = nullptr;
+
+    /// Número de caracteres del código fuente
+    size_t tam = 0;
+
+    /// true si fuente es un archivo mapeado con mmap
+    bool mapeado = false;
+
+    /// Copia del código fuente cuando se lee desde un flujo
+    vector<char> copia;
+
+    /// Posición en fuente donde empieza cada línea
+    vector<unsigned> lineas;
+
+    /// Tabla de símbolos compartida donde se internan identificadores y cadenas (opcional)
+    Internador *internador = nullptr;
+
+    /// Últimos símbolos internados por este analizador
+    unique_ptr<CacheSimbolos> cache;
+
+    /// Flujo donde se reportan los tokens inválidos
+    ostream *salida = &cout;
+
     /**
-     * @brief Tabla de transición de estados que define los estados posibles
-     * para cada caracter del archivo.
+     * @brief Verifica si una palabra es reservada.
+     *
+     * @param word Inicio de la palabra por analizar
+     * @param lon Número de caracteres de la palabra
+     * @return Tipo de la palabra reservada | T_ID si la palabra no es reservada
      */
-    int est[22][16] = {
-        //    0   1   2   3   4   5   6   7   8   9  10  11  12  13  14  15
-        //    D   L   "   +   /   =   <   >   &   |   !   D   .   S   E   C
-        //    I   E       -   *                           E       A   S   A
-        //    G   T                                       L       L   P   R
-        //    I   R                                       I       T   T   A
-        //    T   A                                       M       O   A   C
-        //    O                                           I           B   T
-        {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, e1, 0, 0, e2},            // 0 q0 invalido
-        {1, e3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 13, -1, -1, e2},  // 1 entero
-        {2, 2, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1},   // 2 id
-        {3, 3, 14, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, -1, 3, 3},               // 3 string invalido
-        {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, e2}, // 4 opsr
-        {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, e2}, // 5 opmd
-        {-1, -1, -1, -1, -1, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, e2}, // 6 opeq
-        {-1, -1, -1, -1, -1, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, e2}, // 7 oplt
-        {-1, -1, -1, -1, -1, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, e2}, // 8 opgt
-        {-1, -1, -1, -1, -1, -1, -1, -1, 16, -1, -1, -1, -1, -1, -1, e2}, // 9 opai invalido
-        {-1, -1, -1, -1, -1, -1, -1, -1, -1, 17, -1, -1, -1, -1, -1, e2}, // 10 opoi invalido
-        {-1, -1, -1, -1, -1, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, e2}, // 11 opnot
-        {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, e2}, // 12 del
-        {18, e3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, e2}, // 13 reali invalido
-        {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, e2}, // 14 stringv
-        {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, e2}, // 15 oprel
-        {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, e2}, // 16 opav
-        {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, e2}, // 17 opov
-        {18, e3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, e2}, // 18 realv
-        {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, e2}, // e1 puntoi invalido
-        {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, e2}, // e2 caracteri invalido
-        {e3, e3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, e2}  // e3 numeroi invalido
-    };
-
-    /// Lista de palabras reservadas dentro de nuestro lenguaje
-    char pr[7][10] = {"else", "float", "if", "int", "return", "void", "while"};
-
-    /// Lista de tipos de estados posibles
-    char estados[22][10] = {
-        "q0", "entero", "id", "stringi",
-        "opsr", "opmd", "opeq", "oplt",
-        "opgt", "opai", "opoi", "opnot",
-        "del", "reali", "stringv", "oprel",
-        "opav", "opov", "realv", "puntoi",
-        "caracteri", "numeroi"};
-
-    /// lista de estados válidos y no válidos
-    char valid[22] = {0, 1, 1, 0, 1, 1, 1, 1, 1, 0, 0, 1, 1, 0, 1, 1, 1, 1, 1, 0, 0, 0};
-
-    bool isRW(char *word)
-    {
-        for (int i = 0; i < 7; ++i)
-            if (strcmp(word, pr[i]) == 0)
-                return true;
-        return false;
+    Tipo isRW(const char *word, unsigned lon)
+    {
+        return buscarPR(word, lon);
     }
 
-public:
+    /// Libera el código fuente anterior
+    void cerrar()
+    {
+        if (mapeado)
+            munmap((void *)fuente, tam);
+        mapeado = false;
+        copia.clear();
+        fuente = nullptr;
+        tam = 0;
+    }
 
-    bool analizar(fstream &file, vector<Token> &vt)
+    /**
+     *  @brief Reconoce los tokens de fuente[p, fin): descarta espacios y saltos de línea, y en cada
+     *  posición reconoce con el autómata generado (lexico_afd.h) el token más largo. Ningún token
+     *  cruza un salto de línea, así que cualquier inicio de línea sirve para empezar.
+     *
+     *  @param p Posición donde empieza el análisis (inicio de una línea)
+     *  @param fin Posición donde termina el análisis
+     *  @param vt Destino de los tokens: un vector o un AnilloTokens
+     *  @param lin Vector donde se agrega el inicio de cada línea nueva
+     *  @param base Número de líneas anteriores a p que no están en lin, para reportar los errores
+     *  @return Número de tokens inválidos
+     */
+    template <class Destino>
+    int analizarRango(unsigned p, unsigned fin, Destino &vt, vector<unsigned> &lin, unsigned base)
     {
         // conteo de errores
         int errCount = 0;
-        // iterador del archivo a leer
-        std::istreambuf_iterator<char> i(file), e;
-        // columna
-        int col;
-        // estado actual
-        int ea = 0;
-        // estado previo
-        int ep = -1;
-        // cursor en buffer
-        int n = 0;
-        // numero de linea
-        int ln = 1;
-        // caracter individual
-        char s;
-        // arreglo de caracteres del buffer
-        char buffer[256];
-
-        /// se establece el buffer con carace vacios
-        memset(buffer, '\0', 256);
-
-        /// mientras existan caracteres en el archivo...
-        while (i != e)
-        {
-            s = *i;
+        // inicio y fin del código fuente
+        const char *b = fuente, *f = b + tam;
+        // longitud del token reconocido
+        unsigned lon;
+        // tipo o error aceptado por el autómata
+        int tipo;
 
-            if (s >= '0' && s <= '9')
-            {
-                col = 0;
-            }
-            else if ((s >= 'a' && s <= 'z') || (s >= 'A' && s <= 'Z'))
-            {
-                col = 1;
-            }
-            else if (s == '\"')
-            {
-                if (ea == 3 && buffer[n - 1] == '\\')
-                    col = 15;
-                else
-                    col = 2;
-            }
-            else if (s == '+' || s == '-')
-            {
-                col = 3;
-            }
-            else if (s == '*' || s == '/')
-            {
-                col = 4;
-            }
-            else if (s == '=')
-            {
-                col = 5;
-            }
-            else if (s == '<')
-            {
-                col = 6;
-            }
-            else if (s == '>')
-            {
-                col = 7;
-            }
-            else if (s == '&')
-            {
-                col = 8;
-            }
-            else if (s == '|')
+        /// mientras existan caracteres en el rango...
+        while (p < fin)
+        {
+            if (b[p] == ' ' || b[p] == '\t')
             {
-                col = 9;
+                ++p;
+                continue;
             }
-            else if (s == '!')
+            if (b[p] == '\n')
             {
-                col = 10;
+                lin.push_back(++p);
+                continue;
             }
-            else if (s == '{' || s == '}' || s == '(' || s == ')' || s == ',' || s == ';')
+
+            lon = afd::LEXICO_AFD::escanear(b + p, f, tipo);
+            if (lon == 0)
             {
-                col = 11;
+                lon = 1;
+                tipo = E_CARACTERI;
             }
-            else if (s == '.')
+
+            if (tipo >= T_NUM)
             {
-                col = 12;
+                *salida << base + lin.size() << " : " << string_view(b + p, lon) << " : " << nombreError[tipo - T_NUM] << "\n";
+                errCount++;
             }
-            else if (s == '\n')
+            else
             {
-                col = 13;
+                Tipo t = tipo == T_ID ? isRW(b + p, lon) : Tipo(tipo);
+                unsigned sym = SIN_SIMBOLO;
+                if (internador && (t == T_ID || t == T_CADENA))
+                    sym = cache->internar(*internador, b + p, lon);
+                vt.push_back(Token{p, lon, t, sym});
             }
-            else if (s == '\t' || s == ' ')
+            p += lon;
+        }
+        return errCount;
+    }
+
+public:
+    Lexico() = default;
+    Lexico(const Lexico &) = delete;
+    Lexico &operator=(const Lexico &) = delete;
+    ~Lexico() { cerrar(); }
+
+    /**
+     * @brief Indica dónde internar los identificadores y cadenas; sin internador los tokens
+     * quedan con SIN_SIMBOLO. Un mismo internador se puede compartir entre analizadores de
+     * distintos hilos.
+     */
+    void usarInternador(Internador *in)
+    {
+        internador = in;
+        if (in && !cache)
+            cache.reset(new CacheSimbolos());
+    }
+
+    /// Indica dónde reportar los tokens inválidos (por omisión cout)
+    void usarSalida(ostream &s)
+    {
+        salida = &s;
+    }
+
+    /**
+     * @brief Mapea en memoria el archivo por analizar; los tokens apuntarán directamente a sus
+     * páginas, sin copiarlo.
+     *
+     * @param ruta Ruta del archivo
+     * @return false si el archivo no se puede abrir o supera 4 GB | true en otro caso
+     */
+    bool abrir(const char *ruta)
+    {
+        TRAZA("Lexico::abrir");
+        cerrar();
+        int fd = open(ruta, O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || (unsigned long long)st.st_size > 0xffffffffULL)
+        {
+            close(fd);
+            return false;
+        }
+        if (S_ISREG(st.st_mode))
+        {
+            tam = st.st_size;
+            void *m = tam > 0 ? mmap(nullptr, tam, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+            if (m != MAP_FAILED)
             {
-                col = 14;
+                madvise(m, tam, MADV_SEQUENTIAL);
+                fuente = (const char *)m;
+                mapeado = true;
             }
-            else
+            if (mapeado || tam == 0)
             {
-                col = 15;
+                close(fd);
+                return true;
             }
+        }
 
-            ep = ea;
-            ea = est[ep][col];
+        // no se puede mapear (p. ej. una tubería): se lee por bloques
+        ssize_t n = 1;
+        tam = 0;
+        while (n > 0)
+        {
+            copia.resize(tam + BLOQUE_LECTURA);
+            n = read(fd, copia.data() + tam, BLOQUE_LECTURA);
+            tam += n > 0 ? n : 0;
+        }
+        copia.resize(tam);
+        fuente = copia.data();
+        close(fd);
+        return n == 0;
+    }
 
-            if (ea == -1)
-            {
-                Token t;
-                strcpy(t.token, buffer);
-                strcpy(t.type, estados[ep]);
-                t.ln = ln;
-
-                if (ep == 2)
-                {
-                    if (isRW(buffer))
-                        strcpy(t.type, "pr");
-                }
-
-                if (!valid[ep])
-                {
-                    std::cout << t.ln << " : " << t.token << " : " << t.type << "\n";
-                    errCount++;
-                }
-                else
-                {
-                    vt.push_back(t);
-                }
-
-                ep = -1;
-                ea = 0;
-                n = 0;
-                memset(buffer, '\0', 256);
-            }
-            else
+    /**
+     * @brief Lee el archivo por analizar desde un flujo en bloques de BLOQUE_LECTURA bytes.
+     *
+     * @param file Archivo por analizar
+     */
+    void cargar(istream &file)
+    {
+        TRAZA("Lexico::cargar");
+        cerrar();
+        for (streamsize n = 1; n > 0;)
+        {
+            copia.resize(tam + BLOQUE_LECTURA);
+            n = file.rdbuf()->sgetn(copia.data() + tam, BLOQUE_LECTURA);
+            tam += n;
+        }
+        copia.resize(tam);
+        fuente = copia.data();
+    }
+
+    /**
+     *  @brief Se encarga de analizar el archivo: descarta espacios y saltos de línea, y en cada posición
+     *  reconoce con el autómata generado (lexico_afd.h) el token más largo
+     *
+     *  @param file Archivo por analizar
+     *  @param vt Vector de tipo Token para almacenar los tokens generados
+     *  @return False si existe algun error en el analisis | True si no hubo ningun error
+     */
+    bool analizar(fstream &file, vector<Token> &vt)
+    {
+        cargar(file);
+        return analizar(vt);
+    }
+
+    /**
+     *  @brief Analiza el código fuente cargado con abrir o cargar.
+     *
+     *  @param vt Vector de tipo Token para almacenar los tokens generados
+     *  @return False si existe algun error en el analisis | True si no hubo ningun error
+     */
+    bool analizar(vector<Token> &vt)
+    {
+        TRAZA("Lexico::analizar");
+        CONTAR_EN(medicion, "Lexico::analizar");
+        lineas.assign(1, 0);
+        size_t antes = vt.size();
+        // cota estimada de tokens para no copiar el vector al crecer (sus páginas sin usar no se tocan)
+        vt.reserve(vt.size() + tam / 4);
+        int errores = analizarRango(0, tam, vt, lineas, 0);
+        CONTAR_UNIDADES(medicion, vt.size() - antes);
+        return errores == 0;
+    }
+
+    /**
+     *  @brief Analiza el código fuente cargado enviando cada token al anillo conforme se reconoce,
+     *  para que otro hilo los vaya consumiendo; al terminar cierra el anillo. Las líneas quedan
+     *  completas hasta que el anillo se cierra.
+     *
+     *  @param anillo Anillo del que lee el consumidor
+     *  @return False si existe algun error en el analisis | True si no hubo ningun error
+     */
+    bool analizar(AnilloTokens &anillo)
+    {
+        TRAZA("Lexico::analizar");
+        CONTAR("Lexico::analizar (anillo)");
+        lineas.assign(1, 0);
+        int errores = analizarRango(0, tam, anillo, lineas, 0);
+        anillo.cerrar();
+        return errores == 0;
+    }
+
+    /**
+     * @brief Usa los tokens de un archivo de caché si fue generado a partir del mismo código
+     * fuente (el abierto con abrir o cargar) y con el mismo analizador léxico. Los tokens se
+     * leen directamente de las páginas mapeadas; solo si hay internador se copian para
+     * renumerar sus símbolos locales a los del internador.
+     *
+     * @param ruta Ruta del archivo de caché
+     * @param c Caché abierta; en un fallo conserva la cabecera anterior para sus estadísticas
+     * @return true si la caché corresponde al código fuente | false si hay que analizarlo
+     */
+    bool leerCache(const char *ruta, CacheTokens &c)
+    {
+        TRAZA("Lexico::leerCache");
+        if (!c.abrir(ruta))
+            return false;
+        const CabeceraCache &h = c.cab;
+        if (h.huella != huellaLexico() || h.tamFuente != tam || h.conSimbolos != (internador != nullptr) ||
+            h.hash != hashBytes(fuente, tam) || !c.coherente())
+        {
+            c.cerrar();
+            return false;
+        }
+
+        lineas.assign(c.lineas, c.lineas + h.nLineas);
+        if (internador)
+        {
+            vector<unsigned> global(h.nSimbolos);
+            for (unsigned i = 0; i < h.nSimbolos; ++i)
             {
-                if (ea == 0 && (s == '\t' || s == ' '))
-                {
-                    ++i;
-                }
-                else if (s == '\n')
-                {
-                    ++i;
-                    ++ln;
-                }
-                else
-                {
-                    buffer[n] = s;
-                    ++n;
-                    ++i;
-                }
+                string_view txt = texto(c.tokens[c.simbolos[i]]);
+                global[i] = cache->internar(*internador, txt.data(), txt.size());
             }
+            for (Token &t : c.copiarTokens())
+                if (t.sym != SIN_SIMBOLO)
+                    t.sym = global[t.sym];
+        }
+
+        // registra el acierto en el propio archivo
+        int fd = open(ruta, O_WRONLY);
+        if (fd >= 0)
+        {
+            uint32_t aciertos = h.aciertos + 1;
+            if (pwrite(fd, &aciertos, sizeof aciertos, offsetof(CabeceraCache, aciertos)) == sizeof aciertos)
+                c.cab.aciertos = aciertos;
+            close(fd);
         }
-        return errCount == 0 ? true : false;
+        return true;
     }
-};
 
+    /**
+     * @brief Guarda los tokens del código fuente actual en un archivo de caché. Los símbolos del
+     * internador se renumeran a índices locales al archivo, porque los del internador solo valen
+     * dentro de este proceso.
+     *
+     * @param ruta Ruta del archivo de caché
+     * @param vt Tokens generados por analizar
+     * @param segAnalisis Segundos que tardó analizar, para reportar el ahorro en los aciertos
+     * @param anterior Caché leída antes (aunque no haya correspondido), de la que se toman las estadísticas
+     * @return false si no se pudo escribir | true en otro caso
+     */
+    bool escribirCache(const char *ruta, const vector<Token> &vt, double segAnalisis, const CacheTokens &anterior) const
+    {
+        CabeceraCache h = {};
+        memcpy(h.magia, "TOKC", 4);
+        h.version = VERSION_CACHE;
+        h.huella = huellaLexico();
+        h.hash = hashBytes(fuente, tam);
+        h.tamFuente = tam;
+        h.nTokens = vt.size();
+        h.nLineas = lineas.size();
+        h.conSimbolos = internador != nullptr;
+        h.nsAnalisis = segAnalisis * 1e9;
+        h.aciertos = anterior.cab.aciertos;
+        h.fallos = anterior.cab.fallos + 1;
+
+        if (!internador)
+            return escribirCacheTokens(ruta, h, vt.data(), lineas.data(), nullptr);
+
+        vector<Token> locales(vt);
+        vector<unsigned> simbolos;
+        unordered_map<unsigned, unsigned> local;
+        for (size_t i = 0; i < locales.size(); ++i)
+        {
+            Token &t = locales[i];
+            if (t.sym == SIN_SIMBOLO)
+                continue;
+            auto r = local.emplace(t.sym, simbolos.size());
+            if (r.second)
+                simbolos.push_back(i);
+            t.sym = r.first->second;
+        }
+        h.nSimbolos = simbolos.size();
+        return escribirCacheTokens(ruta, h, locales.data(), lineas.data(), simbolos.data());
+    }
+
+    /// Texto del token dentro del código fuente
+    string_view texto(const Token &t) const
+    {
+        return string_view(fuente + t.ini, t.lon);
+    }
+
+    /// Número de línea en el que se encuentra el token
+    unsigned linea(const Token &t) const
+    {
+        return upper_bound(lineas.begin(), lineas.end(), t.ini) - lineas.begin();
+    }
+
+    /**
+     * @brief Obtiene el valor numérico de un token entero o realv sin copiar su texto.
+     *
+     * @param t Token por convertir
+     * @param v Valor convertido
+     * @return true si el token es un literal numérico válido | false en otro caso
+     */
+    bool numero(const Token &t, double &v) const
+    {
+        return aReal(fuente + t.ini, fuente + t.ini + t.lon, v);
+    }
+};
 
+#endif
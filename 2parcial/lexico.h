@@ -9,22 +9,69 @@
  *
  */
 
+#ifndef LEXICO_H
+#define LEXICO_H
+
 #include <fstream>
 #include <iostream>
 #include <vector>
 #include <cstring>
-
-#define e1 19 // puntoi invalido
-#define e2 20 // caracteri invalido
-#define e3 21 // numeroi invalido
+#include <string_view>
+#include <algorithm>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <memory>
+#include <unordered_map>
+#include <cstddef>
+#include "real.h"
+#include "internador.h"
+#include "../comun/traza.h"
+#include "../comun/contadores.h"
 
 using namespace std;
 
+/**
+ * @brief Tipo de token. Cada operador y delimitador tiene su propio tipo para que el
+ * análisis sintáctico compare enteros en lugar de cadenas.
+ */
+enum Tipo : unsigned char
+{
+    T_EOF,
+    // literales e identificadores
+    T_ENTERO, T_REAL, T_ID, T_CADENA,
+    // palabras reservadas
+    T_ELSE, T_FLOAT, T_IF, T_INT, T_RETURN, T_VOID, T_WHILE,
+    // operadores
+    T_MAS, T_MENOS, T_POR, T_ENTRE, T_ASIG, T_MENOR, T_MAYOR, T_NOT,
+    T_IGUAL, T_DIST, T_MENORIG, T_MAYORIG, T_AND, T_OR,
+    // delimitadores
+    T_LLAVEA, T_LLAVEC, T_PARA, T_PARC, T_COMA, T_PYC,
+    T_NUM
+};
+
+/// Nombre con el que se muestra cada tipo de token (el estado del autómata que lo acepta)
+const char nombreTipo[T_NUM][8] = {
+    "eof",
+    "entero", "realv", "id", "stringv",
+    "pr", "pr", "pr", "pr", "pr", "pr", "pr",
+    "opsr", "opsr", "opmd", "opmd", "opeq", "oplt", "opgt", "opnot",
+    "oprel", "oprel", "oprel", "oprel", "opav", "opov",
+    "del", "del", "del", "del", "del", "del"};
+
 /**
  * @brief Estructura que define cada token en el archivo analizado.
  */
 struct Token;
 
+#include "lexico_afd.h"
+
+/// Versión del autómata generado que usa Lexico: directo (goto) o tabla
+#ifndef LEXICO_AFD
+#define LEXICO_AFD directo
+#endif
+
 /**
  * @brief Clase que contiene tabla de transiciones de estados, palabras reservadas,
  * estados válidos y obtención de columnas.
@@ -63,3 +110,5 @@ struct Token;
 //      */
 //     bool analizar(fstream &file, vector<Token> &vt);
 // };
+
+#endif
@@ -0,0 +1,565 @@
+/**
+ * @file    lexico_afd.h
+ * @brief   Autómata del analizador léxico generado por genlex a partir de lexico.reglas.
+ *          No editar a mano: modificar las reglas y volver a generar.
+ *          33 estados, 24 clases de bytes.
+ */
+
+#ifndef LEXICO_AFD_H
+#define LEXICO_AFD_H
+
+/// Tokens inválidos; se numeran después de los tipos de token válidos
+enum ErrorLexico : unsigned char
+{
+    E_REALI = T_NUM,
+    E_PUNTOI,
+    E_OPAI,
+    E_OPOI,
+    E_STRINGI,
+    E_NUMEROI,
+    E_CARACTERI,
+    E_NUM
+};
+
+/// Nombre con el que se reporta cada token inválido
+const char nombreError[E_NUM - T_NUM][10] = {"reali", "puntoi", "opai", "opoi", "stringi", "numeroi", "caracteri"};
+
+namespace afd
+{
+
+/// Clase de equivalencia de cada byte de entrada
+static const unsigned char clase[256] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 3, 4, 0, 0, 0, 5, 0, 6, 7, 8, 9, 10, 11, 12, 13,
+    14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 0, 15, 16, 17, 18, 0,
+    0, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 0, 20, 0, 0, 0,
+    0, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19,
+    19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 19, 21, 22, 23, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0
+};
+
+/// Autómata con tabla de transiciones: las filas repetidas se guardan una sola vez
+namespace tabla
+{
+
+/// Filas distintas de la tabla de transiciones (-1: sin transición)
+static const signed char trans[14][24] = {
+    {1, -1, -1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 1, 19, 20, 21},
+    {1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, -1, -1, -1},
+    {1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 22, -1, -1, 1, -1, -1, -1},
+    {3, 3, -1, 3, 23, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 24, 3, 3, 3},
+    {1, -1, -1, -1, -1, 25, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, -1, -1, -1},
+    {1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 26, -1, 13, -1, -1, -1, -1, 27, 1, -1, -1, -1},
+    {1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 28, -1, -1, 1, -1, -1, -1},
+    {1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 29, -1, -1, 1, -1, -1, -1},
+    {1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 30, -1, -1, 1, -1, -1, -1},
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 18, -1, -1, -1, -1, 18, -1, -1, -1, -1},
+    {1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, -1, 31, -1},
+    {3, 3, -1, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3, 3},
+    {1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 32, -1, -1, -1, -1, 27, 1, -1, -1, -1},
+    {1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 27, -1, -1, -1, -1, 27, 1, -1, -1, -1}
+};
+
+/// Fila de trans que usa cada estado
+static const unsigned char fila[33] = {
+    0, 1, 2, 3, 4, 1, 1, 1, 1, 1, 1, 1, 1, 5, 1, 6,
+    7, 8, 9, 1, 10, 1, 1, 1, 11, 1, 12, 13, 1, 1, 1, 1,
+    12
+};
+
+/// Tipo aceptado por cada estado (T_EOF si el estado no es final)
+static const unsigned char acepta[33] = {
+    T_EOF, E_CARACTERI, T_NOT, E_STRINGI, E_OPAI, T_PARA, T_PARC, T_POR, T_MAS, T_COMA, T_MENOS, E_PUNTOI, T_ENTRE, T_ENTERO, T_PYC, T_MENOR,
+    T_ASIG, T_MAYOR, T_ID, T_LLAVEA, E_OPOI, T_LLAVEC, T_DIST, T_CADENA, E_STRINGI, T_AND, E_REALI, E_NUMEROI, T_MENORIG, T_IGUAL, T_MAYORIG, T_OR,
+    T_REAL
+};
+
+/**
+ * @brief Reconoce el lexema más largo que empieza en p.
+ *
+ * @param tipo Tipo o error aceptado, T_EOF si ningún prefijo es válido
+ * @return Longitud del lexema, 0 si ningún prefijo es válido
+ */
+inline unsigned escanear(const char *p, const char *fin, int &tipo)
+{
+    const char *q = p, *ultimo = p;
+    int e = 0;
+    tipo = T_EOF;
+    while (q < fin && (e = trans[fila[e]][clase[(unsigned char)*q]]) >= 0)
+    {
+        ++q;
+        if (acepta[e] != T_EOF)
+        {
+            tipo = acepta[e];
+            ultimo = q;
+        }
+    }
+    return ultimo - p;
+}
+
+} // namespace tabla
+
+/// Autómata codificado directamente: cada estado es una etiqueta y cada transición un goto
+namespace directo
+{
+
+/**
+ * @brief Reconoce el lexema más largo que empieza en p.
+ *
+ * @param tipo Tipo o error aceptado, T_EOF si ningún prefijo es válido
+ * @return Longitud del lexema, 0 si ningún prefijo es válido
+ */
+inline unsigned escanear(const char *p, const char *fin, int &tipo)
+{
+    const char *q = p, *ultimo = p;
+    tipo = T_EOF;
+    goto e0;
+e0:
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    case 3:
+        goto e2;
+    case 4:
+        goto e3;
+    case 5:
+        goto e4;
+    case 6:
+        goto e5;
+    case 7:
+        goto e6;
+    case 8:
+        goto e7;
+    case 9:
+        goto e8;
+    case 10:
+        goto e9;
+    case 11:
+        goto e10;
+    case 12:
+        goto e11;
+    case 13:
+        goto e12;
+    case 14:
+        goto e13;
+    case 15:
+        goto e14;
+    case 16:
+        goto e15;
+    case 17:
+        goto e16;
+    case 18:
+        goto e17;
+    case 19:
+        goto e18;
+    case 21:
+        goto e19;
+    case 22:
+        goto e20;
+    case 23:
+        goto e21;
+    }
+    return ultimo - p;
+e1:
+    tipo = E_CARACTERI;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    }
+    return ultimo - p;
+e2:
+    tipo = T_NOT;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    case 17:
+        goto e22;
+    }
+    return ultimo - p;
+e3:
+    tipo = E_STRINGI;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 1: case 3: case 5: case 6: case 7: case 8: case 9: case 10: case 11: case 12: case 13: case 14: case 15: case 16: case 17: case 18: case 19: case 21: case 22: case 23:
+        goto e3;
+    case 4:
+        goto e23;
+    case 20:
+        goto e24;
+    }
+    return ultimo - p;
+e4:
+    tipo = E_OPAI;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    case 5:
+        goto e25;
+    }
+    return ultimo - p;
+e5:
+    tipo = T_PARA;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    }
+    return ultimo - p;
+e6:
+    tipo = T_PARC;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    }
+    return ultimo - p;
+e7:
+    tipo = T_POR;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    }
+    return ultimo - p;
+e8:
+    tipo = T_MAS;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    }
+    return ultimo - p;
+e9:
+    tipo = T_COMA;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    }
+    return ultimo - p;
+e10:
+    tipo = T_MENOS;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    }
+    return ultimo - p;
+e11:
+    tipo = E_PUNTOI;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    }
+    return ultimo - p;
+e12:
+    tipo = T_ENTRE;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    }
+    return ultimo - p;
+e13:
+    tipo = T_ENTERO;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    case 14:
+        goto e13;
+    case 12:
+        goto e26;
+    case 19:
+        goto e27;
+    }
+    return ultimo - p;
+e14:
+    tipo = T_PYC;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    }
+    return ultimo - p;
+e15:
+    tipo = T_MENOR;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    case 17:
+        goto e28;
+    }
+    return ultimo - p;
+e16:
+    tipo = T_ASIG;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    case 17:
+        goto e29;
+    }
+    return ultimo - p;
+e17:
+    tipo = T_MAYOR;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    case 17:
+        goto e30;
+    }
+    return ultimo - p;
+e18:
+    tipo = T_ID;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 14: case 19:
+        goto e18;
+    }
+    return ultimo - p;
+e19:
+    tipo = T_LLAVEA;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    }
+    return ultimo - p;
+e20:
+    tipo = E_OPOI;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    case 22:
+        goto e31;
+    }
+    return ultimo - p;
+e21:
+    tipo = T_LLAVEC;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    }
+    return ultimo - p;
+e22:
+    tipo = T_DIST;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    }
+    return ultimo - p;
+e23:
+    tipo = T_CADENA;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    }
+    return ultimo - p;
+e24:
+    tipo = E_STRINGI;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 1: case 3: case 4: case 5: case 6: case 7: case 8: case 9: case 10: case 11: case 12: case 13: case 14: case 15: case 16: case 17: case 18: case 19: case 20: case 21: case 22: case 23:
+        goto e3;
+    }
+    return ultimo - p;
+e25:
+    tipo = T_AND;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    }
+    return ultimo - p;
+e26:
+    tipo = E_REALI;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    case 19:
+        goto e27;
+    case 14:
+        goto e32;
+    }
+    return ultimo - p;
+e27:
+    tipo = E_NUMEROI;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    case 14: case 19:
+        goto e27;
+    }
+    return ultimo - p;
+e28:
+    tipo = T_MENORIG;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    }
+    return ultimo - p;
+e29:
+    tipo = T_IGUAL;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    }
+    return ultimo - p;
+e30:
+    tipo = T_MAYORIG;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    }
+    return ultimo - p;
+e31:
+    tipo = T_OR;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    }
+    return ultimo - p;
+e32:
+    tipo = T_REAL;
+    ultimo = q;
+    if (q == fin)
+        return ultimo - p;
+    switch (clase[(unsigned char)*q++])
+    {
+    case 0: case 20:
+        goto e1;
+    case 19:
+        goto e27;
+    case 14:
+        goto e32;
+    }
+    return ultimo - p;
+}
+
+} // namespace directo
+
+} // namespace afd
+
+#endif
@@ -0,0 +1,325 @@
+/**
+ * @file    maquina.h
+ * @version 1.0
+ * @date    19/10/2026
+ * @title   Máquina virtual
+ * @brief   Ejecuta un Programa de bytecode.h, o un módulo ya compilado (modulo.h) a través
+ *          de VistaPrograma. El despacho es por goto calculado (extensión de
+ *          GCC y Clang): cada instrucción termina saltando directamente a la etiqueta de la
+ *          siguiente, sin volver a un switch, y así cada instrucción tiene su propio salto
+ *          indirecto que el procesador predice por separado.
+ *
+ *          Los registros de todos los marcos están en un solo arreglo: el marco de una llamada
+ *          empieza en los argumentos que dejó quien llama, y de cada llamada solo se guarda a
+ *          dónde regresar y dónde empieza el marco anterior. printI y printS escriben en un
+ *          búfer que se vacía en el flujo de salida cuando se llena y al terminar.
+ */
+
+#ifndef MAQUINA_H
+#define MAQUINA_H
+
+#include <charconv>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "bytecode.h"
+
+union Valor
+{
+    int32_t i;
+    float f;
+};
+
+class Maquina
+{
+    struct Marco
+    {
+        const Instr *regreso;
+        size_t base;
+    };
+
+    VistaPrograma prog;
+    /// Cadenas de un Programa en memoria, juntas como las de un módulo
+    std::vector<uint32_t> inicios;
+    std::string texto;
+    std::ostream &salida;
+    std::vector<Valor> pila = std::vector<Valor>(1 << 16);
+    std::vector<Marco> marcos;
+    /// Registros que puede tener la pila antes de reportar un desbordamiento (256 MB)
+    size_t limite = size_t(1) << 26;
+    /// Llamadas anidadas antes de reportar un desbordamiento (64 MB de marcos); con -O una
+    /// llamada en cola puede reusar los registros, y entonces solo crecen los marcos
+    size_t limiteLlamadas = size_t(1) << 22;
+
+    char bufer[1 << 16];
+    size_t usados = 0;
+
+    uint64_t ejecutadas = 0;
+    std::string error;
+
+    void vaciar()
+    {
+        salida.write(bufer, usados);
+        usados = 0;
+    }
+
+    void escribir(const char *s, size_t n)
+    {
+        if (usados + n > sizeof(bufer))
+        {
+            vaciar();
+            if (n > sizeof(bufer))
+            {
+                salida.write(s, n);
+                return;
+            }
+        }
+        memcpy(bufer + usados, s, n);
+        usados += n;
+    }
+
+    void escribir(int32_t v)
+    {
+        if (usados + 12 > sizeof(bufer))
+            vaciar();
+        usados = std::to_chars(bufer + usados, bufer + sizeof(bufer), v).ptr - bufer;
+    }
+
+public:
+    Maquina(const Programa &p, std::ostream &out) : salida(out)
+    {
+        inicios.push_back(0);
+        for (const std::string &s : p.cadenas)
+        {
+            texto += s;
+            inicios.push_back(texto.size());
+        }
+        prog = VistaPrograma{p.codigo.data(), p.funciones.data(), inicios.data(), texto.data(), p.principal};
+    }
+
+    Maquina(const VistaPrograma &v, std::ostream &out) : prog(v), salida(out) {}
+
+    /**
+     * @brief Ejecuta main (con sus parámetros en 0).
+     * @param resultado Valor que devuelve main (0 si es void)
+     * @return false si hubo un error de ejecución (ver mensaje())
+     */
+    bool ejecutar(int32_t &resultado)
+    {
+        TRAZA("Maquina::ejecutar");
+        // en el orden de CodigoOp
+        static void *const etiquetas[OP_NUM] = {
+            &&L_MOV, &&L_CARGA, &&L_SUMAI, &&L_RESTAI, &&L_MULI, &&L_DIVI, &&L_SUMAIK,
+            &&L_SUMAF, &&L_RESTAF, &&L_MULF, &&L_DIVF,
+            &&L_MENORI, &&L_MAYORI, &&L_MENORIGI, &&L_MAYORIGI, &&L_IGUALI, &&L_DISTI,
+            &&L_MENORF, &&L_MAYORF, &&L_MENORIGF, &&L_MAYORIGF, &&L_IGUALF, &&L_DISTF,
+            &&L_NEGI, &&L_NEGF, &&L_NOTI, &&L_NOTF, &&L_LOGI, &&L_LOGF, &&L_AF,
+            &&L_SALTA, &&L_SALTAF, &&L_SALTAV, &&L_LLAMA, &&L_REGRESA, &&L_REGRESAV,
+            &&L_PRINTI, &&L_PRINTS};
+
+        const Instr *codigo = prog.codigo;
+        const FuncionBC &principal = prog.funciones[prog.principal];
+        error.clear();
+        marcos.clear();
+        if (pila.size() < principal.registros)
+            pila.resize(principal.registros);
+        std::fill(pila.begin(), pila.begin() + principal.registros, Valor{0});
+        Valor *r = pila.data();
+        const Instr *pc = codigo + principal.inicio;
+        uint64_t n = 0;
+
+// ejecuta la instrucción a la que apunta pc
+#define DESPACHAR()             \
+    do                          \
+    {                           \
+        ++n;                    \
+        goto *etiquetas[pc->op]; \
+    } while (0)
+#define SIGUIENTE() \
+    do              \
+    {               \
+        ++pc;       \
+        DESPACHAR(); \
+    } while (0)
+#define A r[pc->a]
+#define B r[pc->r.b]
+#define C r[pc->r.c]
+// aritmética de int con desbordamiento circular, como en el hardware
+#define ENTERO(op) int32_t(uint32_t(B.i) op uint32_t(C.i))
+
+        DESPACHAR();
+
+    L_MOV:
+        A = B;
+        SIGUIENTE();
+    L_CARGA:
+        A.i = pc->k;
+        SIGUIENTE();
+    L_SUMAI:
+        A.i = ENTERO(+);
+        SIGUIENTE();
+    L_RESTAI:
+        A.i = ENTERO(-);
+        SIGUIENTE();
+    L_MULI:
+        A.i = ENTERO(*);
+        SIGUIENTE();
+    L_DIVI:
+        if (C.i == 0)
+        {
+            error = "división entre cero";
+            goto fin;
+        }
+        A.i = C.i == -1 ? int32_t(0u - uint32_t(B.i)) : B.i / C.i;
+        SIGUIENTE();
+    L_SUMAIK:
+        A.i = int32_t(uint32_t(B.i) + uint32_t(int16_t(pc->r.c)));
+        SIGUIENTE();
+    L_SUMAF:
+        A.f = B.f + C.f;
+        SIGUIENTE();
+    L_RESTAF:
+        A.f = B.f - C.f;
+        SIGUIENTE();
+    L_MULF:
+        A.f = B.f * C.f;
+        SIGUIENTE();
+    L_DIVF:
+        A.f = B.f / C.f;
+        SIGUIENTE();
+    L_MENORI:
+        A.i = B.i < C.i;
+        SIGUIENTE();
+    L_MAYORI:
+        A.i = B.i > C.i;
+        SIGUIENTE();
+    L_MENORIGI:
+        A.i = B.i <= C.i;
+        SIGUIENTE();
+    L_MAYORIGI:
+        A.i = B.i >= C.i;
+        SIGUIENTE();
+    L_IGUALI:
+        A.i = B.i == C.i;
+        SIGUIENTE();
+    L_DISTI:
+        A.i = B.i != C.i;
+        SIGUIENTE();
+    L_MENORF:
+        A.i = B.f < C.f;
+        SIGUIENTE();
+    L_MAYORF:
+        A.i = B.f > C.f;
+        SIGUIENTE();
+    L_MENORIGF:
+        A.i = B.f <= C.f;
+        SIGUIENTE();
+    L_MAYORIGF:
+        A.i = B.f >= C.f;
+        SIGUIENTE();
+    L_IGUALF:
+        A.i = B.f == C.f;
+        SIGUIENTE();
+    L_DISTF:
+        A.i = B.f != C.f;
+        SIGUIENTE();
+    L_NEGI:
+        A.i = int32_t(0u - uint32_t(B.i));
+        SIGUIENTE();
+    L_NEGF:
+        A.f = -B.f;
+        SIGUIENTE();
+    L_NOTI:
+        A.i = !B.i;
+        SIGUIENTE();
+    L_NOTF:
+        A.i = B.f == 0.0f;
+        SIGUIENTE();
+    L_LOGI:
+        A.i = B.i != 0;
+        SIGUIENTE();
+    L_LOGF:
+        A.i = B.f != 0.0f;
+        SIGUIENTE();
+    L_AF:
+        A.f = float(B.i);
+        SIGUIENTE();
+    L_SALTA:
+        pc = codigo + pc->k;
+        DESPACHAR();
+    L_SALTAF:
+        pc = A.i ? pc + 1 : codigo + pc->k;
+        DESPACHAR();
+    L_SALTAV:
+        pc = A.i ? codigo + pc->k : pc + 1;
+        DESPACHAR();
+    L_LLAMA:
+    {
+        const FuncionBC &f = prog.funciones[pc->k];
+        size_t base = r - pila.data();
+        size_t nueva = base + pc->a;
+        if (marcos.size() >= limiteLlamadas)
+        {
+            error = "desbordamiento de la pila";
+            goto fin;
+        }
+        if (nueva + f.registros > pila.size())
+        {
+            if (nueva + f.registros > limite)
+            {
+                error = "desbordamiento de la pila";
+                goto fin;
+            }
+            pila.resize(std::min(limite, std::max(pila.size() * 2, nueva + f.registros)));
+        }
+        marcos.push_back(Marco{pc + 1, base});
+        r = pila.data() + nueva;
+        pc = codigo + f.inicio;
+        DESPACHAR();
+    }
+    L_REGRESA:
+        r[0] = A;
+    L_REGRESAV:
+        if (marcos.empty())
+            goto fin;
+        pc = marcos.back().regreso;
+        r = pila.data() + marcos.back().base;
+        marcos.pop_back();
+        DESPACHAR();
+    L_PRINTI:
+        escribir(A.i);
+        SIGUIENTE();
+    L_PRINTS:
+    {
+        escribir(prog.texto + prog.cadenas[pc->k], prog.cadenas[pc->k + 1] - prog.cadenas[pc->k]);
+        SIGUIENTE();
+    }
+
+#undef DESPACHAR
+#undef SIGUIENTE
+#undef A
+#undef B
+#undef C
+#undef ENTERO
+
+    fin:
+        vaciar();
+        ejecutadas = n;
+        resultado = pc->op == OP_REGRESA ? r[0].i : 0;
+        return error.empty();
+    }
+
+    /// Instrucciones ejecutadas en la última ejecución
+    uint64_t nInstrucciones() const
+    {
+        return ejecutadas;
+    }
+
+    /// Error de la última ejecución, vacío si no hubo
+    const std::string &mensaje() const
+    {
+        return error;
+    }
+};
+
+#endif
@@ -0,0 +1,300 @@
+/**
+ * @file    modulo.h
+ * @version 1.0
+ * @date    19/10/2026
+ * @title   Módulos de bytecode
+ * @brief   Formato binario de un Programa ya compilado (bytecode.h), para ejecutarlo sin volver
+ *          a analizar el código fuente. Todas las referencias dentro del archivo son índices
+ *          (instrucciones, funciones, posiciones en el texto de las cadenas), no apuntadores, así
+ *          que el archivo se mapea con mmap en cualquier dirección y Maquina lo ejecuta tal cual
+ *          a través de VistaPrograma, sin copiarlo ni ajustar nada.
+ *
+ *          Disposición del archivo (todas las secciones alineadas a 64 bytes):
+ *            CabeceraModulo | Instr[nCodigo] | FuncionBC[nFunciones] |
+ *            uint32_t cadenas[nCadenas + 1] | char texto[cadenas[nCadenas]]
+ *
+ *          El archivo puede venir corrompido o truncado, así que al abrirlo, además de la cabecera
+ *          y los tamaños de las secciones, se verifica el bytecode en una pasada: códigos,
+ *          saltos, llamadas, registros y cadenas dentro de rango. Un módulo que la pasa no hace
+ *          que Maquina lea o salte fuera de sus arreglos.
+ */
+
+#ifndef MODULO_H
+#define MODULO_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "bytecode.h"
+
+/// Se incrementa cada vez que cambia el formato del archivo o el significado del bytecode
+#define VERSION_MODULO 1
+
+/// Alineación de cada sección del archivo
+#define ALINEACION_MODULO 64
+
+struct CabeceraModulo
+{
+    char magia[4];
+    uint32_t version;
+    /// OP_NUM y los tamaños de Instr y FuncionBC con los que se escribió, para no ejecutar un
+    /// módulo de otra versión de la máquina aunque alguien olvide subir VERSION_MODULO
+    uint16_t nOps;
+    uint16_t tamInstr;
+    uint16_t tamFuncion;
+    uint16_t reservado;
+    uint32_t principal;
+    uint32_t nCodigo;
+    uint32_t nFunciones;
+    uint32_t nCadenas;
+};
+
+/// Redondea una posición a la siguiente sección alineada
+inline uint64_t alinearModulo(uint64_t x)
+{
+    return (x + ALINEACION_MODULO - 1) & ~(uint64_t)(ALINEACION_MODULO - 1);
+}
+
+/// Posiciones de las secciones de un módulo a partir de su cabecera
+struct SeccionesModulo
+{
+    uint64_t codigo, funciones, cadenas, texto;
+
+    explicit SeccionesModulo(const CabeceraModulo &c)
+    {
+        codigo = alinearModulo(sizeof(CabeceraModulo));
+        funciones = alinearModulo(codigo + (uint64_t)c.nCodigo * sizeof(Instr));
+        cadenas = alinearModulo(funciones + (uint64_t)c.nFunciones * sizeof(FuncionBC));
+        texto = alinearModulo(cadenas + ((uint64_t)c.nCadenas + 1) * sizeof(uint32_t));
+    }
+};
+
+/// Módulo abierto: sus secciones apuntan a las páginas mapeadas
+class ModuloBytecode
+{
+    const char *mapa = nullptr;
+    size_t tamMapa = 0;
+    std::string error;
+
+    /**
+     * @brief Revisa en una pasada que Maquina pueda ejecutar el bytecode sin salirse de sus
+     * arreglos: los códigos existen; las funciones son tramos seguidos de instrucciones, desde la
+     * 0 hasta la última, y cada una termina en salta, regresa o regresav; los saltos no salen de
+     * su función; los registros caben en el marco; las llamadas y las cadenas existen.
+     *
+     * @return false con el motivo en error si algo no cumple | true en otro caso
+     */
+    bool verificar()
+    {
+        SeccionesModulo s(cab);
+        const Instr *codigo = (const Instr *)(mapa + s.codigo);
+        const FuncionBC *funciones = (const FuncionBC *)(mapa + s.funciones);
+        const uint32_t *cadenas = (const uint32_t *)(mapa + s.cadenas);
+        for (uint32_t k = 0; k < cab.nCadenas; ++k)
+            if (cadenas[k] > cadenas[k + 1])
+            {
+                error = "las cadenas no están en orden";
+                return false;
+            }
+        for (uint32_t f = 0; f < cab.nFunciones; ++f)
+        {
+            const FuncionBC &fn = funciones[f];
+            uint32_t fin = f + 1 < cab.nFunciones ? funciones[f + 1].inicio : cab.nCodigo;
+            if ((f == 0 && fn.inicio != 0) || fn.inicio >= fin)
+            {
+                error = "la función " + std::to_string(f) + " no empieza donde termina la anterior";
+                return false;
+            }
+            for (uint32_t i = fn.inicio; i < fin; ++i)
+            {
+                const Instr &x = codigo[i];
+                // registros que lee o escribe la instrucción (el resto de los campos son constantes)
+                uint32_t usa = 0;
+                switch (x.op)
+                {
+                case OP_CARGA:
+                case OP_SALTAF:
+                case OP_SALTAV:
+                case OP_LLAMA: // el marco de la llamada empieza en a; Maquina crece la pila para él
+                case OP_REGRESA:
+                case OP_PRINTI:
+                    usa = x.a;
+                    break;
+                case OP_SALTA:
+                case OP_REGRESAV:
+                case OP_PRINTS:
+                    break;
+                case OP_MOV:
+                case OP_SUMAIK:
+                case OP_NEGI:
+                case OP_NEGF:
+                case OP_NOTI:
+                case OP_NOTF:
+                case OP_LOGI:
+                case OP_LOGF:
+                case OP_AF:
+                    usa = std::max(x.a, x.r.b);
+                    break;
+                default:
+                    if (x.op >= OP_NUM)
+                    {
+                        error = "código de operación inválido en la instrucción " + std::to_string(i);
+                        return false;
+                    }
+                    usa = std::max({x.a, x.r.b, x.r.c});
+                }
+                bool salto = x.op == OP_SALTA || x.op == OP_SALTAF || x.op == OP_SALTAV;
+                if (usa >= fn.registros || (salto && (uint32_t(x.k) < fn.inicio || uint32_t(x.k) >= fin)) ||
+                    (x.op == OP_LLAMA && uint32_t(x.k) >= cab.nFunciones) ||
+                    (x.op == OP_PRINTS && uint32_t(x.k) >= cab.nCadenas))
+                {
+                    error = "operando fuera de rango en la instrucción " + std::to_string(i);
+                    return false;
+                }
+            }
+            CodigoOp ultima = codigo[fin - 1].op;
+            if (ultima != OP_SALTA && ultima != OP_REGRESA && ultima != OP_REGRESAV)
+            {
+                error = "la función " + std::to_string(f) + " no termina en salta ni en regresa";
+                return false;
+            }
+        }
+        return true;
+    }
+
+public:
+    /// Cabecera leída; en ceros si el archivo no existe o no es un módulo válido
+    CabeceraModulo cab = {};
+
+    ModuloBytecode() = default;
+    ModuloBytecode(const ModuloBytecode &) = delete;
+    ModuloBytecode &operator=(const ModuloBytecode &) = delete;
+    ~ModuloBytecode() { cerrar(); }
+
+    void cerrar()
+    {
+        if (mapa)
+            munmap((void *)mapa, tamMapa);
+        mapa = nullptr;
+        tamMapa = 0;
+    }
+
+    /**
+     * @brief Mapea un módulo y verifica su formato y su bytecode (verificar()).
+     *
+     * @param ruta Ruta del módulo
+     * @return false si no existe, no es un módulo, es de otra versión, está truncado o su bytecode
+     * no es válido (si es un módulo, con el motivo en mensaje()) | true en otro caso
+     */
+    bool abrir(const char *ruta)
+    {
+        cerrar();
+        cab = CabeceraModulo{};
+        error.clear();
+        int fd = open(ruta, O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(CabeceraModulo))
+        {
+            close(fd);
+            return false;
+        }
+        void *m = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (m == MAP_FAILED)
+            return false;
+        mapa = (const char *)m;
+        tamMapa = st.st_size;
+
+        memcpy(&cab, mapa, sizeof cab);
+        if (memcmp(cab.magia, "2PBC", 4) == 0)
+        {
+            SeccionesModulo s(cab);
+            if (cab.version != VERSION_MODULO || cab.nOps != OP_NUM || cab.tamInstr != sizeof(Instr) ||
+                cab.tamFuncion != sizeof(FuncionBC))
+                error = "el módulo es de otra versión";
+            else if (cab.principal >= cab.nFunciones)
+                error = "la función main no existe";
+            else if (s.texto > tamMapa || s.texto + ((const uint32_t *)(mapa + s.cadenas))[cab.nCadenas] != tamMapa)
+                error = "el módulo está truncado";
+            else if (verificar())
+                return true;
+        }
+        cab = CabeceraModulo{};
+        cerrar();
+        return false;
+    }
+
+    /// Por qué no se pudo abrir el último módulo; vacío si se abrió o si el archivo no es un módulo
+    const std::string &mensaje() const
+    {
+        return error;
+    }
+
+    /// Lo que necesita Maquina; válido mientras el módulo siga abierto
+    VistaPrograma vista() const
+    {
+        SeccionesModulo s(cab);
+        return VistaPrograma{(const Instr *)(mapa + s.codigo), (const FuncionBC *)(mapa + s.funciones),
+                             (const uint32_t *)(mapa + s.cadenas), mapa + s.texto, cab.principal};
+    }
+};
+
+/**
+ * @brief Escribe prog como módulo. Se escribe primero en ruta.tmp y luego se renombra, para que
+ * otra ejecución nunca mapee un módulo a medio escribir. Los nodos de las funciones no se guardan
+ * (sin el árbol no significan nada).
+ *
+ * @return false si no se pudo escribir | true en otro caso
+ */
+inline bool escribirModulo(const char *ruta, const Programa &prog)
+{
+    CabeceraModulo cab = {{'2', 'P', 'B', 'C'}, VERSION_MODULO, OP_NUM, sizeof(Instr), sizeof(FuncionBC), 0,
+                          prog.principal, (uint32_t)prog.codigo.size(), (uint32_t)prog.funciones.size(),
+                          (uint32_t)prog.cadenas.size()};
+    std::vector<FuncionBC> funciones = prog.funciones;
+    for (FuncionBC &f : funciones)
+        f.nodo = NINGUNO;
+    std::vector<uint32_t> inicios{0};
+    std::string texto;
+    for (const std::string &s : prog.cadenas)
+    {
+        texto += s;
+        inicios.push_back(texto.size());
+    }
+
+    std::string tmp = std::string(ruta) + ".tmp";
+    FILE *f = fopen(tmp.c_str(), "wb");
+    if (!f)
+        return false;
+
+    static const char ceros[ALINEACION_MODULO] = {};
+    uint64_t pos = 0;
+    bool ok = true;
+    auto seccion = [&](const void *p, uint64_t n) {
+        uint64_t relleno = alinearModulo(pos) - pos;
+        ok = ok && fwrite(ceros, 1, relleno, f) == relleno && fwrite(p, 1, n, f) == n;
+        pos += relleno + n;
+    };
+    seccion(&cab, sizeof cab);
+    seccion(prog.codigo.data(), prog.codigo.size() * sizeof(Instr));
+    seccion(funciones.data(), funciones.size() * sizeof(FuncionBC));
+    seccion(inicios.data(), inicios.size() * sizeof(uint32_t));
+    seccion(texto.data(), texto.size());
+
+    ok = fclose(f) == 0 && ok;
+    if (ok && rename(tmp.c_str(), ruta) == 0)
+        return true;
+    remove(tmp.c_str());
+    return false;
+}
+
+#endif
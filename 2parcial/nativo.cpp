@@ -0,0 +1,101 @@
+/**
+ * @file    nativo.cpp
+ * @version 1.0
+ * @date    19/10/2026
+ * @brief   Compila un programa a un ejecutable x86-64: pasa por la forma SSA y el optimizador
+ *          (ssa.h, optimizador.h), escribe el ensamblador con nativo.h y lo ensambla y enlaza
+ *          con el compilador de C del sistema ($CC, o cc si no está definido). El ejecutable
+ *          es estático y no usa la biblioteca de C; termina con el valor que devuelve main,
+ *          como ejecutar.
+ *
+ *          Con -S solo escribe el ensamblador (archivo.s). Con -o se elige el nombre del
+ *          ejecutable; por omisión es el del fuente sin la extensión. Como en ejecutar, el
+ *          análisis sintáctico de archivos grandes reparte las funciones entre los núcleos. A
+ *          diferencia de ejecutar, una recursión sin fin no se reporta: el ejecutable termina con
+ *          SIGSEGV (ver nativo.h).
+ *
+ *          g++ -std=c++17 -O2 -pthread nativo.cpp -o nativo
+ *          ./nativo [-S] [-o ejecutable] archivo.c
+ */
+
+#include <cstdio>
+#include <fstream>
+#include "sintactico.h"
+#include "sintactico.cpp"
+#include "optimizador.h"
+#include "nativo.h"
+
+int main(int argc, char *argv[])
+{
+    bool soloEnsamblador = false;
+    const char *ruta = nullptr;
+    std::string salida;
+    for (int i = 1; i < argc; ++i)
+        if (!strcmp(argv[i], "-S"))
+            soloEnsamblador = true;
+        else if (!strcmp(argv[i], "-o") && i + 1 < argc)
+            salida = argv[++i];
+        else
+            ruta = argv[i];
+    if (!ruta)
+    {
+        std::cout << "Necesita indicar el nombre del código fuente.\n";
+        return 0;
+    }
+    if (salida.empty())
+    {
+        salida = ruta;
+        size_t punto = salida.rfind('.');
+        if (punto != std::string::npos && salida.find('/', punto) == std::string::npos)
+            salida.resize(punto);
+        if (salida == ruta)
+            salida += ".out";
+    }
+
+    Lexico lex;
+    Internador internador;
+    lex.usarInternador(&internador);
+    if (!lex.abrir(ruta))
+    {
+        std::cout << "Error: no se pudo abrir el archivo.\n";
+        return EXIT_FAILURE;
+    }
+    std::vector<Token> tokens;
+    if (!lex.analizar(tokens))
+        return EXIT_FAILURE;
+    Sintactico sin;
+    sin.usarLexico(&lex);
+    if (!analizarEnParalelo(tokens, sin))
+        return EXIT_FAILURE;
+    Semantico sem(lex, internador, std::cout);
+    if (!sem.analizar(sin.arbol()))
+        return EXIT_FAILURE;
+
+    ProgramaSsa ssa;
+    ConstructorSsa(lex, sem).construir(sin.arbol(), ssa);
+    Optimizador().optimizar(ssa);
+
+    std::string ensamblador = salida + ".s";
+    {
+        std::ofstream out(ensamblador);
+        if (!out)
+        {
+            std::cout << "Error: no se pudo escribir " << ensamblador << "\n";
+            return EXIT_FAILURE;
+        }
+        TraductorX86().traducir(ssa, lex, sin.arbol(), out);
+    }
+    if (soloEnsamblador)
+        return 0;
+
+    const char *cc = getenv("CC");
+    std::string orden = std::string(cc && *cc ? cc : "cc") + " -nostdlib -static -Wl,-e,rt.inicio -o '" + salida +
+                        "' '" + ensamblador + "'";
+    if (std::system(orden.c_str()) != 0)
+    {
+        std::cout << "Error: falló " << orden << "\n";
+        return EXIT_FAILURE;
+    }
+    std::remove(ensamblador.c_str());
+    return 0;
+}
@@ -0,0 +1,1015 @@
+/**
+ * @file    nativo.h
+ * @version 1.0
+ * @date    19/10/2026
+ * @title   Código nativo x86-64
+ * @brief   Traduce un ProgramaSsa (ssa.h, normalmente ya optimizado) a ensamblador x86-64 de GNU
+ *          as en sintaxis Intel, que el ensamblador y el enlazador del sistema convierten en un
+ *          ejecutable estático (ver nativo.cpp).
+ *
+ *          Cada función sigue la convención System V: los int llegan en edi, esi, edx, ecx, r8d
+ *          y r9d, los float en xmm0 a xmm7, los demás en la pila, y el resultado regresa en eax
+ *          o xmm0. Los valores se asignan a registros con un recorrido lineal (Poletto y Sarkar,
+ *          1999) sobre los intervalos de VidaSsa: el que cruza una llamada solo puede ir en un
+ *          registro que se conserva (rbx, r12 a r15) y, si no hay lugar, el intervalo que
+ *          termina más tarde se guarda en la pila durante toda su vida. Las constantes no ocupan
+ *          registro: van en la instrucción o en .rodata.
+ *
+ *          rax, rdx, r11, xmm14 y xmm15 no se asignan: son para la división, las copias y los
+ *          operandos que no pueden ir en memoria. El programa no usa la biblioteca de C: rt.inicio
+ *          llama a main, y printI y printS escriben en un búfer que se vacía con la llamada al
+ *          sistema write, igual que en maquina.h, y el ejecutable no depende de nada más.
+ *
+ *          A diferencia de maquina.h, el código generado no limita la profundidad de las
+ *          llamadas: una recursión sin fin agota la pila del proceso y termina con SIGSEGV, no
+ *          con el error "desbordamiento de la pila".
+ */
+
+#ifndef NATIVO_H
+#define NATIVO_H
+
+#include <map>
+#include <ostream>
+#include "ssa.h"
+
+class TraductorX86
+{
+    /// Registros que se asignan a los int; los primeros CONSERVADOS no cambian en una llamada
+    static constexpr const char *enteros[] = {"ebx", "r12d", "r13d", "r14d", "r15d", "ecx",
+                                              "esi", "edi", "r8d", "r9d", "r10d"};
+    static constexpr const char *enteros64[] = {"rbx", "r12", "r13", "r14", "r15", "rcx",
+                                                "rsi", "rdi", "r8", "r9", "r10"};
+    static constexpr unsigned ENTEROS = 11, CONSERVADOS = 5, REALES = 14;
+    static constexpr const char *argumentosI[] = {"edi", "esi", "edx", "ecx", "r8d", "r9d"};
+
+    /// Lugar de un valor: registro (int o xmm según el tipo) o ranura de la pila
+    struct Lugar
+    {
+        enum : unsigned char
+        {
+            NINGUNO_,
+            REGISTRO,
+            PILA
+        } tipo = NINGUNO_;
+        uint32_t n = 0;
+    };
+
+    struct Copia
+    {
+        TipoDato tipo;
+        std::string destino, origen;
+    };
+
+    ProgramaSsa *prog = nullptr;
+    std::ostream *out = nullptr;
+    FuncionSsa *fn = nullptr;
+    uint32_t numeroFuncion = 0;
+    std::vector<std::string> nombres;
+
+    VidaSsa vida;
+    std::vector<Lugar> lugar;
+    /// Comparación que se emite junto con el if que la usa, sin guardar su resultado
+    std::vector<char> fusionada;
+    uint32_t ranuras = 0, conservados = 0, marco = 0;
+    std::vector<char> conservadoUsado;
+    uint32_t etiquetas = 0;
+
+    /// Constantes float de .rodata por patrón de bits
+    std::map<int32_t, uint32_t> reales;
+
+    void linea(const std::string &s)
+    {
+        *out << "    " << s << "\n";
+    }
+
+    void etiqueta(const std::string &s)
+    {
+        *out << s << ":\n";
+    }
+
+    std::string bloque(uint32_t b) const
+    {
+        return ".L" + std::to_string(numeroFuncion) + "_" + std::to_string(b);
+    }
+
+    std::string nueva()
+    {
+        return ".Lx" + std::to_string(etiquetas++);
+    }
+
+    static bool esMemoria(const std::string &s)
+    {
+        return s.find('[') != std::string::npos;
+    }
+
+    static bool esInmediato(const std::string &s)
+    {
+        return !s.empty() && (isdigit((unsigned char)s[0]) || s[0] == '-');
+    }
+
+    std::string pila(uint32_t ranura) const
+    {
+        return "DWORD PTR [rbp-" + std::to_string(8 * (conservados + 1 + ranura)) + "]";
+    }
+
+    std::string real(int32_t bits)
+    {
+        auto it = reales.find(bits);
+        uint32_t k = it != reales.end() ? it->second : (reales[bits] = reales.size());
+        return "DWORD PTR .LR" + std::to_string(k) + "[rip]";
+    }
+
+    /// Operando con el valor v: inmediato, constante en .rodata, registro o pila
+    std::string op(uint32_t v)
+    {
+        const InsSsa &x = fn->ins[v];
+        if (x.op == S_CONST)
+            return x.tipo == D_FLOAT ? real(x.k) : std::to_string(x.k);
+        const Lugar &l = lugar[v];
+        if (l.tipo == Lugar::PILA)
+            return pila(l.n);
+        if (l.tipo == Lugar::REGISTRO)
+            return x.tipo == D_FLOAT ? "xmm" + std::to_string(l.n) : enteros[l.n];
+        // valor sin usos de una instrucción con efectos (una llamada o una división)
+        return x.tipo == D_FLOAT ? "xmm15" : "r11d";
+    }
+
+    /// Copia un int o float entre dos lugares cualesquiera (el destino no es inmediato)
+    void mover(TipoDato tipo, const std::string &d, const std::string &o)
+    {
+        if (d == o)
+            return;
+        if (tipo != D_FLOAT)
+        {
+            if (esMemoria(d) && esMemoria(o))
+            {
+                linea("mov r11d, " + o);
+                linea("mov " + d + ", r11d");
+            }
+            else
+                linea("mov " + d + ", " + o);
+        }
+        else if (esMemoria(d) && esMemoria(o))
+        {
+            linea("movss xmm15, " + o);
+            linea("movss " + d + ", xmm15");
+        }
+        else
+            linea((esMemoria(d) || esMemoria(o) ? "movss " : "movaps ") + d + ", " + o);
+    }
+
+    /// Emite las copias como si fueran simultáneas (como TraductorBytecode::copiasParalelas)
+    void copiasParalelas(std::vector<Copia> copias)
+    {
+        copias.erase(std::remove_if(copias.begin(), copias.end(), [](const Copia &c) { return c.destino == c.origen; }),
+                     copias.end());
+        while (!copias.empty())
+        {
+            bool hecho = false;
+            for (size_t k = 0; k < copias.size() && !hecho; ++k)
+            {
+                const std::string &d = copias[k].destino;
+                if (std::none_of(copias.begin(), copias.end(), [&](const Copia &c) { return c.origen == d; }))
+                {
+                    mover(copias[k].tipo, d, copias[k].origen);
+                    copias.erase(copias.begin() + k);
+                    hecho = true;
+                }
+            }
+            if (!hecho)
+            {
+                // un ciclo: el destino de la primera copia se guarda en eax o xmm14
+                Copia c = copias[0];
+                std::string temporal = c.tipo == D_FLOAT ? "xmm14" : "eax";
+                mover(c.tipo, temporal, c.destino);
+                for (Copia &x : copias)
+                    if (x.origen == c.destino)
+                        x.origen = temporal;
+            }
+        }
+    }
+
+    /// Lugar según System V del argumento k de una llamada con argumentos de los tipos dados
+    static std::string lugarArgumento(const std::vector<TipoDato> &tipos, size_t k, bool entrada)
+    {
+        size_t enteros = 0, flotantes = 0, enPila = 0;
+        for (size_t i = 0; i < k; ++i)
+            tipos[i] == D_FLOAT ? (flotantes < 8 ? ++flotantes : ++enPila) : (enteros < 6 ? ++enteros : ++enPila);
+        if (tipos[k] == D_FLOAT && flotantes < 8)
+            return "xmm" + std::to_string(flotantes);
+        if (tipos[k] != D_FLOAT && enteros < 6)
+            return argumentosI[enteros];
+        // quien llama los deja en [rsp]; la función los lee arriba de la dirección de regreso
+        return "DWORD PTR [" + std::string(entrada ? "rbp+" : "rsp+") + std::to_string(8 * enPila + (entrada ? 16 : 0)) +
+               "]";
+    }
+
+    static size_t argumentosEnPila(const std::vector<TipoDato> &tipos)
+    {
+        size_t enteros = 0, flotantes = 0;
+        for (TipoDato t : tipos)
+            t == D_FLOAT ? ++flotantes : ++enteros;
+        return (enteros > 6 ? enteros - 6 : 0) + (flotantes > 8 ? flotantes - 8 : 0);
+    }
+
+    static bool esComparacion(OpSsa op)
+    {
+        return op >= S_MENOR && op <= S_DIST;
+    }
+
+    /// El operando a de x ocupa un lugar propio
+    bool enRegistro(const InsSsa &x, const uint32_t &a) const
+    {
+        return fn->ins[a].op != S_CONST && !(x.op == S_SI && fusionada[a]);
+    }
+
+    void marcarFusiones()
+    {
+        fusionada.assign(fn->ins.size(), 0);
+        std::vector<uint32_t> usos(fn->ins.size(), 0);
+        for (const BloqueSsa &b : fn->bloques)
+            for (uint32_t i : b.ins)
+                FuncionSsa::operandos(fn->ins[i], [&](uint32_t &a) { ++usos[a]; });
+        for (const BloqueSsa &b : fn->bloques)
+        {
+            if (b.ins.size() < 2 || fn->ins[b.ins.back()].op != S_SI)
+                continue;
+            uint32_t c = b.ins[b.ins.size() - 2];
+            const InsSsa &x = fn->ins[c];
+            // las igualdades de float necesitan revisar también la bandera de paridad
+            if (fn->ins[b.ins.back()].a == c && usos[c] == 1 && esComparacion(x.op) &&
+                !(fn->ins[x.a].tipo == D_FLOAT && (x.op == S_IGUAL || x.op == S_DIST)))
+                fusionada[c] = 1;
+        }
+    }
+
+    /// Registro asignable que es el lugar de un argumento, o NINGUNO (edx y la pila)
+    static uint32_t registroArgumento(const std::string &lugar)
+    {
+        if (lugar.compare(0, 3, "xmm") == 0)
+            return std::stoi(lugar.substr(3));
+        for (uint32_t k = 0; k < ENTEROS; ++k)
+            if (lugar == enteros[k])
+                return k;
+        return NINGUNO;
+    }
+
+    void asignarLugares()
+    {
+        const std::vector<uint32_t> &pos = vida.pos, &fin = vida.fin, &usos = vida.usos;
+        size_t nv = fn->ins.size();
+        std::vector<uint32_t> llamadas, valores;
+        std::vector<uint32_t> phiDe(nv, NINGUNO);
+        // un argumento prefiere el registro en que lo espera la función y un parámetro el
+        // registro en que llega
+        std::vector<uint32_t> preferido(nv, NINGUNO);
+        std::vector<TipoDato> tipos(fn->parametros, D_INT);
+        for (uint32_t i : fn->bloques[0].ins)
+            if (fn->ins[i].op == S_PARAM)
+                tipos[fn->ins[i].k] = fn->ins[i].tipo;
+        for (uint32_t i : fn->bloques[0].ins)
+            if (fn->ins[i].op == S_PARAM)
+                preferido[i] = registroArgumento(lugarArgumento(tipos, fn->ins[i].k, true));
+        for (uint32_t b : vida.orden)
+            for (uint32_t i : fn->bloques[b].ins)
+            {
+                const InsSsa &x = fn->ins[i];
+                if (x.op == S_LLAMA)
+                {
+                    llamadas.push_back(pos[i]);
+                    std::vector<TipoDato> t;
+                    for (uint32_t a : x.args)
+                        t.push_back(fn->ins[a].tipo);
+                    for (size_t k = 0; k < x.args.size(); ++k)
+                        if (preferido[x.args[k]] == NINGUNO)
+                            preferido[x.args[k]] = registroArgumento(lugarArgumento(t, k, false));
+                }
+                if (x.op == S_PHI && usos[i])
+                    for (uint32_t a : x.args)
+                        if (phiDe[a] == NINGUNO)
+                            phiDe[a] = i;
+                if (x.tipo != D_VOID && x.op != S_CONST && usos[i])
+                    valores.push_back(i);
+            }
+        std::stable_sort(valores.begin(), valores.end(), [&](uint32_t x, uint32_t y) { return pos[x] < pos[y]; });
+        auto cruza = [&](uint32_t v) {
+            auto it = std::upper_bound(llamadas.begin(), llamadas.end(), pos[v]);
+            return it != llamadas.end() && *it < fin[v];
+        };
+
+        lugar.assign(nv, Lugar());
+        ranuras = 0;
+        conservadoUsado.assign(CONSERVADOS, 0);
+        // valor en cada registro, por clase: 0 para int y 1 para float
+        std::vector<uint32_t> ocupante[2] = {std::vector<uint32_t>(ENTEROS, NINGUNO),
+                                             std::vector<uint32_t>(REALES, NINGUNO)};
+        auto aPila = [&](uint32_t v) {
+            lugar[v].tipo = Lugar::PILA;
+            lugar[v].n = ranuras++;
+        };
+        for (uint32_t v : valores)
+        {
+            bool flotante = fn->ins[v].tipo == D_FLOAT;
+            std::vector<uint32_t> &oc = ocupante[flotante];
+            bool conservar = cruza(v);
+            if (flotante && conservar)
+            {
+                // ningún xmm se conserva en una llamada
+                aPila(v);
+                continue;
+            }
+            unsigned desde = 0, hasta = flotante ? REALES : conservar ? CONSERVADOS : ENTEROS;
+            auto permitido = [&](uint32_t r) { return r >= desde && r < hasta; };
+            auto libre = [&](uint32_t r) { return permitido(r) && (oc[r] == NINGUNO || fin[oc[r]] <= pos[v]); };
+            uint32_t r = NINGUNO;
+            auto sugerir = [&](uint32_t w) {
+                if (r == NINGUNO && w != NINGUNO && lugar[w].tipo == Lugar::REGISTRO &&
+                    (fn->ins[w].tipo == D_FLOAT) == flotante && libre(lugar[w].n))
+                    r = lugar[w].n;
+            };
+            if (fn->ins[v].op == S_PHI)
+                for (uint32_t a : fn->ins[v].args)
+                    sugerir(a);
+            sugerir(phiDe[v]);
+            if (r == NINGUNO && preferido[v] != NINGUNO && libre(preferido[v]))
+                r = preferido[v];
+            // primero los que no hay que guardar en la entrada de la función
+            if (!flotante && !conservar)
+                for (uint32_t k = CONSERVADOS; r == NINGUNO && k < ENTEROS; ++k)
+                    if (libre(k))
+                        r = k;
+            for (uint32_t k = desde; r == NINGUNO && k < hasta; ++k)
+                if (libre(k))
+                    r = k;
+            if (r == NINGUNO)
+            {
+                // sin lugar: a la pila va el intervalo que termina más tarde
+                uint32_t victima = NINGUNO;
+                for (uint32_t k = desde; k < hasta; ++k)
+                    if (victima == NINGUNO || fin[oc[k]] > fin[oc[victima]])
+                        victima = k;
+                if (fin[oc[victima]] <= fin[v])
+                {
+                    aPila(v);
+                    continue;
+                }
+                aPila(oc[victima]);
+                r = victima;
+            }
+            oc[r] = v;
+            lugar[v].tipo = Lugar::REGISTRO;
+            lugar[v].n = r;
+            if (!flotante && r < CONSERVADOS)
+                conservadoUsado[r] = 1;
+        }
+        conservados = std::count(conservadoUsado.begin(), conservadoUsado.end(), 1);
+    }
+
+    /// d = a op b con int; op es add, sub o imul
+    void binariaEntera(const char *ins, std::string d, std::string a, std::string b, bool conmutativa)
+    {
+        if (conmutativa && (esInmediato(a) || b == d))
+            std::swap(a, b);
+        if (!esMemoria(d) && d != b)
+        {
+            mover(D_INT, d, a);
+            linea(std::string(ins) + " " + d + ", " + b);
+        }
+        else
+        {
+            linea("mov r11d, " + a);
+            linea(std::string(ins) + " r11d, " + b);
+            linea("mov " + d + ", r11d");
+        }
+    }
+
+    /// d = a op b con float; op es addss, subss, mulss o divss
+    void binariaReal(const char *ins, std::string d, std::string a, std::string b, bool conmutativa)
+    {
+        if (conmutativa && b == d)
+            std::swap(a, b);
+        if (!esMemoria(d) && d != b)
+        {
+            mover(D_FLOAT, d, a);
+            linea(std::string(ins) + " " + d + ", " + b);
+        }
+        else
+        {
+            mover(D_FLOAT, "xmm15", a);
+            linea(std::string(ins) + " xmm15, " + b);
+            mover(D_FLOAT, d, "xmm15");
+        }
+    }
+
+    /// Guarda en d la bandera cc de la última comparación como 0 o 1
+    void guardarBandera(const std::string &d, const char *cc)
+    {
+        linea(std::string("set") + cc + " al");
+        if (esMemoria(d))
+        {
+            linea("movzx eax, al");
+            linea("mov " + d + ", eax");
+        }
+        else
+            linea("movzx " + d + ", al");
+    }
+
+    /// Compara los operandos de la comparación c y regresa la condición que es verdadera
+    std::string comparar(uint32_t c)
+    {
+        static const char *const condI[] = {"l", "g", "le", "ge", "e", "ne"};
+        static const char *const invertida[] = {"g", "l", "ge", "le", "e", "ne"};
+        const InsSsa &x = fn->ins[c];
+        std::string a = op(x.a), b = op(x.b);
+        int k = x.op - S_MENOR;
+        if (fn->ins[x.a].tipo == D_FLOAT)
+        {
+            // ucomiss deja CF y ZF en 1 si algún operando es NaN, así que < y <= se hacen como
+            // > y >= al revés, que con NaN son falsas
+            bool menor = x.op == S_MENOR || x.op == S_MENORIG;
+            if (menor)
+                std::swap(a, b);
+            if (esMemoria(a))
+            {
+                linea("movss xmm15, " + a);
+                a = "xmm15";
+            }
+            linea("ucomiss " + a + ", " + b);
+            return x.op == S_MENOR || x.op == S_MAYOR ? "a" : x.op == S_IGUAL ? "e" : x.op == S_DIST ? "ne" : "ae";
+        }
+        if (esInmediato(a) && !esInmediato(b))
+        {
+            linea("cmp " + b + ", " + a);
+            return invertida[k];
+        }
+        if (esInmediato(a) || (esMemoria(a) && esMemoria(b)))
+        {
+            linea("mov r11d, " + a);
+            a = "r11d";
+        }
+        linea("cmp " + a + ", " + b);
+        return condI[k];
+    }
+
+    static std::string negar(const std::string &cc)
+    {
+        static const std::map<std::string, std::string> opuesta = {
+            {"l", "ge"}, {"ge", "l"}, {"g", "le"}, {"le", "g"}, {"e", "ne"},
+            {"ne", "e"}, {"a", "be"}, {"be", "a"}, {"ae", "b"}, {"b", "ae"}};
+        return opuesta.at(cc);
+    }
+
+    void dividir(uint32_t i)
+    {
+        const InsSsa &x = fn->ins[i];
+        std::string d = op(i), a = op(x.a), b = op(x.b);
+        if (fn->ins[x.b].op == S_CONST)
+        {
+            int32_t k = fn->ins[x.b].k;
+            if (k == 0)
+            {
+                linea("jmp rt.division");
+                return;
+            }
+            mover(D_INT, "eax", a);
+            if (k == -1)
+                linea("neg eax");
+            else if (k > 0 && (k & (k - 1)) == 0)
+            {
+                // entre 2^s redondeando hacia cero: se suma 2^s - 1 a los negativos
+                int s = __builtin_ctz(k);
+                if (s > 0)
+                {
+                    linea("mov r11d, eax");
+                    linea("sar r11d, 31");
+                    linea("shr r11d, " + std::to_string(32 - s));
+                    linea("add eax, r11d");
+                    linea("sar eax, " + std::to_string(s));
+                }
+            }
+            else
+            {
+                linea("mov r11d, " + b);
+                linea("cdq");
+                linea("idiv r11d");
+            }
+        }
+        else
+        {
+            // como en la máquina: entre cero es un error y entre -1 no debe desbordar idiv
+            std::string menos = nueva(), listo = nueva();
+            mover(D_INT, "eax", a);
+            linea("mov r11d, " + b);
+            linea("test r11d, r11d");
+            linea("je rt.division");
+            linea("cmp r11d, -1");
+            linea("je " + menos);
+            linea("cdq");
+            linea("idiv r11d");
+            linea("jmp " + listo);
+            etiqueta(menos);
+            linea("neg eax");
+            etiqueta(listo);
+        }
+        mover(D_INT, d, "eax");
+    }
+
+    void llamada(uint32_t i)
+    {
+        const InsSsa &x = fn->ins[i];
+        std::vector<TipoDato> tipos;
+        for (uint32_t a : x.args)
+            tipos.push_back(fn->ins[a].tipo);
+        size_t enPila = argumentosEnPila(tipos);
+        size_t reserva = 8 * (enPila + enPila % 2); // rsp queda alineado a 16
+        if (reserva)
+            linea("sub rsp, " + std::to_string(reserva));
+        std::vector<Copia> copias;
+        for (size_t k = 0; k < x.args.size(); ++k)
+        {
+            std::string destino = lugarArgumento(tipos, k, false);
+            // primero los de la pila, que no pisan ningún registro
+            if (esMemoria(destino))
+                mover(tipos[k], destino, op(x.args[k]));
+            else
+                copias.push_back(Copia{tipos[k], destino, op(x.args[k])});
+        }
+        copiasParalelas(copias);
+        linea("call " + nombres[x.k]);
+        if (reserva)
+            linea("add rsp, " + std::to_string(reserva));
+        if (x.tipo != D_VOID && vida.usos[i])
+            mover(x.tipo, op(i), x.tipo == D_FLOAT ? "xmm0" : "eax");
+    }
+
+    void regresar(const InsSsa &x)
+    {
+        if (x.a != NINGUNO)
+            mover(fn->retorno, fn->retorno == D_FLOAT ? "xmm0" : "eax", op(x.a));
+        if (marco)
+            linea("lea rsp, [rbp-" + std::to_string(8 * conservados) + "]");
+        for (size_t r = CONSERVADOS; r-- > 0;)
+            if (conservadoUsado[r])
+                linea(std::string("pop ") + enteros64[r]);
+        linea("pop rbp");
+        linea("ret");
+    }
+
+    void copiasPhi(uint32_t b, uint32_t s)
+    {
+        const BloqueSsa &S = fn->bloques[s];
+        size_t j = std::find(S.pred.begin(), S.pred.end(), b) - S.pred.begin();
+        std::vector<Copia> copias;
+        for (uint32_t i : S.ins)
+        {
+            if (fn->ins[i].op != S_PHI)
+                break;
+            if (vida.usos[i])
+                copias.push_back(Copia{fn->ins[i].tipo, op(i), op(fn->ins[i].args[j])});
+        }
+        copiasParalelas(copias);
+    }
+
+    void salto(uint32_t b, uint32_t siguiente)
+    {
+        if (b != siguiente)
+            linea("jmp " + bloque(b));
+    }
+
+    void instruccion(uint32_t i, uint32_t siguiente)
+    {
+        InsSsa &x = fn->ins[i];
+        if ((x.tipo != D_VOID && !vida.usos[i] && fn->pura(i)) || x.op == S_PHI || x.op == S_PARAM)
+            return;
+        bool flotante = x.a != NINGUNO && fn->ins[x.a].tipo == D_FLOAT;
+        std::string d = x.tipo != D_VOID ? op(i) : "";
+        switch (x.op)
+        {
+        case S_SUMA:
+            flotante ? binariaReal("addss", d, op(x.a), op(x.b), true)
+                     : binariaEntera("add", d, op(x.a), op(x.b), true);
+            break;
+        case S_RESTA:
+            flotante ? binariaReal("subss", d, op(x.a), op(x.b), false)
+                     : binariaEntera("sub", d, op(x.a), op(x.b), false);
+            break;
+        case S_MUL:
+            flotante ? binariaReal("mulss", d, op(x.a), op(x.b), true)
+                     : binariaEntera("imul", d, op(x.a), op(x.b), true);
+            break;
+        case S_DIV:
+            if (flotante)
+                binariaReal("divss", d, op(x.a), op(x.b), false);
+            else
+                dividir(i);
+            break;
+        case S_MENOR:
+        case S_MAYOR:
+        case S_MENORIG:
+        case S_MAYORIG:
+        case S_IGUAL:
+        case S_DIST:
+        {
+            if (fusionada[i])
+                break;
+            std::string cc = comparar(i);
+            if (flotante && (x.op == S_IGUAL || x.op == S_DIST))
+            {
+                // NaN: igual es falso y distinto es verdadero
+                linea(std::string("set") + cc + " al");
+                linea(x.op == S_IGUAL ? "setnp r11b" : "setp r11b");
+                linea(x.op == S_IGUAL ? "and al, r11b" : "or al, r11b");
+                guardarBandera(d, "ne"); // and y or dejan ZF según al
+            }
+            else
+                guardarBandera(d, cc.c_str());
+            break;
+        }
+        case S_NEG:
+            if (flotante)
+            {
+                std::string r = esMemoria(d) ? "xmm15" : d;
+                mover(D_FLOAT, r, op(x.a));
+                linea("xorps " + r + ", XMMWORD PTR .LSIGNO[rip]");
+                mover(D_FLOAT, d, r);
+            }
+            else
+            {
+                std::string r = esMemoria(d) ? "r11d" : d;
+                mover(D_INT, r, op(x.a));
+                linea("neg " + r);
+                mover(D_INT, d, r);
+            }
+            break;
+        case S_NOT:
+        case S_LOG:
+            if (flotante)
+            {
+                linea("xorps xmm15, xmm15");
+                linea("ucomiss xmm15, " + op(x.a));
+                linea(x.op == S_NOT ? "sete al" : "setne al");
+                linea(x.op == S_NOT ? "setnp r11b" : "setp r11b");
+                linea(x.op == S_NOT ? "and al, r11b" : "or al, r11b");
+                guardarBandera(d, "ne");
+            }
+            else
+            {
+                std::string a = op(x.a);
+                if (esInmediato(a))
+                {
+                    linea("mov r11d, " + a);
+                    a = "r11d";
+                }
+                linea("cmp " + a + ", 0");
+                guardarBandera(d, x.op == S_NOT ? "e" : "ne");
+            }
+            break;
+        case S_AF:
+        {
+            std::string r = esMemoria(d) ? "xmm15" : d, a = op(x.a);
+            if (esInmediato(a))
+            {
+                linea("mov r11d, " + a);
+                a = "r11d";
+            }
+            linea("xorps " + r + ", " + r);
+            linea("cvtsi2ss " + r + ", " + a);
+            mover(D_FLOAT, d, r);
+            break;
+        }
+        case S_LLAMA:
+            llamada(i);
+            break;
+        case S_PRINTI:
+            mover(D_INT, "eax", op(x.a));
+            linea("call rt.printi");
+            break;
+        case S_PRINTS:
+            linea("lea rax, .LC" + std::to_string(x.k) + "[rip]");
+            linea("mov r11d, " + std::to_string(prog->cadenas[x.k].size()));
+            linea("call rt.prints");
+            break;
+        case S_SALTA:
+        {
+            uint32_t s = fn->bloques[x.bloque].suc[0];
+            copiasPhi(x.bloque, s);
+            if (s != siguiente && s != x.bloque && fn->copiable(s))
+            {
+                // como en TraductorBytecode: la condición del ciclo se repite en vez de saltar a ella
+                for (uint32_t j : fn->bloques[s].ins)
+                    instruccion(j, siguiente);
+                break;
+            }
+            salto(s, siguiente);
+            break;
+        }
+        case S_SI:
+        {
+            uint32_t v = fn->bloques[x.bloque].suc[0], f = fn->bloques[x.bloque].suc[1];
+            std::string cc;
+            if (fusionada[x.a])
+                cc = comparar(x.a);
+            else if (fn->ins[x.a].tipo == D_FLOAT)
+            {
+                // distinto de 0.0, o NaN
+                linea("xorps xmm15, xmm15");
+                linea("ucomiss xmm15, " + op(x.a));
+                linea("jp " + bloque(v));
+                cc = "ne";
+            }
+            else
+            {
+                std::string a = op(x.a);
+                if (esInmediato(a))
+                {
+                    salto(a != "0" ? v : f, siguiente);
+                    break;
+                }
+                linea("cmp " + a + ", 0");
+                cc = "ne";
+            }
+            if (v == siguiente)
+                linea("j" + negar(cc) + " " + bloque(f));
+            else
+            {
+                linea("j" + cc + " " + bloque(v));
+                salto(f, siguiente);
+            }
+            break;
+        }
+        case S_REGRESA:
+            regresar(x);
+            break;
+        default:
+            break;
+        }
+    }
+
+    void funcion(FuncionSsa &f, uint32_t numero)
+    {
+        fn = &f;
+        numeroFuncion = numero;
+        f.simplificarPhis();
+        f.partirAristas();
+        marcarFusiones();
+        vida.calcular(f, [&](const InsSsa &x, const uint32_t &a) { return enRegistro(x, a); });
+        asignarLugares();
+
+        etiqueta(nombres[numero]);
+        linea("push rbp");
+        linea("mov rbp, rsp");
+        for (uint32_t r = 0; r < CONSERVADOS; ++r)
+            if (conservadoUsado[r])
+                linea(std::string("push ") + enteros64[r]);
+        marco = 8 * ranuras;
+        if ((8 * conservados + marco) % 16)
+            marco += 8;
+        if (marco)
+            linea("sub rsp, " + std::to_string(marco));
+
+        // los parámetros pasan de donde los dejó quien llama a su lugar
+        std::vector<TipoDato> tipos(f.parametros, D_INT);
+        for (uint32_t i : f.bloques[0].ins)
+            if (f.ins[i].op == S_PARAM)
+                tipos[f.ins[i].k] = f.ins[i].tipo;
+        std::vector<Copia> copias;
+        for (uint32_t i : f.bloques[0].ins)
+            if (f.ins[i].op == S_PARAM && vida.usos[i])
+                copias.push_back(Copia{f.ins[i].tipo, op(i), lugarArgumento(tipos, f.ins[i].k, true)});
+        copiasParalelas(copias);
+
+        for (size_t k = 0; k < vida.orden.size(); ++k)
+        {
+            uint32_t b = vida.orden[k];
+            uint32_t siguiente = k + 1 < vida.orden.size() ? vida.orden[k + 1] : NINGUNO;
+            etiqueta(bloque(b));
+            for (uint32_t i : f.bloques[b].ins)
+                instruccion(i, siguiente);
+        }
+    }
+
+    void cadenas()
+    {
+        for (size_t k = 0; k < prog->cadenas.size(); ++k)
+        {
+            *out << ".LC" << k << ":";
+            const std::string &s = prog->cadenas[k];
+            for (size_t i = 0; i < s.size(); ++i)
+                *out << (i % 16 ? "," : "\n    .byte ") << unsigned((unsigned char)s[i]);
+            *out << "\n";
+        }
+        *out << "    .align 4\n";
+        for (auto [bits, k] : reales)
+            *out << ".LR" << k << ":\n    .long " << uint32_t(bits) << "\n";
+    }
+
+    /// El punto de entrada y las rutinas de printI, printS y los errores, con llamadas directas al sistema
+    void rutinas(TipoDato retornoMain, size_t parametrosMain)
+    {
+        static const char *const texto = R"(
+# printI: escribe eax en decimal; conserva todo menos rax
+rt.printi:
+    push rcx
+    push rdx
+    push rsi
+    push rdi
+    push r8
+    push r9
+    sub rsp, 24
+    movsxd rcx, eax
+    mov r8, rcx
+    neg r8
+    cmovs r8, rcx
+    lea rsi, [rsp+24]
+    mov r9d, 10
+1:
+    mov rax, r8
+    xor edx, edx
+    div r9
+    add dl, 48
+    dec rsi
+    mov BYTE PTR [rsi], dl
+    mov r8, rax
+    test rax, rax
+    jnz 1b
+    test rcx, rcx
+    jns 2f
+    dec rsi
+    mov BYTE PTR [rsi], 45
+2:
+    lea rcx, [rsp+24]
+    sub rcx, rsi
+    call rt.escribir
+    add rsp, 24
+    pop r9
+    pop r8
+    pop rdi
+    pop rsi
+    pop rdx
+    pop rcx
+    ret
+
+# printS: escribe r11 bytes desde rax; conserva todo menos rax
+rt.prints:
+    push rcx
+    push rsi
+    mov rsi, rax
+    mov rcx, r11
+    call rt.escribir
+    pop rsi
+    pop rcx
+    ret
+
+# copia rcx bytes desde rsi al búfer; cambia rcx y rsi
+rt.escribir:
+    push rax
+    push rdx
+    push rdi
+    push r11
+    mov rax, QWORD PTR rt.usados[rip]
+    lea rdx, [rax+rcx]
+    cmp rdx, 65536
+    jbe 1f
+    call rt.vaciar
+    xor eax, eax
+    cmp rcx, 65536
+    jbe 1f
+    mov edi, 1
+    mov rdx, rcx
+    call rt.write
+    jmp 2f
+1:
+    lea rdi, rt.bufer[rip]
+    add rdi, rax
+    add rax, rcx
+    mov QWORD PTR rt.usados[rip], rax
+    rep movsb
+2:
+    pop r11
+    pop rdi
+    pop rdx
+    pop rax
+    ret
+
+# vacía el búfer en la salida estándar; conserva todo
+rt.vaciar:
+    push rax
+    push rcx
+    push rdx
+    push rsi
+    push rdi
+    push r11
+    mov edi, 1
+    lea rsi, rt.bufer[rip]
+    mov rdx, QWORD PTR rt.usados[rip]
+    call rt.write
+    mov QWORD PTR rt.usados[rip], 0
+    pop r11
+    pop rdi
+    pop rsi
+    pop rdx
+    pop rcx
+    pop rax
+    ret
+
+# write(edi, rsi, rdx) hasta escribir todo; cambia rax, rcx, rdx, rsi y r11
+rt.write:
+    test rdx, rdx
+    jz 1f
+    mov eax, 1
+    syscall
+    test rax, rax
+    jle 1f
+    add rsi, rax
+    sub rdx, rax
+    jmp rt.write
+1:
+    ret
+
+# división entera entre cero: el mismo mensaje que ejecutar y termina con 1
+rt.division:
+    call rt.vaciar
+    mov edi, 2
+    lea rsi, rt.mensaje[rip]
+    mov edx, OFFSET rt.finMensaje - rt.mensaje
+    call rt.write
+    mov edi, 1
+    mov eax, 231
+    syscall
+
+    .section .rodata
+rt.mensaje:
+    .ascii "Error de ejecuci\303\263n: divisi\303\263n entre cero\n"
+rt.finMensaje:
+    .align 16
+.LSIGNO:
+    .long 0x80000000, 0, 0, 0
+
+    .bss
+    .align 16
+rt.usados:
+    .zero 8
+rt.bufer:
+    .zero 65536
+)";
+        // main recibe sus parámetros en 0, como en maquina.h, y su resultado es el código de salida
+        *out << "\n    .text\n    .globl rt.inicio\nrt.inicio:\n";
+        linea("xor ebp, ebp");
+        size_t enPila = parametrosMain > 6 ? parametrosMain : 0; // de sobra
+        if (enPila % 2)
+            linea("push 0");
+        for (size_t k = 0; k < enPila; ++k)
+            linea("push 0");
+        for (const char *r : argumentosI)
+            linea(std::string("xor ") + r + ", " + r);
+        for (int k = 0; k < 8; ++k)
+            linea("xorps xmm" + std::to_string(k) + ", xmm" + std::to_string(k));
+        linea("call main");
+        if (retornoMain == D_FLOAT)
+            linea("movd eax, xmm0");
+        else if (retornoMain == D_VOID)
+            linea("xor eax, eax");
+        linea("call rt.vaciar");
+        linea("mov edi, eax");
+        linea("mov eax, 231");
+        linea("syscall");
+        *out << texto;
+    }
+
+public:
+    /**
+     * @brief Escribe en salida el ensamblador de p (que se modifica: se parten sus aristas
+     * críticas). El punto de entrada es rt.inicio.
+     * @param lex, ast De donde salen los nombres de las funciones
+     */
+    template <class Lex>
+    void traducir(ProgramaSsa &p, const Lex &lex, const Ast &ast, std::ostream &salida)
+    {
+        TRAZA("TraductorX86::traducir");
+        prog = &p;
+        out = &salida;
+        // las funciones van con un prefijo que no puede tener un identificador, para que no
+        // se confundan con un registro (una función eax) ni con las rutinas de rt.
+        nombres.assign(p.funciones.size(), "");
+        for (size_t f = 0; f < p.funciones.size(); ++f)
+            if (p.funciones[f].viva)
+                nombres[f] = f == p.principal ? "main" : "f." + std::string(lex.texto(ast.token(p.funciones[f].nodo)));
+        reales.clear();
+        etiquetas = 0;
+        salida << "    .intel_syntax noprefix\n    .text\n";
+        salida << "    .globl main\n";
+        for (uint32_t f = 0; f < p.funciones.size(); ++f)
+            if (p.funciones[f].viva)
+            {
+                salida << "\n";
+                funcion(p.funciones[f], f);
+            }
+        size_t parametrosMain = p.funciones[p.principal].parametros;
+        rutinas(p.funciones[p.principal].retorno, parametrosMain);
+        salida << "    .section .rodata\n";
+        cadenas();
+        salida << "    .section .note.GNU-stack,\"\",@progbits\n";
+    }
+};
+
+#endif
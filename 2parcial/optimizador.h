@@ -0,0 +1,603 @@
+/**
+ * @file    optimizador.h
+ * @version 1.0
+ * @date    19/10/2026
+ * @title   Optimizador
+ * @brief   Pasos de optimización sobre la forma SSA de ssa.h, en este orden:
+ *
+ *          1. En línea: las llamadas a funciones hoja pequeñas (un solo bloque, sin llamadas,
+ *             como suma) se sustituyen por una copia de su cuerpo.
+ *          2. Propagación de constantes condicional dispersa (Wegman y Zadeck, 1991): calcula
+ *             a la vez qué valores son constantes y qué bloques se pueden ejecutar, así que
+ *             también elimina las ramas de if y while con condición constante.
+ *          3. Código muerto: quita las instrucciones sin efectos cuyo valor nadie usa, junta los
+ *             bloques encadenados y elimina las funciones que no se llaman desde main según el
+ *             grafo de llamadas.
+ *          4. Invariantes de ciclos: las instrucciones sin efectos de un while cuyos operandos
+ *             se calculan fuera del ciclo se mueven antes de él.
+ *
+ *          Después de cada paso se guarda cuántas instrucciones SSA quedan.
+ */
+
+#ifndef OPTIMIZADOR_H
+#define OPTIMIZADOR_H
+
+#include "ssa.h"
+
+class Optimizador
+{
+public:
+    struct Paso
+    {
+        const char *nombre;
+        /// Instrucciones SSA de las funciones vivas después del paso
+        size_t instrucciones;
+        /// Lo que hizo el paso: llamadas sustituidas, valores constantes, instrucciones
+        /// eliminadas o instrucciones movidas fuera de ciclos
+        size_t cambios;
+    };
+
+    /// Funciones con más instrucciones que esto no se sustituyen en línea
+    size_t limiteEnLinea = 24;
+
+private:
+    std::vector<Paso> pasos;
+
+    void registrar(ProgramaSsa &p, const char *nombre, size_t cambios)
+    {
+        pasos.push_back(Paso{nombre, p.contar(), cambios});
+    }
+
+    static bool enLineable(const FuncionSsa &f, size_t limite)
+    {
+        if (!f.viva || f.contar() > limite)
+            return false;
+        for (size_t b = 1; b < f.bloques.size(); ++b)
+            if (f.bloques[b].vivo)
+                return false;
+        for (uint32_t i : f.bloques[0].ins)
+            if (f.ins[i].op == S_LLAMA)
+                return false;
+        return true;
+    }
+
+    size_t enLinea(ProgramaSsa &p)
+    {
+        size_t total = 0;
+        // cada ronda puede dejar como hojas a funciones que solo llamaban hojas
+        for (int ronda = 0; ronda < 4; ++ronda)
+        {
+            std::vector<char> candidata(p.funciones.size());
+            for (size_t f = 0; f < p.funciones.size(); ++f)
+                candidata[f] = enLineable(p.funciones[f], limiteEnLinea);
+            size_t n = 0;
+            for (size_t g = 0; g < p.funciones.size(); ++g)
+            {
+                FuncionSsa &fn = p.funciones[g];
+                if (!fn.viva)
+                    continue;
+                bool cambio = false;
+                for (uint32_t b = 0; b < fn.bloques.size(); ++b)
+                {
+                    std::vector<uint32_t> lista;
+                    for (uint32_t i : fn.bloques[b].ins)
+                    {
+                        if (fn.ins[i].op != S_LLAMA || !candidata[fn.ins[i].k] || uint32_t(fn.ins[i].k) == g)
+                        {
+                            lista.push_back(i);
+                            continue;
+                        }
+                        const FuncionSsa &callee = p.funciones[fn.ins[i].k];
+                        std::vector<uint32_t> mapa(callee.ins.size(), NINGUNO);
+                        uint32_t resultado = NINGUNO;
+                        for (uint32_t j : callee.bloques[0].ins)
+                        {
+                            const InsSsa &x = callee.ins[j];
+                            if (x.op == S_PARAM)
+                            {
+                                mapa[j] = fn.ins[i].args[x.k];
+                                continue;
+                            }
+                            if (x.op == S_REGRESA)
+                            {
+                                if (x.a != NINGUNO)
+                                    resultado = mapa[x.a];
+                                break;
+                            }
+                            InsSsa copia = x;
+                            copia.bloque = b;
+                            FuncionSsa::operandos(copia, [&](uint32_t &a) { a = mapa[a]; });
+                            mapa[j] = fn.nuevaIns(copia);
+                            lista.push_back(mapa[j]);
+                        }
+                        if (resultado != NINGUNO)
+                            fn.reemplazar(i, resultado);
+                        else
+                            fn.ins[i].op = S_NADA;
+                        ++n;
+                        cambio = true;
+                    }
+                    fn.bloques[b].ins = std::move(lista);
+                }
+                if (cambio)
+                    fn.normalizar();
+            }
+            total += n;
+            if (!n)
+                break;
+        }
+        return total;
+    }
+
+    enum Estado : unsigned char
+    {
+        ARRIBA, // todavía sin valor conocido
+        CONSTANTE,
+        ABAJO   // no es constante
+    };
+
+    /// Calcula la instrucción x con operandos constantes; false si no se puede (división entre 0)
+    static bool evaluar(const InsSsa &x, const FuncionSsa &f, const std::vector<int32_t> &valor, int32_t &r)
+    {
+        int32_t a = x.a != NINGUNO ? valor[x.a] : 0, b = x.b != NINGUNO ? valor[x.b] : 0;
+        bool real = x.a != NINGUNO && f.ins[x.a].tipo == D_FLOAT;
+        float fa, fb;
+        memcpy(&fa, &a, 4);
+        memcpy(&fb, &b, 4);
+        auto flotante = [&](float v) {
+            memcpy(&r, &v, 4);
+            return true;
+        };
+        switch (x.op)
+        {
+        case S_SUMA:
+            return real ? flotante(fa + fb) : (r = int32_t(uint32_t(a) + uint32_t(b)), true);
+        case S_RESTA:
+            return real ? flotante(fa - fb) : (r = int32_t(uint32_t(a) - uint32_t(b)), true);
+        case S_MUL:
+            return real ? flotante(fa * fb) : (r = int32_t(uint32_t(a) * uint32_t(b)), true);
+        case S_DIV:
+            if (real)
+                return flotante(fa / fb);
+            if (b == 0)
+                return false;
+            r = b == -1 ? int32_t(0u - uint32_t(a)) : a / b;
+            return true;
+        case S_MENOR:
+            r = real ? fa < fb : a < b;
+            return true;
+        case S_MAYOR:
+            r = real ? fa > fb : a > b;
+            return true;
+        case S_MENORIG:
+            r = real ? fa <= fb : a <= b;
+            return true;
+        case S_MAYORIG:
+            r = real ? fa >= fb : a >= b;
+            return true;
+        case S_IGUAL:
+            r = real ? fa == fb : a == b;
+            return true;
+        case S_DIST:
+            r = real ? fa != fb : a != b;
+            return true;
+        case S_NEG:
+            return real ? flotante(-fa) : (r = int32_t(0u - uint32_t(a)), true);
+        case S_NOT:
+            r = real ? fa == 0.0f : a == 0;
+            return true;
+        case S_LOG:
+            r = real ? fa != 0.0f : a != 0;
+            return true;
+        case S_AF:
+            return flotante(float(a));
+        default:
+            return false;
+        }
+    }
+
+    size_t constantes(FuncionSsa &f)
+    {
+        size_t n = f.ins.size(), nb = f.bloques.size();
+        std::vector<Estado> estado(n, ARRIBA);
+        std::vector<int32_t> valor(n, 0);
+        std::vector<std::vector<uint32_t>> usuarios(n);
+        for (const BloqueSsa &b : f.bloques)
+            for (uint32_t i : b.ins)
+                FuncionSsa::operandos(f.ins[i], [&](uint32_t &a) { usuarios[a].push_back(i); });
+        std::vector<char> alcanzado(nb, 0);
+        std::vector<std::vector<char>> ejecutable(nb);
+        for (size_t b = 0; b < nb; ++b)
+            ejecutable[b].assign(f.bloques[b].pred.size(), 0);
+        std::vector<std::pair<uint32_t, uint32_t>> aristas = {{NINGUNO, 0}};
+        std::vector<uint32_t> valores;
+
+        auto fijar = [&](uint32_t i, Estado e, int32_t v) {
+            if (estado[i] == e && (e != CONSTANTE || valor[i] == v))
+                return;
+            estado[i] = e;
+            valor[i] = v;
+            valores.push_back(i);
+        };
+        auto visitar = [&](uint32_t i) {
+            const InsSsa &x = f.ins[i];
+            const BloqueSsa &B = f.bloques[x.bloque];
+            switch (x.op)
+            {
+            case S_CONST:
+                fijar(i, CONSTANTE, x.k);
+                break;
+            case S_PARAM:
+            case S_LLAMA:
+                if (x.tipo != D_VOID)
+                    fijar(i, ABAJO, 0);
+                break;
+            case S_PHI:
+            {
+                Estado e = ARRIBA;
+                int32_t v = 0;
+                for (size_t j = 0; j < x.args.size() && e != ABAJO; ++j)
+                {
+                    if (!ejecutable[x.bloque][j])
+                        continue;
+                    uint32_t a = x.args[j];
+                    if (estado[a] == ABAJO || (estado[a] == CONSTANTE && e == CONSTANTE && valor[a] != v))
+                        e = ABAJO;
+                    else if (estado[a] == CONSTANTE)
+                    {
+                        e = CONSTANTE;
+                        v = valor[a];
+                    }
+                }
+                if (e != ARRIBA)
+                    fijar(i, e, v);
+                break;
+            }
+            case S_SALTA:
+                aristas.push_back({x.bloque, B.suc[0]});
+                break;
+            case S_SI:
+                if (estado[x.a] == ABAJO)
+                {
+                    aristas.push_back({x.bloque, B.suc[0]});
+                    aristas.push_back({x.bloque, B.suc[1]});
+                }
+                else if (estado[x.a] == CONSTANTE)
+                {
+                    // el valor de un float se revisa como float: -0.0 es falso
+                    bool verdad = f.ins[x.a].tipo == D_FLOAT ? (valor[x.a] & 0x7fffffff) != 0 : valor[x.a] != 0;
+                    aristas.push_back({x.bloque, B.suc[verdad ? 0 : 1]});
+                }
+                break;
+            case S_REGRESA:
+            case S_PRINTI:
+            case S_PRINTS:
+            case S_NADA:
+                break;
+            default:
+            {
+                Estado e = CONSTANTE;
+                FuncionSsa::operandos(const_cast<InsSsa &>(x), [&](uint32_t &a) {
+                    if (estado[a] == ABAJO)
+                        e = ABAJO;
+                    else if (estado[a] == ARRIBA && e != ABAJO)
+                        e = ARRIBA;
+                });
+                int32_t r = 0;
+                if (e == CONSTANTE && !evaluar(x, f, valor, r))
+                    e = ABAJO;
+                if (e != ARRIBA)
+                    fijar(i, e, r);
+            }
+            }
+        };
+
+        while (!aristas.empty() || !valores.empty())
+        {
+            while (!aristas.empty())
+            {
+                auto [p, s] = aristas.back();
+                aristas.pop_back();
+                if (p != NINGUNO)
+                {
+                    const std::vector<uint32_t> &pred = f.bloques[s].pred;
+                    size_t j = std::find(pred.begin(), pred.end(), p) - pred.begin();
+                    if (ejecutable[s][j])
+                        continue;
+                    ejecutable[s][j] = 1;
+                }
+                if (!alcanzado[s])
+                {
+                    alcanzado[s] = 1;
+                    for (uint32_t i : f.bloques[s].ins)
+                        visitar(i);
+                }
+                else
+                    for (uint32_t i : f.bloques[s].ins)
+                    {
+                        if (f.ins[i].op != S_PHI)
+                            break;
+                        visitar(i);
+                    }
+            }
+            while (!valores.empty())
+            {
+                uint32_t v = valores.back();
+                valores.pop_back();
+                for (uint32_t u : usuarios[v])
+                    if (alcanzado[f.ins[u].bloque])
+                        visitar(u);
+            }
+        }
+
+        // un if alcanzado con condición aún sin valor dejaría phi con aristas sin revisar: en ese
+        // caso no se cambia nada
+        for (uint32_t b = 0; b < nb; ++b)
+            if (alcanzado[b] && f.ins[f.bloques[b].ins.back()].op == S_SI &&
+                estado[f.ins[f.bloques[b].ins.back()].a] == ARRIBA)
+                return 0;
+
+        // los valores constantes pasan a ser S_CONST y los if constantes, saltos
+        size_t cambios = 0;
+        for (uint32_t b = 0; b < nb; ++b)
+        {
+            if (!alcanzado[b])
+                continue;
+            BloqueSsa &B = f.bloques[b];
+            for (uint32_t i : B.ins)
+            {
+                InsSsa &x = f.ins[i];
+                if (estado[i] == CONSTANTE && x.op != S_CONST && x.tipo != D_VOID)
+                {
+                    x.op = S_CONST;
+                    x.k = valor[i];
+                    x.a = x.b = NINGUNO;
+                    x.args.clear();
+                    ++cambios;
+                }
+                else if (x.op == S_SI && estado[x.a] == CONSTANTE)
+                {
+                    bool verdad = f.ins[x.a].tipo == D_FLOAT ? (valor[x.a] & 0x7fffffff) != 0 : valor[x.a] != 0;
+                    f.quitarArista(b, B.suc[verdad ? 1 : 0]);
+                    x.op = S_SALTA;
+                    x.a = NINGUNO;
+                    ++cambios;
+                }
+            }
+            // las phi que pasaron a constantes quedan después de las demás phi
+            std::stable_partition(B.ins.begin(), B.ins.end(), [&](uint32_t i) { return f.ins[i].op == S_PHI; });
+        }
+        f.normalizar();
+        f.quitarInalcanzables();
+        f.simplificarPhis();
+        return cambios;
+    }
+
+    size_t codigoMuerto(FuncionSsa &f)
+    {
+        std::vector<char> vivo(f.ins.size(), 0);
+        std::vector<uint32_t> pila;
+        for (const BloqueSsa &b : f.bloques)
+            for (uint32_t i : b.ins)
+                if (!f.pura(i) && f.ins[i].op != S_PHI && f.ins[i].op != S_PARAM)
+                {
+                    vivo[i] = 1;
+                    pila.push_back(i);
+                }
+        while (!pila.empty())
+        {
+            uint32_t i = pila.back();
+            pila.pop_back();
+            FuncionSsa::operandos(f.ins[i], [&](uint32_t &a) {
+                if (!vivo[a])
+                {
+                    vivo[a] = 1;
+                    pila.push_back(a);
+                }
+            });
+        }
+        size_t cambios = 0;
+        for (const BloqueSsa &b : f.bloques)
+            for (uint32_t i : b.ins)
+                if (!vivo[i] && f.ins[i].op != S_PARAM)
+                {
+                    f.ins[i].op = S_NADA;
+                    f.ins[i].args.clear();
+                    ++cambios;
+                }
+        f.normalizar();
+
+        // un bloque con un solo sucesor que a su vez tiene un solo predecesor se junta con él
+        for (uint32_t b : f.ordenInverso())
+        {
+            BloqueSsa &B = f.bloques[b];
+            while (B.vivo && B.suc.size() == 1)
+            {
+                uint32_t s = B.suc[0];
+                BloqueSsa &S = f.bloques[s];
+                if (s == b || s == 0 || S.pred.size() != 1 || (!S.ins.empty() && f.ins[S.ins[0]].op == S_PHI))
+                    break;
+                f.ins[B.ins.back()].op = S_NADA;
+                B.ins.pop_back();
+                for (uint32_t i : S.ins)
+                {
+                    f.ins[i].bloque = b;
+                    B.ins.push_back(i);
+                }
+                B.suc = S.suc;
+                for (uint32_t t : S.suc)
+                    std::replace(f.bloques[t].pred.begin(), f.bloques[t].pred.end(), s, b);
+                S = BloqueSsa();
+                S.vivo = false;
+                ++cambios;
+            }
+        }
+        return cambios;
+    }
+
+    /// Quita las funciones que no se alcanzan desde main en el grafo de llamadas
+    size_t funcionesMuertas(ProgramaSsa &p)
+    {
+        std::vector<char> alcanzada(p.funciones.size(), 0);
+        std::vector<uint32_t> pila = {p.principal};
+        alcanzada[p.principal] = 1;
+        while (!pila.empty())
+        {
+            const FuncionSsa &f = p.funciones[pila.back()];
+            pila.pop_back();
+            for (const BloqueSsa &b : f.bloques)
+                for (uint32_t i : b.ins)
+                    if (f.ins[i].op == S_LLAMA && !alcanzada[f.ins[i].k])
+                    {
+                        alcanzada[f.ins[i].k] = 1;
+                        pila.push_back(f.ins[i].k);
+                    }
+        }
+        size_t cambios = 0;
+        for (size_t f = 0; f < p.funciones.size(); ++f)
+            if (!alcanzada[f] && p.funciones[f].viva)
+            {
+                cambios += p.funciones[f].contar();
+                p.funciones[f] = FuncionSsa();
+                p.funciones[f].viva = false;
+            }
+        return cambios;
+    }
+
+    size_t invariantes(FuncionSsa &f)
+    {
+        std::vector<uint32_t> orden = f.ordenInverso();
+        size_t nb = f.bloques.size();
+        std::vector<uint32_t> numero(nb, NINGUNO), idom(nb, NINGUNO);
+        for (size_t k = 0; k < orden.size(); ++k)
+            numero[orden[k]] = k;
+
+        // dominadores inmediatos (Cooper, Harvey y Kennedy)
+        idom[0] = 0;
+        auto interseccion = [&](uint32_t a, uint32_t b) {
+            while (a != b)
+            {
+                while (numero[a] > numero[b])
+                    a = idom[a];
+                while (numero[b] > numero[a])
+                    b = idom[b];
+            }
+            return a;
+        };
+        for (bool cambio = true; cambio;)
+        {
+            cambio = false;
+            for (size_t k = 1; k < orden.size(); ++k)
+            {
+                uint32_t b = orden[k], nuevo = NINGUNO;
+                for (uint32_t p : f.bloques[b].pred)
+                    if (idom[p] != NINGUNO)
+                        nuevo = nuevo == NINGUNO ? p : interseccion(p, nuevo);
+                if (idom[b] != nuevo)
+                {
+                    idom[b] = nuevo;
+                    cambio = true;
+                }
+            }
+        }
+        auto domina = [&](uint32_t a, uint32_t b) {
+            while (b != a && b != 0)
+                b = idom[b];
+            return b == a;
+        };
+
+        size_t cambios = 0;
+        std::vector<char> enCiclo(nb, 0);
+        for (uint32_t h : orden)
+        {
+            std::vector<uint32_t> cuerpo, pila;
+            for (uint32_t t : f.bloques[h].pred)
+                if (domina(h, t))
+                    pila.push_back(t);
+            if (pila.empty())
+                continue;
+            std::fill(enCiclo.begin(), enCiclo.end(), 0);
+            enCiclo[h] = 1;
+            cuerpo.push_back(h);
+            while (!pila.empty())
+            {
+                uint32_t b = pila.back();
+                pila.pop_back();
+                if (enCiclo[b])
+                    continue;
+                enCiclo[b] = 1;
+                cuerpo.push_back(b);
+                for (uint32_t p : f.bloques[b].pred)
+                    pila.push_back(p);
+            }
+            // el bloque previo al ciclo: el único predecesor de la cabeza fuera del ciclo
+            uint32_t previo = NINGUNO;
+            size_t fuera = 0;
+            for (uint32_t p : f.bloques[h].pred)
+                if (!enCiclo[p])
+                {
+                    previo = p;
+                    ++fuera;
+                }
+            if (fuera != 1 || f.bloques[previo].suc.size() != 1)
+                continue;
+            std::sort(cuerpo.begin(), cuerpo.end(), [&](uint32_t a, uint32_t b) { return numero[a] < numero[b]; });
+
+            for (uint32_t b : cuerpo)
+            {
+                std::vector<uint32_t> &l = f.bloques[b].ins;
+                size_t j = 0;
+                for (uint32_t i : l)
+                {
+                    bool invariante = f.pura(i);
+                    FuncionSsa::operandos(f.ins[i], [&](uint32_t &a) { invariante = invariante && !enCiclo[f.ins[a].bloque]; });
+                    if (!invariante)
+                    {
+                        l[j++] = i;
+                        continue;
+                    }
+                    std::vector<uint32_t> &destino = f.bloques[previo].ins;
+                    destino.insert(destino.end() - 1, i);
+                    f.ins[i].bloque = previo;
+                    ++cambios;
+                }
+                l.resize(j);
+            }
+        }
+        return cambios;
+    }
+
+public:
+    /// Optimiza p en el lugar
+    void optimizar(ProgramaSsa &p)
+    {
+        TRAZA("Optimizador::optimizar");
+        pasos.clear();
+        registrar(p, "construcción", 0);
+        registrar(p, "en línea", enLinea(p));
+        size_t n = 0;
+        for (FuncionSsa &f : p.funciones)
+            if (f.viva)
+                n += constantes(f);
+        registrar(p, "constantes", n);
+        n = 0;
+        for (FuncionSsa &f : p.funciones)
+            if (f.viva)
+                n += codigoMuerto(f);
+        n += funcionesMuertas(p);
+        registrar(p, "código muerto", n);
+        n = 0;
+        for (FuncionSsa &f : p.funciones)
+            if (f.viva)
+                n += invariantes(f);
+        registrar(p, "invariantes", n);
+    }
+
+    /// Instrucciones después de cada paso de la última optimización
+    const std::vector<Paso> &estadisticas() const
+    {
+        return pasos;
+    }
+};
+
+#endif
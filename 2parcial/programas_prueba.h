@@ -0,0 +1,179 @@
+/**
+ * @file    programas_prueba.h
+ * @version 1.0
+ * @date    19/10/2026
+ * @title   Programas de prueba
+ * @brief   Programas con ciclos while, llamadas recursivas y anidadas y aritmética de int y float,
+ *          con lo que cada uno debe escribir. Los usan bench_maquina.cpp y bench_nativo.cpp.
+ */
+
+#ifndef PROGRAMAS_PRUEBA_H
+#define PROGRAMAS_PRUEBA_H
+
+struct Prueba
+{
+    const char *nombre;
+    const char *fuente;
+    const char *esperado;
+};
+
+inline const Prueba pruebas[] = {
+    {"ciclo", R"(
+int main()
+{
+    int i = 0, n = 100000000, s = 0;
+    while (i < n)
+    {
+        s = s + i;
+        i = i + 1;
+    }
+    printI(s);
+    return 0;
+}
+)",
+     "887459712"},
+    {"suma recursiva", R"(
+int suma(int n)
+{
+    if (n == 0)
+        return 0;
+    return n + suma(n - 1);
+}
+
+int main()
+{
+    int k = 0, s = 0;
+    while (k < 2000)
+    {
+        s = s + suma(10000);
+        k = k + 1;
+    }
+    printI(s);
+    return 0;
+}
+)",
+     "1225752192"},
+    {"fib", R"(
+int fib(int n)
+{
+    if (n < 2)
+        return n;
+    return fib(n - 1) + fib(n - 2);
+}
+
+int main()
+{
+    printI(fib(32));
+    return 0;
+}
+)",
+     "2178309"},
+    {"integral (float)", R"(
+float f(float x)
+{
+    return 4.0 / (1.0 + x * x);
+}
+
+int main()
+{
+    int i = 0, j, n = 3000;
+    float h = 1.0 / (n * n), s = 0.0, parcial;
+    while (i < n)
+    {
+        parcial = 0.0;
+        j = 0;
+        while (j < n)
+        {
+            parcial = parcial + f((i * n + j + 0.5) * h);
+            j = j + 1;
+        }
+        s = s + parcial * h;
+        i = i + 1;
+    }
+    if (s > 3.1415 && s < 3.1417)
+        printS("pi");
+    else
+        printS("no es pi");
+    return 0;
+}
+)",
+     "pi"},
+    {"collatz (int)", R"(
+int pasos(int n)
+{
+    int p = 0;
+    while (n != 1)
+    {
+        if (n - n / 2 * 2 == 0)
+            n = n / 2;
+        else
+            n = 3 * n + 1;
+        p = p + 1;
+    }
+    return p;
+}
+
+int main()
+{
+    int i = 1, total = 0;
+    while (i < 100000)
+    {
+        total = total + pasos(i);
+        i = i + 1;
+    }
+    printI(total);
+    return 0;
+}
+)",
+     "10753712"},
+    {"suma en línea", R"(
+int suma(int a, int b)
+{
+    return a + b;
+}
+
+int main()
+{
+    int i = 0, n = 20000000, s = 0, k = 7;
+    while (i < n)
+    {
+        s = suma(s, k * 3);
+        i = suma(i, 1);
+    }
+    printI(s);
+    return 0;
+}
+)",
+     "420000000"},
+    {"llamadas anidadas", R"(
+int cuadrado(int x)
+{
+    return x * x;
+}
+
+int suma(int a, int b)
+{
+    return a + b;
+}
+
+int distancia(int a, int b)
+{
+    return suma(cuadrado(a), cuadrado(b));
+}
+
+int main()
+{
+    int i = 0, s = 0;
+    while (i < 30000000)
+    {
+        s = s + distancia(i, 3) - i * i;
+        i = i + 1;
+    }
+    printI(s);
+    return 0;
+}
+)",
+     "270000000"},
+};
+
+#endif
@@ -0,0 +1,39 @@
+/**
+ * @file    real.h
+ * @version 1.0
+ * @date    19/10/2026
+ * @title   Conversión de literales numéricos
+ * @brief   Convierte literales reales y enteros directamente desde los bytes del
+ *          código fuente, con redondeo correcto y sin cadenas intermedias.
+ *
+ */
+
+#ifndef REAL_H
+#define REAL_H
+
+#include <charconv>
+#include <system_error>
+
+/**
+ * @brief Convierte el literal [ini, fin) a double usando std::from_chars (algoritmo
+ * Eisel-Lemire en libstdc++ >= 12), que redondea al double más cercano igual que strtod
+ * pero sin depender del locale ni requerir terminador nulo.
+ *
+ * Acepta <exp real> en sus formas d+.d+, d+. y .d+ además de enteros; rechaza el signo, el
+ * exponente, inf y nan (que from_chars sí aceptaría), que no forman parte de los literales
+ * del lenguaje.
+ *
+ * @param ini Primer caracter del literal
+ * @param fin Posición siguiente al último caracter del literal
+ * @param valor Resultado de la conversión
+ * @return true si todo el rango es un literal válido y representable | false en otro caso
+ */
+inline bool aReal(const char *ini, const char *fin, double &valor)
+{
+    if (ini == fin || !((*ini >= '0' && *ini <= '9') || *ini == '.'))
+        return false;
+    std::from_chars_result r = std::from_chars(ini, fin, valor, std::chars_format::fixed);
+    return r.ec == std::errc() && r.ptr == fin;
+}
+
+#endif
@@ -0,0 +1,553 @@
+/**
+ * @file    semantico.h
+ * @version 1.0
+ * @date    19/10/2026
+ * @title   Análisis semántico
+ * @brief   Revisa el árbol que construye Sintactico: las variables se declaran antes de usarse y
+ *          una sola vez por ámbito, las funciones se definen una vez y se llaman con sus
+ *          argumentos, a un int no se le asigna un float, las cadenas no se operan, los return
+ *          corresponden al tipo de la función y existe main.
+ *
+ *          La tabla de símbolos usa como claves los números de símbolo del internador, en tablas
+ *          hash de direccionamiento abierto. Los bloques no tienen tabla propia: cada declaración
+ *          apunta a la que oculta y guarda el número de serie de su ámbito, así que cerrar un
+ *          bloque solo saca su serie de la pila y las declaraciones que quedan muertas se saltan
+ *          al buscar.
+ *
+ *          Además anota el árbol para las etapas siguientes (bytecode.h): el tipo de cada
+ *          expresión y variable, y la declaración o función a la que se refiere cada nombre.
+ */
+
+#ifndef SEMANTICO_H
+#define SEMANTICO_H
+
+#include <ostream>
+#include <string>
+#include <vector>
+#include "lexico.h"
+#include "lexico.cpp"
+#include "ast.h"
+
+enum TipoDato : unsigned char
+{
+    D_ERROR, // expresión con un error ya reportado
+    D_VOID,
+    D_INT,
+    D_FLOAT,
+    D_CADENA
+};
+
+const char nombreDato[5][7] = {"error", "void", "int", "float", "cadena"};
+
+/// Funciones predefinidas, en el orden en que se registran
+enum Predefinida
+{
+    P_PRINTI,
+    P_PRINTS
+};
+
+/// Enlace de una llamada a la función predefinida k (las demás enlazan a su nodo N_FUNCION)
+#define PREDEFINIDA(k) (NINGUNO - 1 - (k))
+
+/**
+ * @brief Tabla hash de direccionamiento abierto (sondeo lineal) de símbolo a un valor de 32 bits.
+ * Se vacía sin liberar memoria para el siguiente archivo.
+ */
+class TablaSimbolos
+{
+    struct Casilla
+    {
+        uint32_t clave, valor;
+    };
+    std::vector<Casilla> casillas = std::vector<Casilla>(64, Casilla{SIN_SIMBOLO, 0});
+    unsigned bits = 6;
+    uint32_t usadas = 0;
+
+    size_t posicion(uint32_t clave) const
+    {
+        return (clave * 0x9E3779B97F4A7C15ULL) >> (64 - bits);
+    }
+
+    void crecer()
+    {
+        std::vector<Casilla> vieja(casillas.size() * 2, Casilla{SIN_SIMBOLO, 0});
+        vieja.swap(casillas);
+        ++bits;
+        for (const Casilla &c : vieja)
+            if (c.clave != SIN_SIMBOLO)
+            {
+                size_t i = posicion(c.clave);
+                while (casillas[i].clave != SIN_SIMBOLO)
+                    i = (i + 1) & (casillas.size() - 1);
+                casillas[i] = c;
+            }
+    }
+
+public:
+    /// Valor de clave, SIN_SIMBOLO si no está
+    uint32_t buscar(uint32_t clave) const
+    {
+        for (size_t i = posicion(clave);; i = (i + 1) & (casillas.size() - 1))
+        {
+            if (casillas[i].clave == clave)
+                return casillas[i].valor;
+            if (casillas[i].clave == SIN_SIMBOLO)
+                return SIN_SIMBOLO;
+        }
+    }
+
+    void asignar(uint32_t clave, uint32_t valor)
+    {
+        if ((usadas + 1) * 2 > casillas.size())
+            crecer();
+        size_t i = posicion(clave);
+        while (casillas[i].clave != SIN_SIMBOLO && casillas[i].clave != clave)
+            i = (i + 1) & (casillas.size() - 1);
+        usadas += casillas[i].clave == SIN_SIMBOLO;
+        casillas[i] = Casilla{clave, valor};
+    }
+
+    void limpiar()
+    {
+        if (usadas)
+            std::fill(casillas.begin(), casillas.end(), Casilla{SIN_SIMBOLO, 0});
+        usadas = 0;
+    }
+};
+
+class Semantico
+{
+    struct Variable
+    {
+        /// Declaración del mismo nombre que esta oculta (SIN_SIMBOLO si no hay)
+        uint32_t anterior;
+        /// Serie y nivel del ámbito donde se declaró
+        uint32_t serie, nivel;
+        TipoDato tipo;
+        /// Nodo N_VARIABLE o N_PARAMETRO de la declaración
+        Indice nodo;
+    };
+
+    struct Funcion
+    {
+        TipoDato retorno;
+        /// Tipos de los parámetros: parametros[primero .. primero + n)
+        uint32_t primero, n;
+        /// Nodo N_FUNCION, o NINGUNO en las funciones predefinidas
+        Indice nodo;
+    };
+
+    const Lexico &lex;
+    Internador &internador;
+    std::ostream &salida;
+    const Ast *ast = nullptr;
+
+    /// símbolo -> última declaración de ese nombre en variables
+    TablaSimbolos tablaVariables;
+    std::vector<Variable> variables;
+    /// Serie de cada ámbito abierto; el nivel de un ámbito es su posición en la pila
+    std::vector<uint32_t> ambitos;
+    uint32_t series = 0;
+
+    /// símbolo -> índice en funciones
+    TablaSimbolos tablaFunciones;
+    std::vector<Funcion> funciones;
+    std::vector<TipoDato> parametros;
+    TipoDato retornoActual = D_VOID;
+    /// Tipos de los argumentos de las llamadas que se están revisando
+    std::vector<TipoDato> args;
+
+    /// Anotaciones del árbol, por nodo
+    std::vector<TipoDato> tipos;
+    std::vector<Indice> enlaces;
+
+    unsigned errores = 0;
+
+    static TipoDato dato(Tipo t)
+    {
+        return t == T_INT ? D_INT : t == T_FLOAT ? D_FLOAT : D_VOID;
+    }
+
+    /// Símbolo de un identificador; los tokens sin símbolo (léxico sin internador) se internan aquí
+    uint32_t simbolo(const Token &t)
+    {
+        if (t.sym != SIN_SIMBOLO)
+            return t.sym;
+        std::string_view s = lex.texto(t);
+        return internador.internar(s.data(), s.size());
+    }
+
+    void reportar(const Token &t, const std::string &que)
+    {
+        salida << lex.linea(t) << " : " << lex.texto(t) << " : " << que << "\n";
+        ++errores;
+    }
+
+    /// Primer token del subárbol de n, para ubicar los errores de nodos sin token propio
+    const Token &tokenDe(Indice n) const
+    {
+        while ((*ast)[n].token == NINGUNO && (*ast)[n].hijo != NINGUNO)
+            n = (*ast)[n].hijo;
+        return ast->token(n);
+    }
+
+    bool viva(const Variable &v) const
+    {
+        return v.nivel < ambitos.size() && ambitos[v.nivel] == v.serie;
+    }
+
+    /// Declaración visible de id, o SIN_SIMBOLO
+    uint32_t buscar(uint32_t id)
+    {
+        uint32_t v = tablaVariables.buscar(id);
+        uint32_t primera = v;
+        while (v != SIN_SIMBOLO && !viva(variables[v]))
+            v = variables[v].anterior;
+        // las declaraciones muertas del principio de la cadena ya no se vuelven a recorrer
+        if (v != primera)
+            tablaVariables.asignar(id, v);
+        return v;
+    }
+
+    void abrirAmbito()
+    {
+        ambitos.push_back(series++);
+    }
+
+    void cerrarAmbito()
+    {
+        ambitos.pop_back();
+    }
+
+    void declarar(Indice n, TipoDato tipo)
+    {
+        const Token &t = ast->token(n);
+        uint32_t id = simbolo(t);
+        uint32_t v = buscar(id);
+        if (v != SIN_SIMBOLO && variables[v].nivel == ambitos.size() - 1)
+        {
+            reportar(t, "variable ya declarada en la línea " +
+                            std::to_string(lex.linea(ast->token(variables[v].nodo))));
+            return;
+        }
+        variables.push_back(Variable{v, ambitos.back(), uint32_t(ambitos.size() - 1), tipo, n});
+        tipos[n] = tipo;
+        tablaVariables.asignar(id, variables.size() - 1);
+    }
+
+    /// valor se puede guardar en una variable de tipo destino (un int se convierte en float)
+    static bool asignable(TipoDato destino, TipoDato valor)
+    {
+        return valor == D_ERROR || destino == D_ERROR || valor == destino || (destino == D_FLOAT && valor == D_INT);
+    }
+
+    void predefinida(const char *nombre, TipoDato parametro)
+    {
+        uint32_t id = internador.internar(nombre, strlen(nombre));
+        tablaFunciones.asignar(id, funciones.size());
+        funciones.push_back(Funcion{D_VOID, uint32_t(parametros.size()), 1, NINGUNO});
+        parametros.push_back(parametro);
+    }
+
+    TipoDato llamada(Indice n)
+    {
+        const Token &t = ast->token(n);
+        uint32_t f = tablaFunciones.buscar(simbolo(t));
+        // los tipos de los argumentos se apilan en args, que comparten las llamadas anidadas
+        size_t base = args.size();
+        for (Indice a = (*ast)[n].hijo; a != NINGUNO; a = (*ast)[a].hermano)
+        {
+            TipoDato tipo = expresion(a);
+            args.push_back(tipo);
+        }
+        size_t nargs = args.size() - base;
+        TipoDato r = D_ERROR;
+        if (f == SIN_SIMBOLO)
+            reportar(t, "función no definida");
+        else if (nargs != funciones[f].n)
+        {
+            reportar(t, "se esperaban " + std::to_string(funciones[f].n) + " argumentos y hay " + std::to_string(nargs));
+            r = funciones[f].retorno;
+        }
+        else
+        {
+            const Funcion &fn = funciones[f];
+            Indice a = (*ast)[n].hijo;
+            for (uint32_t k = 0; k < fn.n; ++k, a = (*ast)[a].hermano)
+                if (!asignable(parametros[fn.primero + k], args[base + k]))
+                    reportar(tokenDe(a), "el argumento " + std::to_string(k + 1) + " es " + nombreDato[args[base + k]] +
+                                             " y se esperaba " + nombreDato[parametros[fn.primero + k]]);
+            r = fn.retorno;
+            enlaces[n] = fn.nodo == NINGUNO ? PREDEFINIDA(f) : fn.nodo;
+        }
+        args.resize(base);
+        return r;
+    }
+
+    TipoDato expresion(Indice n)
+    {
+        return tipos[n] = tipoExpresion(n);
+    }
+
+    TipoDato tipoExpresion(Indice n)
+    {
+        const Nodo &x = (*ast)[n];
+        switch (x.tipo)
+        {
+        case N_ENTERO:
+            return D_INT;
+        case N_REAL:
+            return D_FLOAT;
+        case N_CADENA:
+            return D_CADENA;
+        case N_ID:
+        {
+            uint32_t v = buscar(simbolo(ast->token(n)));
+            if (v == SIN_SIMBOLO)
+            {
+                reportar(ast->token(n), "variable no declarada");
+                return D_ERROR;
+            }
+            enlaces[n] = variables[v].nodo;
+            return variables[v].tipo;
+        }
+        case N_LLAMADA:
+        {
+            TipoDato t = llamada(n);
+            if (t == D_VOID)
+            {
+                reportar(ast->token(n), "la función no devuelve un valor");
+                return D_ERROR;
+            }
+            return t;
+        }
+        case N_UNARIA:
+        {
+            TipoDato t = expresion(x.hijo);
+            if (t == D_CADENA)
+            {
+                reportar(tokenDe(x.hijo), std::string("operación ") + textoTipo[x.op] + " con una cadena");
+                return D_ERROR;
+            }
+            return t == D_ERROR ? D_ERROR : x.op == T_NOT ? D_INT : t;
+        }
+        case N_BINARIA:
+        {
+            Indice der = (*ast)[x.hijo].hermano;
+            TipoDato a = expresion(x.hijo), b = expresion(der);
+            if (a == D_ERROR || b == D_ERROR)
+                return D_ERROR;
+            if (a == D_CADENA || b == D_CADENA)
+            {
+                reportar(tokenDe(a == D_CADENA ? x.hijo : der), std::string("operación ") + textoTipo[x.op] +
+                                                                    " con una cadena");
+                return D_ERROR;
+            }
+            // aritmética: float si algún operando es float; comparaciones y lógicas: int
+            if (x.op == T_MAS || x.op == T_MENOS || x.op == T_POR || x.op == T_ENTRE)
+                return a == D_FLOAT || b == D_FLOAT ? D_FLOAT : D_INT;
+            return D_INT;
+        }
+        default:
+            return D_ERROR;
+        }
+    }
+
+    void condicion(Indice n)
+    {
+        TipoDato t = expresion(n);
+        if (t != D_INT && t != D_FLOAT && t != D_ERROR)
+            reportar(tokenDe(n), std::string("la condición es ") + nombreDato[t] + " y no un número");
+    }
+
+    void bloque(Indice n, bool ambitoPropio)
+    {
+        if (ambitoPropio)
+            abrirAmbito();
+        for (Indice i = (*ast)[n].hijo; i != NINGUNO; i = (*ast)[i].hermano)
+            instruccion(i);
+        if (ambitoPropio)
+            cerrarAmbito();
+    }
+
+    void instruccion(Indice n)
+    {
+        const Nodo &x = (*ast)[n];
+        switch (x.tipo)
+        {
+        case N_BLOQUE:
+            bloque(n, true);
+            break;
+        case N_DECLARACION:
+        {
+            TipoDato tipo = dato(x.op);
+            for (Indice v = x.hijo; v != NINGUNO; v = (*ast)[v].hermano)
+            {
+                if (tipo == D_VOID)
+                {
+                    reportar(ast->token(v), "una variable no puede ser void");
+                    continue;
+                }
+                Indice valor = (*ast)[v].hijo;
+                if (valor != NINGUNO)
+                {
+                    TipoDato t = expresion(valor);
+                    if (!asignable(tipo, t))
+                        reportar(ast->token(v), std::string("no se puede asignar ") + nombreDato[t] + " a " +
+                                                    nombreDato[tipo]);
+                }
+                declarar(v, tipo);
+            }
+            break;
+        }
+        case N_ASIGNACION:
+        {
+            TipoDato t = expresion(x.hijo);
+            uint32_t v = buscar(simbolo(ast->token(n)));
+            if (v == SIN_SIMBOLO)
+                reportar(ast->token(n), "variable no declarada");
+            else
+                enlaces[n] = variables[v].nodo;
+            if (v != SIN_SIMBOLO && !asignable(variables[v].tipo, t))
+                reportar(ast->token(n), std::string("no se puede asignar ") + nombreDato[t] + " a " +
+                                            nombreDato[variables[v].tipo]);
+            break;
+        }
+        case N_SI:
+        case N_MIENTRAS:
+            condicion(x.hijo);
+            for (Indice i = (*ast)[x.hijo].hermano; i != NINGUNO; i = (*ast)[i].hermano)
+                instruccion(i);
+            break;
+        case N_RETORNO:
+        {
+            const Token &t = ast->token(n);
+            if (x.hijo == NINGUNO)
+            {
+                if (retornoActual != D_VOID)
+                    reportar(t, std::string("return sin valor en una función ") + nombreDato[retornoActual]);
+                break;
+            }
+            TipoDato v = expresion(x.hijo);
+            if (retornoActual == D_VOID)
+                reportar(t, "return con valor en una función void");
+            else if (!asignable(retornoActual, v))
+                reportar(t, std::string("se devuelve ") + nombreDato[v] + " en una función " +
+                                nombreDato[retornoActual]);
+            break;
+        }
+        case N_LLAMADA:
+            llamada(n);
+            break;
+        default:
+            break;
+        }
+    }
+
+    void funcion(Indice f)
+    {
+        const Nodo &x = (*ast)[f];
+        retornoActual = dato(x.op);
+        abrirAmbito();
+        for (Indice h = x.hijo; h != NINGUNO; h = (*ast)[h].hermano)
+            if ((*ast)[h].tipo == N_PARAMETRO)
+                declarar(h, dato((*ast)[h].op));
+            else
+                bloque(h, false); // el cuerpo comparte el ámbito de los parámetros
+        cerrarAmbito();
+    }
+
+public:
+    /**
+     * @param lex Analizador léxico de los tokens del árbol, para reportar líneas y textos
+     * @param in Internador con el que se numeraron los identificadores (o donde se numeran si
+     *           el léxico no usó internador)
+     * @param out Flujo donde se reportan los errores
+     */
+    Semantico(const Lexico &lex, Internador &in, std::ostream &out) : lex(lex), internador(in), salida(out) {}
+
+    /**
+     * @brief Revisa el árbol completo y reporta todos los errores.
+     * @return false si hubo errores
+     */
+    bool analizar(const Ast &arbol)
+    {
+        TRAZA("Semantico::analizar");
+        CONTAR_EN(medicion, "Semantico::analizar");
+        CONTAR_UNIDADES(medicion, arbol.nodos.size());
+        ast = &arbol;
+        errores = 0;
+        tablaVariables.limpiar();
+        tablaFunciones.limpiar();
+        variables.clear();
+        ambitos.clear();
+        funciones.clear();
+        parametros.clear();
+        args.clear();
+        tipos.assign(arbol.size(), D_ERROR);
+        enlaces.assign(arbol.size(), NINGUNO);
+        predefinida("printI", D_INT);
+        predefinida("printS", D_CADENA);
+
+        // primero las firmas, para poder llamar funciones definidas más abajo
+        for (Indice f = arbol[0].hijo; f != NINGUNO; f = arbol[f].hermano)
+        {
+            const Token &t = arbol.token(f);
+            uint32_t id = simbolo(t);
+            uint32_t anterior = tablaFunciones.buscar(id);
+            if (anterior != SIN_SIMBOLO)
+            {
+                Indice nodo = funciones[anterior].nodo;
+                reportar(t, nodo == NINGUNO ? std::string("función predefinida")
+                                            : "función ya definida en la línea " + std::to_string(lex.linea(arbol.token(nodo))));
+                continue;
+            }
+            tablaFunciones.asignar(id, funciones.size());
+            funciones.push_back(Funcion{dato(arbol[f].op), uint32_t(parametros.size()), 0, f});
+            for (Indice p = arbol[f].hijo; p != NINGUNO; p = arbol[p].hermano)
+                if (arbol[p].tipo == N_PARAMETRO)
+                {
+                    parametros.push_back(dato(arbol[p].op));
+                    ++funciones.back().n;
+                }
+        }
+        for (Indice f = arbol[0].hijo; f != NINGUNO; f = arbol[f].hermano)
+            funcion(f);
+
+        if (tablaFunciones.buscar(internador.internar("main", 4)) == SIN_SIMBOLO)
+        {
+            salida << "fin de archivo : no se definió la función main\n";
+            ++errores;
+        }
+        return errores == 0;
+    }
+
+    /// Errores reportados en el último análisis
+    unsigned nErrores() const
+    {
+        return errores;
+    }
+
+    /// Declaraciones de variables revisadas en el último análisis
+    size_t nVariables() const
+    {
+        return variables.size();
+    }
+
+    /// Tipo de la expresión o declaración n del último árbol revisado
+    TipoDato tipo(Indice n) const
+    {
+        return tipos[n];
+    }
+
+    /**
+     * @brief Declaración (N_VARIABLE o N_PARAMETRO) de un N_ID o N_ASIGNACION, o función de un
+     * N_LLAMADA (N_FUNCION o PREDEFINIDA(k)); NINGUNO si el nombre tuvo un error.
+     */
+    Indice enlace(Indice n) const
+    {
+        return enlaces[n];
+    }
+};
+
+#endif
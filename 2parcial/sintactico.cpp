@@ -1,40 +1,623 @@
 #include "sintactico.h"
 
+const Token Sintactico::FIN = {0, 0, T_EOF, SIN_SIMBOLO};
+
 void Sintactico::sigToken()
 {
-   ++pos;
-   actual = vt[pos];
-   if (pos + 1 == vt.size())
-      next = vt[pos + 1];
-   else
+   ++consumidos;
+   if (silencio)
+      --silencio;
+   if (anillo)
    {
-      strcpy(next.token, " ");
-      strcpy(next.type, "eof");
+      ventana[0] = ventana[1];
+      ventana[1] = anillo->sacar();
    }
+   else
+      ++pos;
+}
+
+bool Sintactico::analizar(const std::vector<Token> &vt)
+{
+   return analizar(vt.data(), vt.size());
 }
 
-bool Sintactico::analizar(std::vector<Token> &tokens)
+bool Sintactico::analizar(const Token *tk, size_t n)
 {
-   vt = tokens;
+   TRAZA("Sintactico::analizar");
+   CONTAR_EN(medicion, "Sintactico::analizar");
+   CONTAR_UNIDADES(medicion, n);
+   tokens = tk;
+   nTokens = n;
+   anillo = nullptr;
+   // cota estimada: en los programas generados hay unos 0.57 nodos por token
+   ast.nodos.reserve(nTokens * 5 / 8 + 1);
    pos = 0;
-   actual = vt[pos];
-   next = vt[pos + 1];
    if (programa())
       return true;
    else
    {
-      cout << "Errores\n";
+      *salida << "Errores\n";
       return false;
    }
 }
 
-bool Sintactico::asignacion()
+bool Sintactico::analizar(AnilloTokens &a)
 {
-   if (actual.type == "int" || actual.type == "float" || actual.type == "void")
+   TRAZA("Sintactico::analizar");
+   CONTAR_EN(medicion, "Sintactico::analizar (anillo)");
+   anillo = &a;
+   pendientes.clear();
+   ventana[0] = a.sacar();
+   ventana[1] = a.sacar();
+   tokens = ventana;
+   nTokens = 2;
+   pos = 0;
+   bool ok = programa();
+
+   // se consumen los tokens restantes para que el léxico termine; después ya se pueden
+   // consultar sus líneas para reportar los errores
+   while (ventana[1].tipo != T_EOF)
+      ventana[1] = anillo->sacar();
+   anillo = nullptr;
+   nTokens = 0;
+   CONTAR_UNIDADES(medicion, consumidos);
+   if (!ok)
    {
-      if(next.type == "id"){
-         
+      for (auto &e : pendientes)
+         reportar(e.first, e.second);
+      *salida << "Errores\n";
+   }
+   return ok;
+}
+
+bool analizarEnTubo(Lexico &lex, Sintactico &sin)
+{
+   AnilloTokens anillo;
+   bool lexOk = true;
+   std::thread hilo([&] {
+      TRAZA_HILO("lexico (tubo)");
+      lexOk = lex.analizar(anillo);
+   });
+   std::ostringstream errores;
+   std::ostream *antes = sin.salida;
+   sin.usarSalida(errores);
+   bool ok = sin.analizar(anillo);
+   sin.usarSalida(*antes);
+   hilo.join();
+   // con tokens inválidos el error sintáctico no significa nada, igual que en compilador.cpp
+   if (!lexOk)
+      return false;
+   *antes << errores.str();
+   return ok;
+}
+
+// menos tokens que esto por trozo no pagan repartirlos entre hilos
+static const size_t MINIMO_TROZO = 1 << 15;
+
+bool analizarEnParalelo(const std::vector<Token> &vt, Sintactico &sin, unsigned hilos)
+{
+   if (hilos < 2 || vt.size() < 2 * MINIMO_TROZO)
+      return sin.analizar(vt);
+   PoolTareas pool(hilos);
+   return analizarEnParalelo(vt, sin, pool);
+}
+
+bool analizarEnParalelo(const std::vector<Token> &vt, Sintactico &sin, PoolTareas &pool)
+{
+   size_t n = vt.size(), hilos = pool.size();
+   if (hilos < 2 || n < 2 * MINIMO_TROZO)
+      return sin.analizar(vt);
+
+   // unos 4 trozos por hilo, para que uno con funciones largas no deje a los demás esperando
+   size_t porTrozo = std::max(MINIMO_TROZO, n / (hilos * 4));
+   std::vector<size_t> cortes{0};
+   int nivel = 0;
+   for (size_t i = 0; i < n; ++i)
+      if (vt[i].tipo == T_LLAVEA)
+         ++nivel;
+      else if (vt[i].tipo == T_LLAVEC && --nivel == 0 && i + 1 - cortes.back() >= porTrozo && i + 1 < n &&
+               vt[i + 1].tipo != T_EOF)
+         cortes.push_back(i + 1);
+   cortes.push_back(n);
+   size_t nTrozos = cortes.size() - 1;
+   if (nTrozos < 2)
+      return sin.analizar(vt);
+   TRAZA("analizarEnParalelo");
+
+   // ejecuta f(k) para cada trozo como una tarea del grupo y espera a que terminen todas
+   auto repartir = [&](auto f) {
+      for (size_t k = 0; k < nTrozos; ++k)
+         pool.agregar([&f, k] { f(k); });
+      pool.esperar();
+   };
+
+   std::vector<Ast> partes(nTrozos);
+   std::vector<char> bien(nTrozos);
+   repartir([&](size_t k) {
+      TRAZA("trozo");
+      Sintactico s;
+      std::ostringstream nulo;
+      s.usarSalida(nulo);
+      bien[k] = s.analizar(vt.data() + cortes[k], cortes[k + 1] - cortes[k]);
+      partes[k] = std::move(s.ast);
+   });
+   for (char b : bien)
+      if (!b)
+         return sin.analizar(vt);
+
+   // cada parte deja fuera su raíz: su nodo i > 0 va a baseNodo[k] + i - 1
+   std::vector<Indice> baseNodo(nTrozos + 1, 1), baseToken(nTrozos + 1, 0);
+   for (size_t k = 0; k < nTrozos; ++k)
+   {
+      baseNodo[k + 1] = baseNodo[k] + partes[k].nodos.size() - 1;
+      baseToken[k + 1] = baseToken[k] + partes[k].tokens.size();
+   }
+   Ast &ast = sin.ast;
+   ast.limpiar();
+   ast.nuevo(N_PROGRAMA);
+   ast.nodos[0].hijo = baseNodo[0] + partes[0].nodos[0].hijo - 1;
+   ast.nodos.resize(baseNodo[nTrozos]);
+   ast.tokens.resize(baseToken[nTrozos]);
+   repartir([&](size_t k) {
+      TRAZA("unir trozo");
+      const Ast &p = partes[k];
+      Indice dn = baseNodo[k] - 1, dt = baseToken[k];
+      Indice ultima = NINGUNO;
+      for (Indice i = 1; i < p.nodos.size(); ++i)
+      {
+         Nodo x = p.nodos[i];
+         if (x.hijo != NINGUNO)
+            x.hijo += dn;
+         if (x.hermano != NINGUNO)
+            x.hermano += dn;
+         if (x.token != NINGUNO)
+            x.token += dt;
+         ast.nodos[dn + i] = x;
       }
+      std::copy(p.tokens.begin(), p.tokens.end(), ast.tokens.begin() + dt);
+      // la última función de la parte sigue con la primera de la siguiente
+      for (Indice f = p.nodos[0].hijo; f != NINGUNO; f = p.nodos[f].hermano)
+         ultima = f;
+      if (k + 1 < nTrozos)
+         ast.nodos[dn + ultima].hermano = baseNodo[k + 1] + partes[k + 1].nodos[0].hijo - 1;
+   });
+   sin.tokens = nullptr;
+   sin.nTokens = 0;
+   sin.consumidos = n;
+   sin.errores = 0;
+   return true;
+}
+
+bool Sintactico::matchToken(Tipo t)
+{
+   return actual().tipo == t;
+}
+
+void Sintactico::reportar(const Token &t, const char *que)
+{
+   if (t.tipo == T_EOF)
+      *salida << "fin de archivo : se esperaba " << que << "\n";
+   else if (lex)
+      *salida << lex->linea(t) << " : " << lex->texto(t) << " : se esperaba " << que << "\n";
+   else
+      *salida << "token " << consumidos << " : " << nombreTipo[t.tipo] << " : se esperaba " << que << "\n";
+}
+
+bool Sintactico::error(const char *que)
+{
+   if (silencio)
+      return false;
+   ++errores;
+   // mientras el léxico sigue en su hilo, sus líneas todavía cambian
+   if (anillo)
+      pendientes.emplace_back(actual(), que);
+   else
+      reportar(actual(), que);
+   return false;
+}
+
+void Sintactico::recuperar(uint64_t sinc, size_t inicio)
+{
+   // si el error fue en el primer token se salta, para no volver a fallar en el mismo lugar
+   if (consumidos == inicio && !matchToken(T_LLAVEC) && !matchToken(T_EOF))
+      sigToken();
+   while (!(sinc >> actual().tipo & 1))
+      sigToken();
+   // el ; termina la instrucción que falló
+   if (matchToken(T_PYC))
+      sigToken();
+   silencio = 3;
+}
+
+bool Sintactico::esperar(Tipo t, const char *que)
+{
+   if (!matchToken(t))
+      return error(que);
+   sigToken();
+   return true;
+}
+
+bool Sintactico::programa()
+{
+   ast.limpiar();
+   consumidos = 0;
+   errores = silencio = 0;
+   Indice raiz = ast.nuevo(N_PROGRAMA);
+   funciones(raiz);
+   return errores == 0;
+}
+
+bool Sintactico::funciones(Indice raiz)
+{
+   Indice ultimo = NINGUNO, f;
+   do
+   {
+      size_t inicio = consumidos;
+      if (funcion(f))
+         ast.agregarHijo(raiz, ultimo, f);
+      else
+         recuperar(ll1::SINC_FUNCION, inicio);
+   } while (!matchToken(T_EOF));
+   return true;
+}
+
+bool Sintactico::funcion(Indice &n)
+{
+   Tipo t = actual().tipo;
+   if (!tipodato())
+      return error("el tipo de retorno de una función");
+   if (!matchToken(T_ID))
+      return error("el nombre de la función");
+   n = ast.nuevo(N_FUNCION, t, &actual());
+   sigToken();
+   Indice ultimo = NINGUNO, b;
+   if (!esperar(T_PARA, "(") || !parametros(n, ultimo) || !esperar(T_PARC, ")") || !bloqueinstruccion(b))
+      return false;
+   ast.agregarHijo(n, ultimo, b);
+   return true;
+}
+
+bool Sintactico::tipodato()
+{
+   if (matchToken(T_INT) || matchToken(T_FLOAT) || matchToken(T_VOID))
+   {
+      sigToken();
+      return true;
+   }
+   return false;
+}
+
+bool Sintactico::parametros(Indice f, Indice &ultimo)
+{
+   if (matchToken(T_PARC))
+      return true;
+   Indice p;
+   do
+   {
+      if (!parametro(p))
+         return false;
+      ast.agregarHijo(f, ultimo, p);
+   } while (matchToken(T_COMA) && (sigToken(), true));
+   return true;
+}
+
+bool Sintactico::parametro(Indice &n)
+{
+   Tipo t = actual().tipo;
+   if (!tipodato())
+      return error("el tipo de un parámetro");
+   if (!matchToken(T_ID))
+      return error("el nombre del parámetro");
+   n = ast.nuevo(N_PARAMETRO, t, &actual());
+   sigToken();
+   return true;
+}
+
+bool Sintactico::bloqueinstruccion(Indice &n)
+{
+   if (!esperar(T_LLAVEA, "{"))
+      return false;
+   n = ast.nuevo(N_BLOQUE);
+   Indice ultimo = NINGUNO, i;
+   while (!matchToken(T_LLAVEC))
+   {
+      if (matchToken(T_EOF))
+         return error("}");
+      size_t inicio = consumidos;
+      if (instruccion(i))
+         ast.agregarHijo(n, ultimo, i);
+      else
+         recuperar(ll1::SINC_INSTRUCCION, inicio);
    }
-   else return false;
+   sigToken();
+   return true;
+}
+
+bool Sintactico::instruccion(Indice &n)
+{
+   switch (actual().tipo)
+   {
+   case T_INT:
+   case T_FLOAT:
+   case T_VOID:
+      return declaracion(n);
+   case T_IF:
+      return ifelse(n);
+   case T_WHILE:
+      return _while(n);
+   case T_RETURN:
+      return _return(n);
+   case T_LLAVEA:
+      return bloqueinstruccion(n);
+   case T_ID:
+      if (next().tipo == T_PARA)
+         return llf(n) && esperar(T_PYC, ";");
+      return asignacion(n);
+   default:
+      return error("una instrucción");
+   }
+}
+
+bool Sintactico::declaracion(Indice &n)
+{
+   n = ast.nuevo(N_DECLARACION, actual().tipo);
+   tipodato();
+   Indice ultimo = NINGUNO;
+   do
+   {
+      if (!matchToken(T_ID))
+         return error("el nombre de la variable");
+      Indice v = ast.nuevo(N_VARIABLE, T_EOF, &actual());
+      ast.agregarHijo(n, ultimo, v);
+      sigToken();
+      if (matchToken(T_ASIG))
+      {
+         sigToken();
+         Indice e;
+         if (!expresion(e))
+            return false;
+         ast.nodos[v].hijo = e;
+      }
+   } while (matchToken(T_COMA) && (sigToken(), true));
+   return esperar(T_PYC, ";");
+}
+
+bool Sintactico::asignacion(Indice &n)
+{
+   n = ast.nuevo(N_ASIGNACION, T_EOF, &actual());
+   sigToken();
+   Indice e;
+   if (!esperar(T_ASIG, "=") || !expresion(e))
+      return false;
+   ast.nodos[n].hijo = e;
+   return esperar(T_PYC, ";");
+}
+
+bool Sintactico::llf(Indice &n)
+{
+   n = ast.nuevo(N_LLAMADA, T_EOF, &actual());
+   sigToken();
+   sigToken();
+   if (matchToken(T_PARC))
+   {
+      sigToken();
+      return true;
+   }
+   Indice ultimo = NINGUNO, a;
+   do
+   {
+      if (!expresion(a))
+         return false;
+      ast.agregarHijo(n, ultimo, a);
+   } while (matchToken(T_COMA) && (sigToken(), true));
+   return esperar(T_PARC, ")");
+}
+
+bool Sintactico::ifelse(Indice &n)
+{
+   n = ast.nuevo(N_SI);
+   sigToken();
+   Indice ultimo = NINGUNO, c, i;
+   if (!esperar(T_PARA, "(") || !expresion(c) || !esperar(T_PARC, ")"))
+      return false;
+   ast.agregarHijo(n, ultimo, c);
+   if (!instruccion(i))
+      return false;
+   ast.agregarHijo(n, ultimo, i);
+   if (matchToken(T_ELSE))
+   {
+      sigToken();
+      if (!instruccion(i))
+         return false;
+      ast.agregarHijo(n, ultimo, i);
+   }
+   return true;
+}
+
+bool Sintactico::_while(Indice &n)
+{
+   n = ast.nuevo(N_MIENTRAS);
+   sigToken();
+   Indice ultimo = NINGUNO, c, i;
+   if (!esperar(T_PARA, "(") || !expresion(c) || !esperar(T_PARC, ")"))
+      return false;
+   ast.agregarHijo(n, ultimo, c);
+   if (!instruccion(i))
+      return false;
+   ast.agregarHijo(n, ultimo, i);
+   return true;
+}
+
+bool Sintactico::_return(Indice &n)
+{
+   n = ast.nuevo(N_RETORNO, T_EOF, &actual());
+   sigToken();
+   if (!matchToken(T_PYC))
+   {
+      Indice e;
+      if (!expresion(e))
+         return false;
+      ast.nodos[n].hijo = e;
+   }
+   return esperar(T_PYC, ";");
+}
+
+bool Sintactico::binaria(Indice &izq, Tipo op, Indice der)
+{
+   Indice n = ast.nuevo(N_BINARIA, op);
+   ast.nodos[n].hijo = izq;
+   ast.nodos[izq].hermano = der;
+   izq = n;
+   return true;
+}
+
+bool Sintactico::expresion(Indice &n)
+{
+   if (!operacionand(n))
+      return false;
+   while (matchToken(T_OR))
+   {
+      sigToken();
+      Indice d;
+      if (!operacionand(d))
+         return false;
+      binaria(n, T_OR, d);
+   }
+   return true;
+}
+
+bool Sintactico::operacionand(Indice &n)
+{
+   if (!igualdad(n))
+      return false;
+   while (matchToken(T_AND))
+   {
+      sigToken();
+      Indice d;
+      if (!igualdad(d))
+         return false;
+      binaria(n, T_AND, d);
+   }
+   return true;
+}
+
+bool Sintactico::igualdad(Indice &n)
+{
+   if (!relacional(n))
+      return false;
+   while (matchToken(T_IGUAL) || matchToken(T_DIST))
+   {
+      Tipo op = actual().tipo;
+      sigToken();
+      Indice d;
+      if (!relacional(d))
+         return false;
+      binaria(n, op, d);
+   }
+   return true;
+}
+
+bool Sintactico::relacional(Indice &n)
+{
+   if (!aditiva(n))
+      return false;
+   while (matchToken(T_MENOR) || matchToken(T_MAYOR) || matchToken(T_MENORIG) || matchToken(T_MAYORIG))
+   {
+      Tipo op = actual().tipo;
+      sigToken();
+      Indice d;
+      if (!aditiva(d))
+         return false;
+      binaria(n, op, d);
+   }
+   return true;
+}
+
+bool Sintactico::aditiva(Indice &n)
+{
+   if (!multiplicativa(n))
+      return false;
+   while (matchToken(T_MAS) || matchToken(T_MENOS))
+   {
+      Tipo op = actual().tipo;
+      sigToken();
+      Indice d;
+      if (!multiplicativa(d))
+         return false;
+      binaria(n, op, d);
+   }
+   return true;
+}
+
+bool Sintactico::multiplicativa(Indice &n)
+{
+   if (!unaria(n))
+      return false;
+   while (matchToken(T_POR) || matchToken(T_ENTRE))
+   {
+      Tipo op = actual().tipo;
+      sigToken();
+      Indice d;
+      if (!unaria(d))
+         return false;
+      binaria(n, op, d);
+   }
+   return true;
+}
+
+bool Sintactico::unaria(Indice &n)
+{
+   if (matchToken(T_NOT) || matchToken(T_MENOS))
+   {
+      // no se pasa ast.nodos[n].hijo por referencia: el vector de nodos puede crecer y moverse
+      n = ast.nuevo(N_UNARIA, actual().tipo);
+      sigToken();
+      Indice e;
+      if (!unaria(e))
+         return false;
+      ast.nodos[n].hijo = e;
+      return true;
+   }
+   return primaria(n);
+}
+
+bool Sintactico::primaria(Indice &n)
+{
+   switch (actual().tipo)
+   {
+   case T_ID:
+      if (next().tipo == T_PARA)
+         return llf(n);
+      n = ast.nuevo(N_ID, T_EOF, &actual());
+      sigToken();
+      return true;
+   case T_ENTERO:
+   case T_REAL:
+   case T_CADENA:
+      n = ast.nuevo(actual().tipo == T_ENTERO ? N_ENTERO : actual().tipo == T_REAL ? N_REAL : N_CADENA, T_EOF, &actual());
+      sigToken();
+      return true;
+   case T_PARA:
+      sigToken();
+      return expresion(n) && esperar(T_PARC, ")");
+   default:
+      return error("una expresión");
+   }
+}
+
+bool SintacticoLL1::analizar(const std::vector<Token> &tokens)
+{
+   size_t pos;
+   unsigned char esperado;
+   if (ll1::analizar(tokens.data(), tokens.size(), pila, pos, esperado))
+      return true;
+   const char *que = ll1::texto[esperado];
+   if (pos >= tokens.size())
+      *salida << "fin de archivo : se esperaba " << que << "\n";
+   else if (lex)
+      *salida << lex->linea(tokens[pos]) << " : " << lex->texto(tokens[pos]) << " : se esperaba " << que << "\n";
+   else
+      *salida << "token " << pos << " : " << nombreTipo[tokens[pos].tipo] << " : se esperaba " << que << "\n";
+   *salida << "Errores\n";
+   return false;
 }
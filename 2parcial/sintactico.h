@@ -1,52 +1,153 @@
+#ifndef SINTACTICO_H
+#define SINTACTICO_H
+
+#include <sstream>
+#include <thread>
 #include "lexico.h"
 #include "lexico.cpp"
+#include "ast.h"
+#include "sintactico_ll1.h"
+#include "tareas.h"
 
 class Sintactico
 {
-   // Token analizado actualente
-   Token actual;
-   // Token siguiente en la lista
-   Token next;
-   // posición en la lista?
-   int pos = 0;
-   // lista de tokens
-   std::vector<Token> vt;
-
-   //Evalúa si un token es igual a un caracter
-   bool matchToken();
-   // evalúa si un token es igual a un tipo de dato
-   bool matchType();
-
-   // devuelve el seiguiente token en la lista
+   // tokens por analizar (sin copiarlos): el vector del léxico o, en modo anillo, la ventana
+   const Token *tokens = nullptr;
+   size_t nTokens = 0;
+   // posición del token actual en tokens
+   size_t pos = 0;
+   // token actual y el siguiente en modo anillo (el anillo no guarda los tokens ya leídos)
+   Token ventana[2];
+   // se devuelve al leer después del último token
+   static const Token FIN;
+   // anillo del que se leen los tokens cuando el léxico corre en otro hilo
+   AnilloTokens *anillo = nullptr;
+   // tokens consumidos hasta ahora (en modo anillo pos no avanza)
+   size_t consumidos = 0;
+   // en modo anillo los errores se reportan hasta que el léxico termina (ver error)
+   std::vector<std::pair<Token, const char *>> pendientes;
+   // errores encontrados; después de recuperarse de uno no se reportan los de los siguientes
+   // tokens, que casi siempre son consecuencia del mismo
+   unsigned errores = 0;
+   unsigned silencio = 0;
+   // analizador léxico que generó los tokens, para reportar la línea y el texto de los errores
+   const Lexico *lex = nullptr;
+   // flujo donde se reportan los errores
+   std::ostream *salida = &std::cout;
+   // árbol sintáctico del último archivo analizado
+   Ast ast;
+
+   // evalúa si el token actual es del tipo t
+   bool matchToken(Tipo t);
+   // si el token actual es del tipo t avanza al siguiente, si no reporta que se esperaba que
+   bool esperar(Tipo t, const char *que);
+   // reporta un error sintáctico en el token actual
+   bool error(const char *que);
+   // modo alarma: salta tokens hasta uno del conjunto de sincronización sinc (un bit por Tipo,
+   // de sintactico_ll1.h); si no se consumió nada desde inicio salta al menos uno
+   void recuperar(uint64_t sinc, size_t inicio);
+
+   // token k posiciones adelante del actual, o FIN si ya no hay
+   const Token &ver(size_t k) const { return pos + k < nTokens ? tokens[pos + k] : FIN; }
+   const Token &actual() const { return ver(0); }
+   const Token &next() const { return ver(1); }
+   // avanza al siguiente token de la lista (o saca uno del anillo)
    void sigToken();
-   // función para anlizar la lista de tokens del lexico
-   bool analizar(std::vector<Token> &tokens);
-   // regla de producción para funcion main | <int> <main>(P) {I}
-   bool _main();
+   // reporta un error ya con el token y lo que se esperaba
+   void reportar(const Token &t, const char *que);
+   // regla de producción para el programa :: Programa -> F m | m
+   bool programa();
    // regla de producción para funciones :: F -> F f | f
-   bool funciones();
-   // regla de producción para función :: f -> T <id> (P) {I return}
-   bool funcion();
-   // regla de produccción para llamada a función :: llf -> <id>(P);
-   bool llf();
-   // regla de producción para parámetros :: P -> p,P | p
-   bool parametros();
-   // regla de producción para parámetro :: p -> id | llf | val
-   bool parametro();
-   // regla de producción para bloque de instrucciones :: I -> i[I]
-   bool bloqueinstruccion();
-   // regla de producción para una instrucción :: i -> D | A | <if> | IE | W | <return> | llf
-   bool instruccion();
-   // regla de producción para una declaración :: D -> T <id> ;
-   bool declaracion();
+   bool funciones(Indice raiz);
+   // regla de producción para función :: f -> T <id> (P) {I}
+   bool funcion(Indice &n);
+   // regla de produccción para llamada a función :: llf -> <id>(A)  A -> E,A | E | vacío
+   bool llf(Indice &n);
+   // regla de producción para parámetros :: P -> p,P | p | vacío
+   bool parametros(Indice f, Indice &ultimo);
+   // regla de producción para parámetro :: p -> T <id>
+   bool parametro(Indice &n);
+   // regla de producción para bloque de instrucciones :: I -> {i[I]}
+   bool bloqueinstruccion(Indice &n);
+   // regla de producción para una instrucción :: i -> D | A | IE | W | R | llf; | I
+   bool instruccion(Indice &n);
+   // regla de producción para una declaración :: D -> T <id> [= E] {, <id> [= E]} ;
+   bool declaracion(Indice &n);
    // regla de producción para un tipo de dato :: T -> <int> | <float> | <void>
    bool tipodato();
-   // regla de producción para una asignación :: A -> T <id> = E | <id> | llf
-   bool asignacion();
-   // regla de producción para una expresión :: E -> operacionand [ || exp]
-   bool expresion();
-   // regla de producción para una estructura if-else :: IE -> <if> {I} <else> {I}
-   bool ifelse();
-   // regla de producción para una estructura while :: W -> <while> (EL) {I}
-   bool _while();
+   // regla de producción para una asignación :: A -> <id> = E ;
+   bool asignacion(Indice &n);
+   // regla de producción para una expresión :: E -> operacionand [ || E]
+   bool expresion(Indice &n);
+   // E_and -> E_ig [&& E_and]   E_ig -> E_rel [(==|!=) E_ig]   E_rel -> E_ad [(<|>|<=|>=) E_rel]
+   bool operacionand(Indice &n);
+   bool igualdad(Indice &n);
+   bool relacional(Indice &n);
+   // E_ad -> E_mul [(+|-) E_ad]   E_mul -> E_un [(*|/) E_mul]   E_un -> (!|-) E_un | prim
+   bool aditiva(Indice &n);
+   bool multiplicativa(Indice &n);
+   bool unaria(Indice &n);
+   // prim -> <id> | llf | val | <cadena> | (E)
+   bool primaria(Indice &n);
+   // reemplaza izq por un nodo binario op con operandos izq y der (asociatividad por la izquierda)
+   bool binaria(Indice &izq, Tipo op, Indice der);
+   // regla de producción para una estructura if-else :: IE -> <if> (E) i [<else> i]
+   bool ifelse(Indice &n);
+   // regla de producción para una estructura while :: W -> <while> (E) i
+   bool _while(Indice &n);
+   // regla de producción para return :: R -> <return> [E] ;
+   bool _return(Indice &n);
+
+public:
+   // indica el analizador léxico de los tokens (para las líneas de los errores) y dónde reportarlos
+   void usarLexico(const Lexico *l) { lex = l; }
+   void usarSalida(std::ostream &s) { salida = &s; }
+   // árbol del último análisis (sin las instrucciones y funciones con errores)
+   const Ast &arbol() const { return ast; }
+   Ast &arbol() { return ast; }
+   // errores reportados en el último análisis
+   unsigned nErrores() const { return errores; }
+   friend bool analizarEnTubo(Lexico &lex, Sintactico &sin);
+   friend bool analizarEnParalelo(const std::vector<Token> &tokens, Sintactico &sin, PoolTareas &pool);
+
+   // función para anlizar la lista de tokens del lexico; reporta todos los errores
+   bool analizar(const std::vector<Token> &tokens);
+   // igual, sobre los n tokens de tk
+   bool analizar(const Token *tk, size_t n);
+   // analiza los tokens conforme el léxico los envía al anillo desde otro hilo
+   bool analizar(AnilloTokens &a);
 };
+
+// analiza léxica y sintácticamente el código cargado en lex, con el léxico en otro hilo
+bool analizarEnTubo(Lexico &lex, Sintactico &sin);
+
+// analiza tokens repartiendo las funciones entre hilos: corta la lista después de cada } que
+// cierra una función (donde la profundidad de llaves vuelve a 0), analiza cada trozo con su propio
+// Sintactico y su propio árbol, y al final une los árboles en sin.arbol(), con los nodos en el
+// mismo orden que Sintactico::analizar. Si algún trozo tiene errores se vuelve a analizar todo en
+// orden, para reportarlos igual; con pocos tokens no usa hilos. Los trozos se analizan como tareas
+// de pool, así que no se puede llamar desde una tarea del mismo grupo (esperaría a sí misma)
+bool analizarEnParalelo(const std::vector<Token> &tokens, Sintactico &sin, PoolTareas &pool);
+
+// igual, con un grupo de hilos propio, que solo se crea si hay tokens suficientes
+bool analizarEnParalelo(const std::vector<Token> &tokens, Sintactico &sin,
+                        unsigned hilos = std::thread::hardware_concurrency());
+
+// analizador LL(1) con la tabla que genll genera de sintactico.gramatica: solo reconoce el
+// programa, con una pila explícita en lugar de llamadas recursivas, así que cualquier
+// anidamiento cabe mientras haya memoria
+class SintacticoLL1
+{
+   // pila de símbolos, se conserva entre análisis
+   std::vector<unsigned char> pila;
+   const Lexico *lex = nullptr;
+   std::ostream *salida = &std::cout;
+
+public:
+   void usarLexico(const Lexico *l) { lex = l; }
+   void usarSalida(std::ostream &s) { salida = &s; }
+   // reporta el primer error con el mismo formato que Sintactico
+   bool analizar(const std::vector<Token> &tokens);
+};
+
+#endif
@@ -0,0 +1,240 @@
+/**
+ * @file    sintactico_ll1.h
+ * @brief   Tabla LL(1) del analizador sintáctico generada por genll a partir de sintactico.gramatica.
+ *          No editar a mano: modificar la gramática y volver a generar.
+ *          37 no terminales, 74 producciones, conflictos resueltos por orden: 1.
+ */
+
+#ifndef SINTACTICO_LL1_H
+#define SINTACTICO_LL1_H
+
+#include <cstdint>
+#include <vector>
+
+namespace ll1
+{
+
+// las columnas de la tabla son los valores de Tipo en el orden en que se declararon
+static_assert(T_EOF == 0, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_ENTERO == 1, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_REAL == 2, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_ID == 3, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_CADENA == 4, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_ELSE == 5, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_FLOAT == 6, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_IF == 7, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_INT == 8, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_RETURN == 9, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_VOID == 10, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_WHILE == 11, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_MAS == 12, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_MENOS == 13, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_POR == 14, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_ENTRE == 15, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_ASIG == 16, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_MENOR == 17, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_MAYOR == 18, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_NOT == 19, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_IGUAL == 20, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_DIST == 21, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_MENORIG == 22, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_MAYORIG == 23, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_AND == 24, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_OR == 25, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_LLAVEA == 26, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_LLAVEC == 27, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_PARA == 28, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_PARC == 29, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_COMA == 30, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_PYC == 31, "terminal fuera de orden en sintactico.gramatica");
+static_assert(T_NUM == 32, "faltan terminales en sintactico.gramatica");
+
+/// No terminales; se numeran después de los tipos de token para apilarlos juntos
+enum NoTerminal : unsigned char
+{
+    NT_PROGRAMA = T_NUM,
+    NT_FUNCIONES,
+    NT_FUNCION,
+    NT_TIPO,
+    NT_PARAMETROS,
+    NT_PARAMETRO,
+    NT_BLOQUE,
+    NT_INSTRUCCIONES,
+    NT_INSTRUCCION,
+    NT_TRAS_ID,
+    NT_EXPRESION,
+    NT_VALOR_RETORNO,
+    NT_PRIMARIA,
+    NT_MAS_PARAMETROS,
+    NT_DECLARACION,
+    NT_SI,
+    NT_MIENTRAS,
+    NT_RETORNO,
+    NT_ARGUMENTOS,
+    NT_VARIABLE,
+    NT_MAS_VARIABLES,
+    NT_INICIAL,
+    NT_SINO,
+    NT_CONJUNCION,
+    NT_MAS_OR,
+    NT_IGUALDAD,
+    NT_MAS_AND,
+    NT_RELACIONAL,
+    NT_MAS_IGUALDAD,
+    NT_ADITIVA,
+    NT_MAS_RELACIONAL,
+    NT_MULTIPLICATIVA,
+    NT_MAS_ADITIVA,
+    NT_UNARIA,
+    NT_MAS_MULTIPLICATIVA,
+    NT_LLAMADA,
+    NT_MAS_ARGUMENTOS,
+    NT_NUM
+};
+
+/// Cómo se menciona cada símbolo en los errores ("se esperaba ...")
+static const char *const texto[NT_NUM] = {
+    "fin de archivo", "un entero", "un real", "un identificador", "una cadena", "else", "float", "if", "int", "return", "void", "while", "+", "-", "*", "/",
+    "=", "<", ">", "!", "==", "!=", "<=", ">=", "&&", "||", "{", "}", "(", ")", ",", ";",
+    "una función", "una función", "una función", "un tipo de dato", "un parámetro", "un parámetro", "{", "una instrucción", "una instrucción", "= o (", "una expresión", "una expresión", "una expresión", ",", "float o int o void", "if",
+    "while", "return", "un entero o un real o un identificador o una cadena o - o ! o (", "un identificador", ",", "=", "else", "un entero o un real o un identificador o una cadena o - o ! o (", "||", "un entero o un real o un identificador o una cadena o - o ! o (", "&&", "un entero o un real o un identificador o una cadena o - o ! o (", "== o !=", "un entero o un real o un identificador o una cadena o - o ! o (", "< o > o <= o >=", "un entero o un real o un identificador o una cadena o - o ! o (",
+    "+ o -", "un entero o un real o un identificador o una cadena o - o ! o (", "* o /", "(", ","
+};
+
+/// FIRST de cada no terminal: el bit t indica el terminal t
+static const uint64_t primeros[NT_NUM - T_NUM] = {
+    0x540ULL, 0x540ULL, 0x540ULL, 0x540ULL, 0x540ULL, 0x540ULL, 0x4000000ULL, 0x4000fc8ULL, 0x4000fc8ULL, 0x10010000ULL, 0x1008201eULL, 0x1008201eULL, 0x1000001eULL, 0x40000000ULL, 0x540ULL, 0x80ULL,
+    0x800ULL, 0x200ULL, 0x1008201eULL, 0x8ULL, 0x40000000ULL, 0x10000ULL, 0x20ULL, 0x1008201eULL, 0x2000000ULL, 0x1008201eULL, 0x1000000ULL, 0x1008201eULL, 0x300000ULL, 0x1008201eULL, 0xc60000ULL, 0x1008201eULL,
+    0x3000ULL, 0x1008201eULL, 0xc000ULL, 0x10000000ULL, 0x40000000ULL
+};
+
+/// FOLLOW de cada no terminal
+static const uint64_t siguientes[NT_NUM - T_NUM] = {
+    0x1ULL, 0x1ULL, 0x541ULL, 0x8ULL, 0x20000000ULL, 0x60000000ULL, 0xc000fe9ULL, 0x8000000ULL, 0xc000fe8ULL, 0xc000fe8ULL, 0xe0000000ULL, 0x80000000ULL, 0xe3f6f000ULL, 0x20000000ULL, 0xc000fe8ULL, 0xc000fe8ULL,
+    0xc000fe8ULL, 0xc000fe8ULL, 0x20000000ULL, 0xc0000000ULL, 0x80000000ULL, 0xc0000000ULL, 0xc000fe8ULL, 0xe2000000ULL, 0xe0000000ULL, 0xe3000000ULL, 0xe2000000ULL, 0xe3300000ULL, 0xe3000000ULL, 0xe3f60000ULL, 0xe3300000ULL, 0xe3f63000ULL,
+    0xe3f60000ULL, 0xe3f6f000ULL, 0xe3f63000ULL, 0xe3f6f000ULL, 0x20000000ULL
+};
+
+// Conjuntos de sincronización del modo alarma: tras un error dentro del no terminal se
+// saltan los tokens que no están en su conjunto
+static const uint64_t SINC_INSTRUCCION = 0x8c000fe1ULL; // fin de archivo else float if int return void while { } ;
+static const uint64_t SINC_FUNCION = 0x541ULL; // fin de archivo float int void
+
+/// Lado derecho de cada producción, al revés
+static const unsigned char derecho[136] = {
+    NT_FUNCIONES, NT_FUNCION, NT_FUNCIONES, NT_FUNCION, NT_BLOQUE, T_PARC, NT_PARAMETROS, T_PARA, T_ID, NT_TIPO, T_INT, T_FLOAT, T_VOID, NT_MAS_PARAMETROS, NT_PARAMETRO, NT_MAS_PARAMETROS,
+    NT_PARAMETRO, T_COMA, T_ID, NT_TIPO, T_LLAVEC, NT_INSTRUCCIONES, T_LLAVEA, NT_INSTRUCCIONES, NT_INSTRUCCION, NT_DECLARACION, NT_SI, NT_MIENTRAS, NT_RETORNO, NT_BLOQUE, NT_TRAS_ID, T_ID,
+    T_PYC, NT_EXPRESION, T_ASIG, T_PYC, T_PARC, NT_ARGUMENTOS, T_PARA, T_PYC, NT_MAS_VARIABLES, NT_VARIABLE, NT_TIPO, NT_INICIAL, T_ID, NT_EXPRESION, T_ASIG, NT_MAS_VARIABLES,
+    NT_VARIABLE, T_COMA, NT_SINO, NT_INSTRUCCION, T_PARC, NT_EXPRESION, T_PARA, T_IF, NT_INSTRUCCION, T_ELSE, NT_INSTRUCCION, T_PARC, NT_EXPRESION, T_PARA, T_WHILE, T_PYC,
+    NT_VALOR_RETORNO, T_RETURN, NT_EXPRESION, NT_MAS_OR, NT_CONJUNCION, NT_MAS_OR, NT_CONJUNCION, T_OR, NT_MAS_AND, NT_IGUALDAD, NT_MAS_AND, NT_IGUALDAD, T_AND, NT_MAS_IGUALDAD, NT_RELACIONAL, NT_MAS_IGUALDAD,
+    NT_RELACIONAL, T_IGUAL, NT_MAS_IGUALDAD, NT_RELACIONAL, T_DIST, NT_MAS_RELACIONAL, NT_ADITIVA, NT_MAS_RELACIONAL, NT_ADITIVA, T_MENOR, NT_MAS_RELACIONAL, NT_ADITIVA, T_MAYOR, NT_MAS_RELACIONAL, NT_ADITIVA, T_MENORIG,
+    NT_MAS_RELACIONAL, NT_ADITIVA, T_MAYORIG, NT_MAS_ADITIVA, NT_MULTIPLICATIVA, NT_MAS_ADITIVA, NT_MULTIPLICATIVA, T_MAS, NT_MAS_ADITIVA, NT_MULTIPLICATIVA, T_MENOS, NT_MAS_MULTIPLICATIVA, NT_UNARIA, NT_MAS_MULTIPLICATIVA, NT_UNARIA, T_POR,
+    NT_MAS_MULTIPLICATIVA, NT_UNARIA, T_ENTRE, NT_UNARIA, T_NOT, NT_UNARIA, T_MENOS, NT_PRIMARIA, NT_LLAMADA, T_ID, T_ENTERO, T_REAL, T_CADENA, T_PARC, NT_EXPRESION, T_PARA,
+    T_PARC, NT_ARGUMENTOS, T_PARA, NT_MAS_ARGUMENTOS, NT_EXPRESION, NT_MAS_ARGUMENTOS, NT_EXPRESION, T_COMA
+};
+
+/// La producción p apila derecho[inicio[p]] ... derecho[inicio[p + 1] - 1]
+static const unsigned short inicio[75] = {
+    0, 2, 4, 4, 10, 11, 12, 13, 15, 15, 18, 18, 20, 23, 25, 25,
+    26, 27, 28, 29, 30, 32, 35, 39, 43, 45, 47, 47, 50, 50, 56, 58,
+    58, 63, 66, 67, 67, 69, 72, 72, 74, 77, 77, 79, 82, 85, 85, 87,
+    90, 93, 96, 99, 99, 101, 104, 107, 107, 109, 112, 115, 115, 117, 119, 120,
+    122, 123, 124, 125, 128, 131, 131, 133, 133, 136, 136
+};
+
+/// Producción que se aplica a cada no terminal con cada token (-1: error)
+static const signed char tabla[NT_NUM - T_NUM][T_NUM] = {
+    {-1, -1, -1, -1, -1, -1, 0, -1, 0, -1, 0, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, // programa
+    {2, 2, 2, 2, 2, 2, 1, 2, 1, 2, 1, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2, 2}, // funciones
+    {-1, -1, -1, -1, -1, -1, 3, -1, 3, -1, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, // funcion
+    {-1, -1, -1, -1, -1, -1, 5, -1, 4, -1, 6, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, // tipo
+    {8, 8, 8, 8, 8, 8, 7, 8, 7, 8, 7, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8, 8}, // parametros
+    {-1, -1, -1, -1, -1, -1, 11, -1, 11, -1, 11, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, // parametro
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 12, -1, -1, -1, -1, -1}, // bloque
+    {14, 14, 14, 13, 14, 14, 13, 13, 13, 13, 13, 13, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 14, 13, 14, 14, 14, 14, 14}, // instrucciones
+    {-1, -1, -1, 20, -1, -1, 15, 16, 15, 18, 15, 17, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 19, -1, -1, -1, -1, -1}, // instruccion
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 21, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 22, -1, -1, -1}, // tras_id
+    {-1, 36, 36, 36, 36, -1, -1, -1, -1, -1, -1, -1, -1, 36, -1, -1, -1, -1, -1, 36, -1, -1, -1, -1, -1, -1, -1, -1, 36, -1, -1, -1}, // expresion
+    {35, 34, 34, 34, 34, 35, 35, 35, 35, 35, 35, 35, 35, 34, 35, 35, 35, 35, 35, 34, 35, 35, 35, 35, 35, 35, 35, 35, 34, 35, 35, 35}, // valor_retorno
+    {-1, 64, 65, 63, 66, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 67, -1, -1, -1}, // primaria
+    {10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 9, 10}, // mas_parametros
+    {-1, -1, -1, -1, -1, -1, 23, -1, 23, -1, 23, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, // declaracion
+    {-1, -1, -1, -1, -1, -1, -1, 29, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, // si
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 32, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, // mientras
+    {-1, -1, -1, -1, -1, -1, -1, -1, -1, 33, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, // retorno
+    {71, 70, 70, 70, 70, 71, 71, 71, 71, 71, 71, 71, 71, 70, 71, 71, 71, 71, 71, 70, 71, 71, 71, 71, 71, 71, 71, 71, 70, 71, 71, 71}, // argumentos
+    {-1, -1, -1, 24, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1}, // variable
+    {28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 27, 28}, // mas_variables
+    {26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 25, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 26}, // inicial
+    {31, 31, 31, 31, 31, 30, 31, 31, 31, 31, 31, 31, 31, 31, 31, 31, 31, 31, 31, 31, 31, 31, 31, 31, 31, 31, 31, 31, 31, 31, 31, 31}, // sino
+    {-1, 39, 39, 39, 39, -1, -1, -1, -1, -1, -1, -1, -1, 39, -1, -1, -1, -1, -1, 39, -1, -1, -1, -1, -1, -1, -1, -1, 39, -1, -1, -1}, // conjuncion
+    {38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 38, 37, 38, 38, 38, 38, 38, 38}, // mas_or
+    {-1, 42, 42, 42, 42, -1, -1, -1, -1, -1, -1, -1, -1, 42, -1, -1, -1, -1, -1, 42, -1, -1, -1, -1, -1, -1, -1, -1, 42, -1, -1, -1}, // igualdad
+    {41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 41, 40, 41, 41, 41, 41, 41, 41, 41}, // mas_and
+    {-1, 46, 46, 46, 46, -1, -1, -1, -1, -1, -1, -1, -1, 46, -1, -1, -1, -1, -1, 46, -1, -1, -1, -1, -1, -1, -1, -1, 46, -1, -1, -1}, // relacional
+    {45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45, 43, 44, 45, 45, 45, 45, 45, 45, 45, 45, 45, 45}, // mas_igualdad
+    {-1, 52, 52, 52, 52, -1, -1, -1, -1, -1, -1, -1, -1, 52, -1, -1, -1, -1, -1, 52, -1, -1, -1, -1, -1, -1, -1, -1, 52, -1, -1, -1}, // aditiva
+    {51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 51, 47, 48, 51, 51, 51, 49, 50, 51, 51, 51, 51, 51, 51, 51, 51}, // mas_relacional
+    {-1, 56, 56, 56, 56, -1, -1, -1, -1, -1, -1, -1, -1, 56, -1, -1, -1, -1, -1, 56, -1, -1, -1, -1, -1, -1, -1, -1, 56, -1, -1, -1}, // multiplicativa
+    {55, 55, 55, 55, 55, 55, 55, 55, 55, 55, 55, 55, 53, 54, 55, 55, 55, 55, 55, 55, 55, 55, 55, 55, 55, 55, 55, 55, 55, 55, 55, 55}, // mas_aditiva
+    {-1, 62, 62, 62, 62, -1, -1, -1, -1, -1, -1, -1, -1, 61, -1, -1, -1, -1, -1, 60, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, -1, -1}, // unaria
+    {59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 57, 58, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59, 59}, // mas_multiplicativa
+    {69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 69, 68, 69, 69, 69}, // llamada
+    {73, 73, 73, 73, 73, 73, 73, 73, 73, 73, 73, 73, 73, 73, 73, 73, 73, 73, 73, 73, 73, 73, 73, 73, 73, 73, 73, 73, 73, 73, 72, 73} // mas_argumentos
+};
+
+/**
+ * @brief Reconoce tk[0..n) con la tabla y una pila explícita.
+ *
+ * @param pila Pila de símbolos; se reutiliza entre llamadas para no pedir memoria
+ * @param pos Índice del token donde se detectó el error
+ * @param esperado Símbolo que se esperaba en pos (su texto está en texto[esperado])
+ */
+inline bool analizar(const Token *tk, size_t n, std::vector<unsigned char> &pila, size_t &pos,
+                     unsigned char &esperado)
+{
+    // la pila se maneja con un apuntador y solo se revisa su tamaño al apilar
+    if (pila.size() < 256)
+        pila.resize(256);
+    unsigned char *base = pila.data(), *tope = base;
+    *tope++ = T_EOF;
+    *tope++ = NT_PROGRAMA;
+    pos = 0;
+    unsigned char t = n ? tk[0].tipo : T_EOF;
+    for (;;)
+    {
+        unsigned char x = *--tope;
+        if (x < T_NUM)
+        {
+            if (x != t)
+            {
+                esperado = x;
+                return false;
+            }
+            if (x == T_EOF)
+                return true;
+            t = ++pos < n ? tk[pos].tipo : T_EOF;
+            continue;
+        }
+        int p = tabla[x - T_NUM][t];
+        if (p < 0)
+        {
+            esperado = x;
+            return false;
+        }
+        const unsigned char *d = derecho + inicio[p], *f = derecho + inicio[p + 1];
+        if (size_t(tope - base) + (f - d) > pila.size())
+        {
+            size_t k = tope - base;
+            pila.resize(pila.size() * 2);
+            base = pila.data();
+            tope = base + k;
+        }
+        while (d < f)
+            *tope++ = *d++;
+    }
+}
+
+} // namespace ll1
+
+#endif
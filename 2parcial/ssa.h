@@ -0,0 +1,1345 @@
+/**
+ * @file    ssa.h
+ * @version 1.0
+ * @date    19/10/2026
+ * @title   Representación SSA
+ * @brief   Representación intermedia en forma SSA entre el árbol revisado por Semantico y el
+ *          bytecode: cada función es un grafo de bloques básicos y cada instrucción define un
+ *          solo valor, que se nombra con su índice. optimizador.h trabaja sobre esta forma.
+ *
+ *          ConstructorSsa la arma directamente desde el árbol con el algoritmo de Braun et al.
+ *          ("Simple and Efficient Construction of Static Single Assignment Form", 2013): la
+ *          definición de cada variable se busca hacia atrás en los predecesores y las phi se
+ *          crean solo donde se juntan definiciones distintas, sin calcular dominadores.
+ *
+ *          TraductorBytecode sale de SSA: parte las aristas críticas, calcula la vida de cada
+ *          valor, asigna registros de bytecode.h con un recorrido lineal que intenta dar a cada
+ *          phi el registro de sus argumentos, y convierte las phi en copias al final de los
+ *          predecesores.
+ */
+
+#ifndef SSA_H
+#define SSA_H
+
+#include <algorithm>
+#include <unordered_map>
+#include "bytecode.h"
+
+enum OpSsa : unsigned char
+{
+    S_NADA,     // instrucción eliminada
+    S_CONST,    // k o f según el tipo
+    S_PARAM,    // parámetro k
+    S_PHI,      // args: un valor por predecesor del bloque, en el mismo orden
+    S_SUMA,     // a + b, del tipo de la instrucción
+    S_RESTA,
+    S_MUL,
+    S_DIV,
+    S_MENOR,    // a < b, del tipo de a; el resultado es int
+    S_MAYOR,
+    S_MENORIG,
+    S_MAYORIG,
+    S_IGUAL,
+    S_DIST,
+    S_NEG,      // -a
+    S_NOT,      // !a
+    S_LOG,      // a != 0
+    S_AF,       // float(a)
+    S_LLAMA,    // función k con args
+    S_PRINTI,   // escribe a
+    S_PRINTS,   // escribe la cadena k
+    S_SALTA,    // al sucesor 0
+    S_SI,       // al sucesor 0 si a no es 0, si no al sucesor 1
+    S_REGRESA,  // regresa a (NINGUNO si no hay valor)
+    S_NUM
+};
+
+const char nombreOpSsa[S_NUM][8] = {
+    "nada", "const", "param", "phi", "suma", "resta", "mul", "div", "menor", "mayor", "menorig",
+    "mayorig", "igual", "dist", "neg", "not", "log", "af", "llama", "printi", "prints", "salta",
+    "si", "regresa"};
+
+struct InsSsa
+{
+    OpSsa op;
+    /// Tipo del valor: D_INT, D_FLOAT o D_VOID si la instrucción no define uno
+    TipoDato tipo;
+    uint32_t bloque;
+    uint32_t a = NINGUNO, b = NINGUNO;
+    union
+    {
+        int32_t k = 0;
+        float f;
+    };
+    std::vector<uint32_t> args;
+};
+
+struct BloqueSsa
+{
+    /// Instrucciones en orden; las phi van al principio y la última es un salto o un regreso
+    std::vector<uint32_t> ins;
+    std::vector<uint32_t> pred, suc;
+    bool vivo = true;
+};
+
+class FuncionSsa
+{
+public:
+    std::vector<InsSsa> ins;
+    std::vector<BloqueSsa> bloques;
+    TipoDato retorno = D_VOID;
+    uint16_t parametros = 0;
+    /// Nodo N_FUNCION
+    Indice nodo = NINGUNO;
+    /// false si se eliminó por no llamarse desde main
+    bool viva = true;
+    /// Valor que sustituye a cada valor eliminado, hasta el siguiente normalizar()
+    std::vector<uint32_t> reemplazo;
+
+    /// Aplica f a cada operando de x (por referencia)
+    template <class F>
+    static void operandos(InsSsa &x, F f)
+    {
+        if (x.op == S_PHI || x.op == S_LLAMA)
+            for (uint32_t &a : x.args)
+                f(a);
+        else
+        {
+            if (x.a != NINGUNO)
+                f(x.a);
+            if (x.b != NINGUNO)
+                f(x.b);
+        }
+    }
+
+    static bool esTerminal(OpSsa op)
+    {
+        return op == S_SALTA || op == S_SI || op == S_REGRESA;
+    }
+
+    /// Instrucción sin efectos: se puede quitar si nadie usa su valor, o calcular antes
+    bool pura(uint32_t v) const
+    {
+        const InsSsa &x = ins[v];
+        if (x.op == S_DIV && x.tipo == D_INT)
+        {
+            // la división entera entre cero es un error de ejecución
+            const InsSsa &d = ins[x.b];
+            return d.op == S_CONST && d.k != 0;
+        }
+        return x.op != S_NADA && x.op != S_PHI && x.op != S_PARAM && x.op != S_LLAMA && x.op != S_PRINTI &&
+               x.op != S_PRINTS && !esTerminal(x.op);
+    }
+
+    /// Valor que sustituye a v, siguiendo la cadena de reemplazos
+    uint32_t raiz(uint32_t v)
+    {
+        uint32_t r = v;
+        while (r < reemplazo.size() && reemplazo[r] != NINGUNO)
+            r = reemplazo[r];
+        while (v != r)
+        {
+            uint32_t s = reemplazo[v];
+            reemplazo[v] = r;
+            v = s;
+        }
+        return r;
+    }
+
+    /// Elimina v y hace que sus usos pasen a w (se aplica en normalizar)
+    void reemplazar(uint32_t v, uint32_t w)
+    {
+        if (reemplazo.size() < ins.size())
+            reemplazo.resize(ins.size(), NINGUNO);
+        reemplazo[v] = w;
+        ins[v].op = S_NADA;
+        ins[v].args.clear();
+    }
+
+    /// Aplica los reemplazos pendientes y saca de los bloques las instrucciones eliminadas
+    void normalizar()
+    {
+        for (BloqueSsa &b : bloques)
+        {
+            size_t j = 0;
+            for (uint32_t i : b.ins)
+                if (ins[i].op != S_NADA)
+                {
+                    if (!reemplazo.empty())
+                        operandos(ins[i], [&](uint32_t &a) { a = raiz(a); });
+                    b.ins[j++] = i;
+                }
+            b.ins.resize(j);
+        }
+        reemplazo.clear();
+    }
+
+    uint32_t nuevaIns(const InsSsa &x)
+    {
+        ins.push_back(x);
+        return ins.size() - 1;
+    }
+
+    uint32_t nuevoBloque()
+    {
+        bloques.emplace_back();
+        return bloques.size() - 1;
+    }
+
+    void agregarArista(uint32_t p, uint32_t s)
+    {
+        bloques[p].suc.push_back(s);
+        bloques[s].pred.push_back(p);
+    }
+
+    /// Quita la arista p -> s y el argumento que le corresponde en las phi de s
+    void quitarArista(uint32_t p, uint32_t s)
+    {
+        BloqueSsa &S = bloques[s];
+        size_t i = std::find(S.pred.begin(), S.pred.end(), p) - S.pred.begin();
+        S.pred.erase(S.pred.begin() + i);
+        for (uint32_t x : S.ins)
+        {
+            if (ins[x].op != S_PHI)
+                break;
+            ins[x].args.erase(ins[x].args.begin() + i);
+        }
+        BloqueSsa &P = bloques[p];
+        P.suc.erase(std::find(P.suc.begin(), P.suc.end(), s));
+    }
+
+    /// Elimina los bloques a los que no se llega desde la entrada
+    void quitarInalcanzables()
+    {
+        std::vector<char> visto(bloques.size(), 0);
+        std::vector<uint32_t> pila = {0};
+        visto[0] = 1;
+        while (!pila.empty())
+        {
+            uint32_t b = pila.back();
+            pila.pop_back();
+            for (uint32_t s : bloques[b].suc)
+                if (!visto[s])
+                {
+                    visto[s] = 1;
+                    pila.push_back(s);
+                }
+        }
+        for (uint32_t b = 0; b < bloques.size(); ++b)
+            if (!visto[b] && bloques[b].vivo)
+            {
+                std::vector<uint32_t> suc = bloques[b].suc;
+                for (uint32_t s : suc)
+                    if (visto[s])
+                        quitarArista(b, s);
+                for (uint32_t i : bloques[b].ins)
+                {
+                    ins[i].op = S_NADA;
+                    ins[i].args.clear();
+                }
+                bloques[b] = BloqueSsa();
+                bloques[b].vivo = false;
+            }
+    }
+
+    /// Quita las phi cuyos argumentos son todos el mismo valor (o la phi misma)
+    void simplificarPhis()
+    {
+        for (bool cambio = true; cambio;)
+        {
+            cambio = false;
+            for (BloqueSsa &b : bloques)
+                for (uint32_t i : b.ins)
+                {
+                    if (ins[i].op != S_PHI)
+                        break;
+                    uint32_t unico = NINGUNO;
+                    bool trivial = true;
+                    for (uint32_t a : ins[i].args)
+                    {
+                        a = raiz(a);
+                        if (a == i || a == unico)
+                            continue;
+                        if (unico != NINGUNO)
+                        {
+                            trivial = false;
+                            break;
+                        }
+                        unico = a;
+                    }
+                    if (!trivial)
+                        continue;
+                    if (unico == NINGUNO)
+                    {
+                        // solo se refiere a sí misma: la variable no tiene valor en ningún camino
+                        ins[i].op = S_CONST;
+                        ins[i].k = 0;
+                        ins[i].args.clear();
+                    }
+                    else
+                        reemplazar(i, unico);
+                    cambio = true;
+                }
+            normalizar();
+        }
+    }
+
+    /// Bloques vivos en orden posterior inverso desde la entrada
+    std::vector<uint32_t> ordenInverso() const
+    {
+        std::vector<uint32_t> orden;
+        std::vector<char> visto(bloques.size(), 0);
+        // pila de (bloque, siguiente sucesor por visitar)
+        std::vector<std::pair<uint32_t, uint32_t>> pila = {{0, 0}};
+        visto[0] = 1;
+        while (!pila.empty())
+        {
+            auto &[b, k] = pila.back();
+            if (k < bloques[b].suc.size())
+            {
+                uint32_t s = bloques[b].suc[k++];
+                if (!visto[s])
+                {
+                    visto[s] = 1;
+                    pila.push_back({s, 0});
+                }
+            }
+            else
+            {
+                orden.push_back(b);
+                pila.pop_back();
+            }
+        }
+        std::reverse(orden.begin(), orden.end());
+        return orden;
+    }
+
+    /// Instrucciones vivas (incluye phi y saltos)
+    size_t contar() const
+    {
+        size_t n = 0;
+        for (const BloqueSsa &b : bloques)
+            n += b.ins.size();
+        return n;
+    }
+
+    /// Separa las aristas de un bloque con varios sucesores a uno con varios predecesores, para
+    /// que las copias de las phi tengan dónde ir
+    void partirAristas()
+    {
+        uint32_t n = bloques.size();
+        for (uint32_t p = 0; p < n; ++p)
+        {
+            if (!bloques[p].vivo || bloques[p].suc.size() < 2)
+                continue;
+            for (size_t k = 0; k < bloques[p].suc.size(); ++k)
+            {
+                uint32_t s = bloques[p].suc[k];
+                if (bloques[s].pred.size() < 2)
+                    continue;
+                uint32_t e = nuevoBloque();
+                InsSsa salto;
+                salto.op = S_SALTA;
+                salto.tipo = D_VOID;
+                salto.bloque = e;
+                bloques[e].ins.push_back(nuevaIns(salto));
+                std::replace(bloques[s].pred.begin(), bloques[s].pred.end(), p, e);
+                bloques[e].pred = {p};
+                bloques[e].suc = {s};
+                bloques[p].suc[k] = e;
+            }
+        }
+    }
+
+    /// El bloque b es una cabecera corta (sin llamadas, termina en if) que se puede copiar en
+    /// lugar de saltar a ella, como la condición de un while al final de su cuerpo
+    bool copiable(uint32_t b) const
+    {
+        const std::vector<uint32_t> &l = bloques[b].ins;
+        if (ins[l.back()].op != S_SI)
+            return false;
+        size_t n = 0;
+        for (uint32_t i : l)
+            if (ins[i].op != S_PHI &&
+                (++n > 4 || ins[i].op == S_LLAMA || ins[i].op == S_PRINTI || ins[i].op == S_PRINTS))
+                return false;
+        return true;
+    }
+
+    template <class Lex>
+    void imprimir(std::ostream &out, const Lex &lex, const Ast &ast) const
+    {
+        out << lex.texto(ast.token(nodo)) << ":\n";
+        for (uint32_t b = 0; b < bloques.size(); ++b)
+        {
+            if (!bloques[b].vivo)
+                continue;
+            out << " b" << b << " (pred";
+            for (uint32_t p : bloques[b].pred)
+                out << " b" << p;
+            out << ")\n";
+            for (uint32_t i : bloques[b].ins)
+            {
+                const InsSsa &x = ins[i];
+                out << "    ";
+                if (x.tipo != D_VOID)
+                    out << "v" << i << " = ";
+                out << nombreOpSsa[x.op];
+                if (x.op == S_CONST)
+                    x.tipo == D_FLOAT ? out << " " << x.f : out << " " << x.k;
+                else if (x.op == S_PARAM || x.op == S_PRINTS || x.op == S_LLAMA)
+                    out << " " << x.k;
+                InsSsa copia = x;
+                operandos(copia, [&](uint32_t &a) { out << " v" << a; });
+                if (esTerminal(x.op))
+                    for (uint32_t s : bloques[b].suc)
+                        out << " b" << s;
+                out << "\n";
+            }
+        }
+    }
+};
+
+class ProgramaSsa
+{
+public:
+    std::vector<FuncionSsa> funciones;
+    std::vector<std::string> cadenas;
+    uint32_t principal = 0;
+
+    /// Instrucciones de las funciones vivas
+    size_t contar() const
+    {
+        size_t n = 0;
+        for (const FuncionSsa &f : funciones)
+            if (f.viva)
+                n += f.contar();
+        return n;
+    }
+};
+
+/**
+ * @brief Construye la forma SSA de un árbol sin errores semánticos, con las anotaciones que dejó
+ * Semantico::analizar sobre ese mismo árbol.
+ */
+class ConstructorSsa
+{
+    const Lexico &lex;
+    const Semantico &sem;
+    const Ast *ast = nullptr;
+    ProgramaSsa *prog = nullptr;
+    FuncionSsa *fn = nullptr;
+    uint32_t actual = 0;
+
+    /// Número de cada función, por nodo N_FUNCION
+    std::unordered_map<Indice, uint32_t> numero;
+    /// (declaración << 32 | bloque) -> valor de la variable al final del bloque, en una tabla de
+    /// direccionamiento abierto que se vacía en cada función sin liberar memoria
+    std::vector<uint64_t> claves = std::vector<uint64_t>(1024, VACIA);
+    std::vector<uint32_t> valores = std::vector<uint32_t>(1024);
+    size_t definiciones = 0;
+    static constexpr uint64_t VACIA = ~0ULL;
+    std::vector<char> sellado;
+    /// Phi creadas en bloques sin sellar, con la variable de cada una
+    std::vector<std::vector<std::pair<Indice, uint32_t>>> incompletas;
+
+    const Nodo &nodo(Indice n) const
+    {
+        return (*ast)[n];
+    }
+
+    uint32_t bloque()
+    {
+        sellado.push_back(0);
+        incompletas.emplace_back();
+        return fn->nuevoBloque();
+    }
+
+    uint32_t emitir(OpSsa op, TipoDato tipo, uint32_t a = NINGUNO, uint32_t b = NINGUNO)
+    {
+        InsSsa x;
+        x.op = op;
+        x.tipo = tipo;
+        x.bloque = actual;
+        x.a = a;
+        x.b = b;
+        uint32_t v = fn->nuevaIns(x);
+        fn->bloques[actual].ins.push_back(v);
+        return v;
+    }
+
+    uint32_t constante(TipoDato tipo, int32_t k)
+    {
+        uint32_t v = emitir(S_CONST, tipo);
+        fn->ins[v].k = k;
+        return v;
+    }
+
+    /// Termina el bloque actual con un salto a destino
+    void saltar(uint32_t destino)
+    {
+        emitir(S_SALTA, D_VOID);
+        fn->agregarArista(actual, destino);
+    }
+
+    size_t ranura(uint64_t clave) const
+    {
+        size_t m = claves.size() - 1, i = (clave * 0x9E3779B97F4A7C15ULL >> 32) & m;
+        while (claves[i] != VACIA && claves[i] != clave)
+            i = (i + 1) & m;
+        return i;
+    }
+
+    void escribir(Indice var, uint32_t b, uint32_t v)
+    {
+        uint64_t clave = uint64_t(var) << 32 | b;
+        size_t i = ranura(clave);
+        if (claves[i] == VACIA)
+        {
+            if (2 * (definiciones + 1) > claves.size())
+            {
+                std::vector<uint64_t> c(claves.size() * 2, VACIA);
+                std::vector<uint32_t> v2(c.size());
+                c.swap(claves);
+                v2.swap(valores);
+                for (size_t j = 0; j < c.size(); ++j)
+                    if (c[j] != VACIA)
+                    {
+                        size_t k = ranura(c[j]);
+                        claves[k] = c[j];
+                        valores[k] = v2[j];
+                    }
+                i = ranura(clave);
+            }
+            claves[i] = clave;
+            ++definiciones;
+        }
+        valores[i] = v;
+    }
+
+    uint32_t phi(uint32_t b, TipoDato tipo)
+    {
+        InsSsa x;
+        x.op = S_PHI;
+        x.tipo = tipo;
+        x.bloque = b;
+        uint32_t v = fn->nuevaIns(x);
+        std::vector<uint32_t> &l = fn->bloques[b].ins;
+        size_t i = 0;
+        while (i < l.size() && fn->ins[l[i]].op == S_PHI)
+            ++i;
+        l.insert(l.begin() + i, v);
+        return v;
+    }
+
+    void completar(Indice var, uint32_t p)
+    {
+        uint32_t b = fn->ins[p].bloque;
+        for (size_t i = 0; i < fn->bloques[b].pred.size(); ++i)
+        {
+            uint32_t a = leer(var, fn->bloques[b].pred[i]);
+            fn->ins[p].args.push_back(a);
+        }
+    }
+
+    /// Valor de la variable var al final del bloque b
+    uint32_t leer(Indice var, uint32_t b)
+    {
+        size_t i = ranura(uint64_t(var) << 32 | b);
+        if (claves[i] != VACIA)
+            return valores[i];
+        uint32_t v;
+        const BloqueSsa &B = fn->bloques[b];
+        if (!sellado[b])
+        {
+            v = phi(b, sem.tipo(var));
+            incompletas[b].push_back({var, v});
+        }
+        else if (B.pred.size() == 1)
+            v = leer(var, B.pred[0]);
+        else if (B.pred.empty())
+        {
+            // código al que no se llega (o una variable leída antes de su declaración)
+            uint32_t guardado = actual;
+            actual = b;
+            v = constante(sem.tipo(var), 0);
+            std::vector<uint32_t> &l = fn->bloques[b].ins;
+            l.insert(l.begin(), l.back()); // al principio, antes de lo que ya se emitió
+            l.pop_back();
+            actual = guardado;
+        }
+        else
+        {
+            v = phi(b, sem.tipo(var));
+            escribir(var, b, v); // corta los ciclos
+            completar(var, v);
+        }
+        escribir(var, b, v);
+        return v;
+    }
+
+    void sellar(uint32_t b)
+    {
+        sellado[b] = 1;
+        for (auto [var, p] : incompletas[b])
+            completar(var, p);
+        incompletas[b].clear();
+    }
+
+    uint32_t como(uint32_t v, TipoDato tipo)
+    {
+        return tipo == D_FLOAT && fn->ins[v].tipo == D_INT ? emitir(S_AF, D_FLOAT, v) : v;
+    }
+
+    uint32_t llamada(Indice n)
+    {
+        Indice f = sem.enlace(n);
+        Indice arg = nodo(n).hijo;
+        if (f == PREDEFINIDA(P_PRINTI))
+            return emitir(S_PRINTI, D_VOID, expresion(arg));
+        if (f == PREDEFINIDA(P_PRINTS))
+        {
+            prog->cadenas.push_back(valorCadena(lex.texto(ast->token(arg))));
+            uint32_t v = emitir(S_PRINTS, D_VOID);
+            fn->ins[v].k = prog->cadenas.size() - 1;
+            return v;
+        }
+        std::vector<uint32_t> args;
+        for (Indice p = nodo(f).hijo; arg != NINGUNO; arg = nodo(arg).hermano, p = nodo(p).hermano)
+            args.push_back(como(expresion(arg), sem.tipo(p)));
+        TipoDato r = nodo(f).op == T_FLOAT ? D_FLOAT : nodo(f).op == T_INT ? D_INT : D_VOID;
+        uint32_t v = emitir(S_LLAMA, r);
+        fn->ins[v].k = numero[f];
+        fn->ins[v].args = std::move(args);
+        return v;
+    }
+
+    uint32_t expresion(Indice n)
+    {
+        const Nodo &x = nodo(n);
+        TipoDato t = sem.tipo(n);
+        switch (x.tipo)
+        {
+        case N_ENTERO:
+            return constante(D_INT, valorEntero(lex.texto(ast->token(n))));
+        case N_REAL:
+        {
+            uint32_t v = constante(D_FLOAT, 0);
+            fn->ins[v].f = valorReal(lex.texto(ast->token(n)));
+            return v;
+        }
+        case N_ID:
+            return leer(sem.enlace(n), actual);
+        case N_LLAMADA:
+            return llamada(n);
+        case N_UNARIA:
+        {
+            uint32_t a = expresion(x.hijo);
+            return emitir(x.op == T_NOT ? S_NOT : S_NEG, t, a);
+        }
+        case N_BINARIA:
+        {
+            Indice izq = x.hijo, der = nodo(izq).hermano;
+            if (x.op == T_AND || x.op == T_OR)
+            {
+                // corto circuito: der se evalúa en su propio bloque y una phi junta los resultados
+                uint32_t l = emitir(S_LOG, D_INT, expresion(izq));
+                uint32_t desde = actual, bDer = bloque(), fin = bloque();
+                emitir(S_SI, D_VOID, l);
+                fn->agregarArista(desde, x.op == T_AND ? bDer : fin);
+                fn->agregarArista(desde, x.op == T_AND ? fin : bDer);
+                sellar(bDer);
+                actual = bDer;
+                uint32_t r = emitir(S_LOG, D_INT, expresion(der));
+                saltar(fin);
+                sellar(fin);
+                actual = fin;
+                uint32_t p = phi(fin, D_INT);
+                fn->ins[p].args = {l, r};
+                return p;
+            }
+            TipoDato o = sem.tipo(izq) == D_FLOAT || sem.tipo(der) == D_FLOAT ? D_FLOAT : D_INT;
+            uint32_t a = como(expresion(izq), o);
+            uint32_t b = como(expresion(der), o);
+            OpSsa op;
+            switch (x.op)
+            {
+            case T_MAS:
+                op = S_SUMA;
+                break;
+            case T_MENOS:
+                op = S_RESTA;
+                break;
+            case T_POR:
+                op = S_MUL;
+                break;
+            case T_ENTRE:
+                op = S_DIV;
+                break;
+            case T_MENOR:
+                op = S_MENOR;
+                break;
+            case T_MAYOR:
+                op = S_MAYOR;
+                break;
+            case T_MENORIG:
+                op = S_MENORIG;
+                break;
+            case T_MAYORIG:
+                op = S_MAYORIG;
+                break;
+            case T_IGUAL:
+                op = S_IGUAL;
+                break;
+            default:
+                op = S_DIST;
+            }
+            return emitir(op, t, a, b);
+        }
+        default:
+            return constante(D_INT, 0);
+        }
+    }
+
+    void instruccion(Indice n)
+    {
+        const Nodo &x = nodo(n);
+        switch (x.tipo)
+        {
+        case N_BLOQUE:
+            for (Indice i = x.hijo; i != NINGUNO; i = nodo(i).hermano)
+                instruccion(i);
+            break;
+        case N_DECLARACION:
+            for (Indice v = x.hijo; v != NINGUNO; v = nodo(v).hermano)
+            {
+                TipoDato t = sem.tipo(v);
+                uint32_t valor = nodo(v).hijo != NINGUNO ? como(expresion(nodo(v).hijo), t) : constante(t, 0);
+                escribir(v, actual, valor);
+            }
+            break;
+        case N_ASIGNACION:
+        {
+            Indice v = sem.enlace(n);
+            uint32_t valor = como(expresion(x.hijo), sem.tipo(v));
+            escribir(v, actual, valor);
+            break;
+        }
+        case N_SI:
+        {
+            Indice entonces = nodo(x.hijo).hermano, sino = nodo(entonces).hermano;
+            uint32_t c = expresion(x.hijo);
+            uint32_t bEntonces = bloque(), bSino = sino != NINGUNO ? bloque() : NINGUNO, fin = bloque();
+            emitir(S_SI, D_VOID, c);
+            fn->agregarArista(actual, bEntonces);
+            fn->agregarArista(actual, sino != NINGUNO ? bSino : fin);
+            sellar(bEntonces);
+            actual = bEntonces;
+            instruccion(entonces);
+            saltar(fin);
+            if (sino != NINGUNO)
+            {
+                sellar(bSino);
+                actual = bSino;
+                instruccion(sino);
+                saltar(fin);
+            }
+            sellar(fin);
+            actual = fin;
+            break;
+        }
+        case N_MIENTRAS:
+        {
+            uint32_t cabeza = bloque();
+            saltar(cabeza);
+            actual = cabeza;
+            uint32_t c = expresion(x.hijo);
+            uint32_t cuerpo = bloque(), fin = bloque();
+            emitir(S_SI, D_VOID, c);
+            fn->agregarArista(actual, cuerpo);
+            fn->agregarArista(actual, fin);
+            sellar(cuerpo);
+            actual = cuerpo;
+            instruccion(nodo(x.hijo).hermano);
+            saltar(cabeza);
+            sellar(cabeza);
+            sellar(fin);
+            actual = fin;
+            break;
+        }
+        case N_RETORNO:
+            emitir(S_REGRESA, D_VOID, x.hijo == NINGUNO ? NINGUNO : como(expresion(x.hijo), fn->retorno));
+            // lo que sigue en el bloque no se ejecuta; queda en un bloque sin predecesores
+            actual = bloque();
+            sellar(actual);
+            break;
+        case N_LLAMADA:
+            llamada(n);
+            break;
+        default:
+            break;
+        }
+    }
+
+    void funcion(Indice f, FuncionSsa &destino)
+    {
+        fn = &destino;
+        std::fill(claves.begin(), claves.end(), VACIA);
+        definiciones = 0;
+        sellado.clear();
+        incompletas.clear();
+        const Nodo &x = nodo(f);
+        fn->nodo = f;
+        fn->retorno = x.op == T_FLOAT ? D_FLOAT : x.op == T_INT ? D_INT : D_VOID;
+        actual = bloque();
+        sellar(actual);
+        for (Indice h = x.hijo; h != NINGUNO; h = nodo(h).hermano)
+            if (nodo(h).tipo == N_PARAMETRO)
+            {
+                uint32_t v = emitir(S_PARAM, sem.tipo(h));
+                fn->ins[v].k = fn->parametros++;
+                escribir(h, actual, v);
+            }
+            else
+                instruccion(h);
+        // al final de la función sin return: una función int o float regresa 0
+        emitir(S_REGRESA, D_VOID, fn->retorno == D_VOID ? NINGUNO : constante(fn->retorno, 0));
+        fn->quitarInalcanzables();
+        fn->simplificarPhis();
+    }
+
+public:
+    ConstructorSsa(const Lexico &lex, const Semantico &sem) : lex(lex), sem(sem) {}
+
+    /// Construye la forma SSA de arbol, que ya revisó sem sin errores
+    void construir(const Ast &arbol, ProgramaSsa &p)
+    {
+        TRAZA("ConstructorSsa::construir");
+        ast = &arbol;
+        prog = &p;
+        p.funciones.clear();
+        p.cadenas.clear();
+        numero.clear();
+        for (Indice f = arbol[0].hijo; f != NINGUNO; f = arbol[f].hermano)
+        {
+            if (lex.texto(arbol.token(f)) == "main")
+                p.principal = numero.size();
+            numero[f] = numero.size();
+        }
+        p.funciones.resize(numero.size());
+        for (Indice f = arbol[0].hijo; f != NINGUNO; f = arbol[f].hermano)
+            funcion(f, p.funciones[numero[f]]);
+    }
+};
+
+/**
+ * @brief Vida de los valores de una función para asignarles registros: un orden lineal de los
+ * bloques (orden posterior inverso), una posición por instrucción y, para cada valor, el
+ * intervalo desde su definición hasta su último uso o hasta el final del último bloque del que
+ * sale vivo. Los intervalos son envolventes: un valor vivo en un ciclo ocupa todo el ciclo.
+ *
+ * Qué operandos ocupan un registro lo decide quien la calcula (un operando constante puede ir
+ * en la instrucción misma); los que no, no cuentan como usos ni alargan la vida del valor.
+ */
+struct VidaSsa
+{
+    std::vector<uint32_t> orden;
+    /// Posición de cada instrucción; las phi toman la del inicio de su bloque y los
+    /// parámetros la 0
+    std::vector<uint32_t> pos;
+    /// Última posición en que cada valor sigue vivo
+    std::vector<uint32_t> fin;
+    /// Posición del final de cada bloque, después de su última instrucción
+    std::vector<uint32_t> finBloque;
+    /// Usos de cada valor que necesitan un registro
+    std::vector<uint32_t> usos;
+
+    /**
+     * @param f Función con las aristas críticas ya partidas
+     * @param enRegistro enRegistro(x, a) dice si el operando a de la instrucción x (una
+     * referencia a x.a, x.b o a uno de x.args) necesita estar en un registro
+     */
+    template <class EnRegistro>
+    void calcular(FuncionSsa &f, EnRegistro enRegistro)
+    {
+        size_t nv = f.ins.size(), nb = f.bloques.size();
+        size_t palabras = (nv + 63) / 64;
+        orden = f.ordenInverso();
+        usos.assign(nv, 0);
+        for (uint32_t b : orden)
+            for (uint32_t i : f.bloques[b].ins)
+            {
+                InsSsa &x = f.ins[i];
+                FuncionSsa::operandos(x, [&](uint32_t &a) {
+                    if (enRegistro(x, a))
+                        ++usos[a];
+                });
+            }
+
+        pos.assign(nv, 0);
+        finBloque.assign(nb, 0);
+        uint32_t p = 0;
+        for (uint32_t b : orden)
+        {
+            for (uint32_t i : f.bloques[b].ins)
+            {
+                if (f.ins[i].op != S_PHI)
+                    p += 2;
+                pos[i] = f.ins[i].op == S_PARAM ? 0 : p;
+            }
+            finBloque[b] = ++p;
+            p += 2;
+        }
+
+        // vida: vivos[b] = valores vivos al entrar a b, hasta llegar a un punto fijo
+        std::vector<std::vector<uint64_t>> vivos(nb, std::vector<uint64_t>(palabras, 0));
+        std::vector<std::vector<uint64_t>> salen(nb, std::vector<uint64_t>(palabras, 0));
+        auto poner = [](std::vector<uint64_t> &s, uint32_t v) { s[v >> 6] |= 1ULL << (v & 63); };
+        auto quitar = [](std::vector<uint64_t> &s, uint32_t v) { s[v >> 6] &= ~(1ULL << (v & 63)); };
+        for (bool cambio = true; cambio;)
+        {
+            cambio = false;
+            for (size_t k = orden.size(); k-- > 0;)
+            {
+                uint32_t b = orden[k];
+                std::vector<uint64_t> s(palabras, 0);
+                for (uint32_t su : f.bloques[b].suc)
+                {
+                    for (size_t w = 0; w < palabras; ++w)
+                        s[w] |= vivos[su][w];
+                    size_t j = std::find(f.bloques[su].pred.begin(), f.bloques[su].pred.end(), b) -
+                               f.bloques[su].pred.begin();
+                    for (uint32_t i : f.bloques[su].ins)
+                    {
+                        InsSsa &x = f.ins[i];
+                        if (x.op != S_PHI)
+                            break;
+                        quitar(s, i);
+                        if (usos[i] && enRegistro(x, x.args[j]))
+                            poner(s, x.args[j]);
+                    }
+                }
+                salen[b] = s;
+                const std::vector<uint32_t> &l = f.bloques[b].ins;
+                for (size_t k2 = l.size(); k2-- > 0;)
+                {
+                    InsSsa &x = f.ins[l[k2]];
+                    quitar(s, l[k2]);
+                    if (x.op == S_PHI)
+                        continue;
+                    FuncionSsa::operandos(x, [&](uint32_t &a) {
+                        if (enRegistro(x, a))
+                            poner(s, a);
+                    });
+                }
+                if (s != vivos[b])
+                {
+                    vivos[b] = std::move(s);
+                    cambio = true;
+                }
+            }
+        }
+
+        // intervalos: del punto de definición al último uso o salida viva
+        fin.assign(nv, 0);
+        for (uint32_t b : orden)
+        {
+            for (uint32_t i : f.bloques[b].ins)
+            {
+                InsSsa &x = f.ins[i];
+                if (x.op == S_PHI)
+                    continue;
+                FuncionSsa::operandos(x, [&](uint32_t &a) {
+                    if (enRegistro(x, a))
+                        fin[a] = std::max(fin[a], pos[i]);
+                });
+            }
+            for (size_t w = 0; w < palabras; ++w)
+                for (uint64_t m = salen[b][w]; m; m &= m - 1)
+                    fin[w * 64 + __builtin_ctzll(m)] = std::max(fin[w * 64 + __builtin_ctzll(m)], finBloque[b]);
+        }
+    }
+};
+
+/**
+ * @brief Convierte un ProgramaSsa en un Programa de bytecode.h. Las funciones eliminadas no se
+ * emiten y las demás se renumeran.
+ */
+class TraductorBytecode
+{
+    ProgramaSsa *prog = nullptr;
+    Programa *salida = nullptr;
+    FuncionSsa *fn = nullptr;
+    std::vector<uint32_t> numero;
+
+    VidaSsa vida;
+    std::vector<uint32_t> registro;
+    /// Registro donde empieza el marco de cada llamada: el primero arriba de los valores que
+    /// siguen vivos después de ella
+    std::vector<uint32_t> marco;
+    uint16_t auxiliar = 0;
+    std::string error;
+
+    bool cabeEnK(uint32_t v, bool negar) const
+    {
+        const InsSsa &c = fn->ins[v];
+        if (c.op != S_CONST || c.tipo != D_INT)
+            return false;
+        int64_t k = negar ? -int64_t(c.k) : c.k;
+        return k >= -32768 && k <= 32767;
+    }
+
+    /// La suma o resta int x se emite como SUMAIK con su segundo operando constante
+    bool inmediato(const InsSsa &x) const
+    {
+        return (x.op == S_SUMA || x.op == S_RESTA) && x.tipo == D_INT && cabeEnK(x.b, x.op == S_RESTA);
+    }
+
+    /// El operando a de x ocupa un registro (el segundo de SUMAIK va en la instrucción)
+    bool enRegistro(const InsSsa &x, const uint32_t &a) const
+    {
+        return !(&a == &x.b && inmediato(x));
+    }
+
+    /// Registros con recorrido lineal sobre intervalos [definición, último punto vivo]
+    void asignarRegistros()
+    {
+        size_t nv = fn->ins.size();
+        const std::vector<uint32_t> &pos = vida.pos, &fin = vida.fin, &usos = vida.usos;
+        // la phi prefiere el registro de un argumento y el argumento el de su phi
+        std::vector<uint32_t> phiDe(nv, NINGUNO);
+        std::vector<uint32_t> valores;
+        for (uint32_t b : vida.orden)
+            for (uint32_t i : fn->bloques[b].ins)
+            {
+                if (fn->ins[i].op == S_PHI && usos[i])
+                    for (uint32_t a : fn->ins[i].args)
+                        if (phiDe[a] == NINGUNO)
+                            phiDe[a] = i;
+                if ((fn->ins[i].tipo != D_VOID && usos[i]) || fn->ins[i].op == S_LLAMA)
+                    valores.push_back(i);
+            }
+        std::stable_sort(valores.begin(), valores.end(), [&](uint32_t x, uint32_t y) {
+            return pos[x] < pos[y] || (pos[x] == pos[y] && fn->ins[x].op == S_PARAM && fn->ins[y].op != S_PARAM);
+        });
+
+        registro.assign(nv, NINGUNO);
+        marco.assign(nv, 0);
+        std::vector<uint32_t> ocupante; // valor en cada registro, NINGUNO si está libre
+        uint32_t maximo = fn->parametros;
+        ocupante.assign(fn->parametros, NINGUNO);
+        auto libre = [&](uint32_t r, uint32_t desde) {
+            return r < ocupante.size() && (ocupante[r] == NINGUNO || fin[ocupante[r]] <= desde);
+        };
+        for (uint32_t v : valores)
+        {
+            InsSsa &x = fn->ins[v];
+            uint32_t r = NINGUNO;
+            if (x.op == S_LLAMA)
+            {
+                // el último ocupante de cada registro es el único que puede seguir vivo
+                for (uint32_t k = 0; k < ocupante.size(); ++k)
+                    if (ocupante[k] != NINGUNO && fin[ocupante[k]] > pos[v])
+                        marco[v] = k + 1;
+                if (x.tipo == D_VOID || !usos[v])
+                    continue;
+                // el resultado queda en el primer registro del marco
+                r = marco[v];
+                if (r >= ocupante.size())
+                    ocupante.resize(r + 1, NINGUNO);
+            }
+            else if (x.op == S_PARAM)
+                r = x.k;
+            else
+            {
+                if (x.op == S_PHI)
+                    for (uint32_t a : x.args)
+                        if (registro[a] != NINGUNO && libre(registro[a], pos[v]))
+                        {
+                            r = registro[a];
+                            break;
+                        }
+                if (r == NINGUNO && phiDe[v] != NINGUNO && registro[phiDe[v]] != NINGUNO &&
+                    libre(registro[phiDe[v]], pos[v]))
+                    r = registro[phiDe[v]];
+                for (uint32_t k = 0; r == NINGUNO && k < ocupante.size(); ++k)
+                    if (libre(k, pos[v]))
+                        r = k;
+                if (r == NINGUNO)
+                {
+                    r = ocupante.size();
+                    ocupante.push_back(NINGUNO);
+                }
+            }
+            if (r >= 0xfff0)
+            {
+                error = "la función usa más de 65520 registros";
+                return;
+            }
+            ocupante[r] = v;
+            registro[v] = r;
+            maximo = std::max(maximo, r + 1);
+        }
+        auxiliar = maximo;
+    }
+
+    size_t emitir(CodigoOp op, uint16_t a = 0, uint16_t b = 0, uint16_t c = 0)
+    {
+        Instr x{op, a, {}};
+        x.r.b = b;
+        x.r.c = c;
+        salida->codigo.push_back(x);
+        return salida->codigo.size() - 1;
+    }
+
+    size_t emitirK(CodigoOp op, uint16_t a, int32_t k)
+    {
+        Instr x{op, a, {}};
+        x.k = k;
+        salida->codigo.push_back(x);
+        return salida->codigo.size() - 1;
+    }
+
+    /// Emite las copias (destino, origen) como si fueran simultáneas; temporal no debe ser
+    /// destino ni origen de ninguna
+    void copiasParalelas(std::vector<std::pair<uint16_t, uint16_t>> &copias, uint16_t temporal)
+    {
+        // se emite primero la copia cuyo destino ya nadie lee; en un ciclo, un origen pasa al temporal
+        while (!copias.empty())
+        {
+            bool hecho = false;
+            for (size_t k = 0; k < copias.size() && !hecho; ++k)
+            {
+                uint16_t d = copias[k].first;
+                if (std::none_of(copias.begin(), copias.end(), [&](auto &c) { return c.second == d; }))
+                {
+                    emitir(OP_MOV, d, copias[k].second);
+                    copias.erase(copias.begin() + k);
+                    hecho = true;
+                }
+            }
+            if (!hecho)
+            {
+                uint16_t d = copias[0].first;
+                emitir(OP_MOV, temporal, d);
+                for (auto &c : copias)
+                    if (c.second == d)
+                        c.second = temporal;
+            }
+        }
+    }
+
+    /// Copias en paralelo de las phi del sucesor s al final del bloque b
+    void copiasPhi(uint32_t b, uint32_t s)
+    {
+        const BloqueSsa &S = fn->bloques[s];
+        size_t j = std::find(S.pred.begin(), S.pred.end(), b) - S.pred.begin();
+        std::vector<std::pair<uint16_t, uint16_t>> copias; // (destino, origen)
+        for (uint32_t i : S.ins)
+        {
+            if (fn->ins[i].op != S_PHI)
+                break;
+            if (!vida.usos[i])
+                continue;
+            uint16_t d = registro[i], o = registro[fn->ins[i].args[j]];
+            if (d != o)
+                copias.push_back({d, o});
+        }
+        copiasParalelas(copias, auxiliar);
+    }
+
+    /// Registros que necesita la llamada i: su marco con los argumentos y un temporal arriba
+    uint32_t registrosLlamada(uint32_t i) const
+    {
+        return std::max<uint32_t>(auxiliar, marco[i] + fn->ins[i].args.size()) + 1;
+    }
+
+    void instruccion(uint32_t i, size_t siguiente, std::vector<std::pair<size_t, uint32_t>> &saltos)
+    {
+        InsSsa &x = fn->ins[i];
+        uint16_t d = registro[i] == NINGUNO ? auxiliar : registro[i];
+        auto R = [&](uint32_t v) { return uint16_t(registro[v]); };
+        bool real = x.a != NINGUNO && fn->ins[x.a].tipo == D_FLOAT;
+        if (x.tipo != D_VOID && !vida.usos[i] && fn->pura(i))
+            return;
+        switch (x.op)
+        {
+        case S_CONST:
+            emitirK(OP_CARGA, d, x.k);
+            break;
+        case S_SUMA:
+        case S_RESTA:
+            if (inmediato(x))
+            {
+                int32_t k = fn->ins[x.b].k;
+                emitir(OP_SUMAIK, d, R(x.a), uint16_t(x.op == S_RESTA ? -k : k));
+                break;
+            }
+            emitir(x.op == S_SUMA ? (real ? OP_SUMAF : OP_SUMAI) : (real ? OP_RESTAF : OP_RESTAI), d, R(x.a), R(x.b));
+            break;
+        case S_MUL:
+            emitir(real ? OP_MULF : OP_MULI, d, R(x.a), R(x.b));
+            break;
+        case S_DIV:
+            emitir(real ? OP_DIVF : OP_DIVI, d, R(x.a), R(x.b));
+            break;
+        case S_MENOR:
+        case S_MAYOR:
+        case S_MENORIG:
+        case S_MAYORIG:
+        case S_IGUAL:
+        case S_DIST:
+            emitir(CodigoOp((real ? OP_MENORF : OP_MENORI) + (x.op - S_MENOR)), d, R(x.a), R(x.b));
+            break;
+        case S_NEG:
+            emitir(real ? OP_NEGF : OP_NEGI, d, R(x.a));
+            break;
+        case S_NOT:
+            emitir(real ? OP_NOTF : OP_NOTI, d, R(x.a));
+            break;
+        case S_LOG:
+            emitir(real ? OP_LOGF : OP_LOGI, d, R(x.a));
+            break;
+        case S_AF:
+            emitir(OP_AF, d, R(x.a));
+            break;
+        case S_LLAMA:
+        {
+            // los argumentos pueden estar ya dentro del marco, así que se copian como phi
+            std::vector<std::pair<uint16_t, uint16_t>> copias;
+            for (size_t k = 0; k < x.args.size(); ++k)
+                if (marco[i] + k != R(x.args[k]))
+                    copias.push_back({uint16_t(marco[i] + k), R(x.args[k])});
+            copiasParalelas(copias, registrosLlamada(i) - 1);
+            emitirK(OP_LLAMA, marco[i], numero[x.k]);
+            if (vida.usos[i] && d != marco[i])
+                emitir(OP_MOV, d, marco[i]);
+            break;
+        }
+        case S_PRINTI:
+            emitir(OP_PRINTI, R(x.a));
+            break;
+        case S_PRINTS:
+            emitirK(OP_PRINTS, 0, x.k);
+            break;
+        case S_SALTA:
+        {
+            uint32_t s = fn->bloques[x.bloque].suc[0];
+            copiasPhi(x.bloque, s);
+            if (s == siguiente)
+                break;
+            // las phi de s ya se copiaron y sus sucesores no tienen phi (las aristas críticas
+            // están partidas), así que ejecutar aquí su código equivale a saltar a él
+            if (s != x.bloque && fn->copiable(s))
+            {
+                for (uint32_t j : fn->bloques[s].ins)
+                    if (fn->ins[j].op != S_PHI)
+                        instruccion(j, siguiente, saltos);
+                break;
+            }
+            saltos.push_back({emitirK(OP_SALTA, 0, 0), s});
+            break;
+        }
+        case S_SI:
+        {
+            uint32_t v = fn->bloques[x.bloque].suc[0], f = fn->bloques[x.bloque].suc[1];
+            uint16_t c = R(x.a);
+            if (real)
+            {
+                emitir(OP_LOGF, auxiliar, c);
+                c = auxiliar;
+            }
+            if (v == siguiente)
+                saltos.push_back({emitirK(OP_SALTAF, c, 0), f});
+            else
+            {
+                saltos.push_back({emitirK(OP_SALTAV, c, 0), v});
+                if (f != siguiente)
+                    saltos.push_back({emitirK(OP_SALTA, 0, 0), f});
+            }
+            break;
+        }
+        case S_REGRESA:
+            if (x.a == NINGUNO)
+                emitir(OP_REGRESAV);
+            else
+                emitir(OP_REGRESA, R(x.a));
+            break;
+        default:
+            break;
+        }
+    }
+
+    void funcion(FuncionSsa &f, FuncionBC &destino)
+    {
+        fn = &f;
+        f.simplificarPhis(); // un bloque con un solo predecesor no debe tener phi
+        f.partirAristas();
+        vida.calcular(f, [&](const InsSsa &x, const uint32_t &a) { return enRegistro(x, a); });
+        asignarRegistros();
+        if (!error.empty())
+            return;
+
+        uint32_t registros = auxiliar + 1;
+        std::vector<uint32_t> direccion(f.bloques.size(), 0);
+        std::vector<std::pair<size_t, uint32_t>> saltos;
+        destino.inicio = salida->codigo.size();
+        for (size_t k = 0; k < vida.orden.size(); ++k)
+        {
+            uint32_t b = vida.orden[k];
+            direccion[b] = salida->codigo.size();
+            size_t siguiente = k + 1 < vida.orden.size() ? vida.orden[k + 1] : NINGUNO;
+            for (uint32_t i : f.bloques[b].ins)
+                if (f.ins[i].op != S_PHI)
+                {
+                    if (f.ins[i].op == S_LLAMA)
+                        registros = std::max(registros, registrosLlamada(i));
+                    instruccion(i, siguiente, saltos);
+                }
+        }
+        for (auto [i, b] : saltos)
+            salida->codigo[i].k = direccion[b];
+        destino.parametros = f.parametros;
+        if (registros > 0xffff)
+        {
+            error = "la función usa más de 65535 registros";
+            return;
+        }
+        destino.registros = registros;
+        destino.nodo = f.nodo;
+    }
+
+public:
+    /**
+     * @brief Traduce p (que se modifica: se parten sus aristas críticas) a bytecode en destino.
+     * @return false si alguna función no cabe en los registros (ver mensaje())
+     */
+    bool traducir(ProgramaSsa &p, Programa &destino)
+    {
+        TRAZA("TraductorBytecode::traducir");
+        prog = &p;
+        salida = &destino;
+        destino.limpiar();
+        destino.cadenas = p.cadenas;
+        error.clear();
+        numero.assign(p.funciones.size(), NINGUNO);
+        for (size_t f = 0; f < p.funciones.size(); ++f)
+            if (p.funciones[f].viva)
+            {
+                numero[f] = destino.funciones.size();
+                destino.funciones.push_back(FuncionBC{0, 0, 0, p.funciones[f].nodo});
+            }
+        destino.principal = numero[p.principal];
+        for (size_t f = 0; f < p.funciones.size() && error.empty(); ++f)
+            if (p.funciones[f].viva)
+                funcion(p.funciones[f], destino.funciones[numero[f]]);
+        return error.empty();
+    }
+
+    const std::string &mensaje() const
+    {
+        return error;
+    }
+};
+
+#endif
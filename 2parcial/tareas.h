@@ -0,0 +1,161 @@
+/**
+ * @file    tareas.h
+ * @version 1.0
+ * @date    19/10/2026
+ * @title   Grupo de hilos con robo de tareas
+ * @brief   Cada hilo tiene su propia cola de tareas: agrega y toma de su extremo final (la última
+ *          tarea agregada, cuyos datos siguen en su caché) y, cuando se queda sin trabajo, roba
+ *          del extremo inicial de la cola de otro hilo (la tarea más vieja). Una tarea puede
+ *          agregar otras, así que las etapas de un archivo (léxico -> sintáctico -> semántico)
+ *          forman una cadena que tiende a quedarse en el mismo hilo.
+ */
+
+#ifndef TAREAS_H
+#define TAREAS_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../comun/traza.h"
+
+class PoolTareas
+{
+    /// Cola de un hilo; en su propia línea de caché para que los candados no se estorben
+    struct alignas(64) Cola
+    {
+        std::mutex m;
+        std::deque<std::function<void()>> tareas;
+    };
+
+    std::vector<Cola> colas;
+    std::vector<std::thread> hilos;
+
+    /// Tareas en las colas, y tareas agregadas que todavía no terminan
+    std::atomic<size_t> encoladas{0};
+    std::atomic<size_t> pendientes{0};
+
+    /// Los hilos sin trabajo duermen aquí; esperar() también
+    std::mutex mDormir;
+    std::condition_variable hayTrabajo, terminaron;
+    bool salir = false;
+
+    /// Número de hilo del grupo que ejecuta el código, -1 fuera del grupo
+    static int &indice()
+    {
+        static thread_local int i = -1;
+        return i;
+    }
+
+    /// Toma una tarea: primero del final de la cola propia, luego del inicio de las demás
+    bool tomar(int yo, std::function<void()> &f)
+    {
+        {
+            Cola &c = colas[yo];
+            std::lock_guard<std::mutex> g(c.m);
+            if (!c.tareas.empty())
+            {
+                f = std::move(c.tareas.back());
+                c.tareas.pop_back();
+                return true;
+            }
+        }
+        for (size_t k = 1; k < colas.size(); ++k)
+        {
+            Cola &c = colas[(yo + k) % colas.size()];
+            std::lock_guard<std::mutex> g(c.m);
+            if (!c.tareas.empty())
+            {
+                f = std::move(c.tareas.front());
+                c.tareas.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void trabajar(int yo)
+    {
+        indice() = yo;
+        TRAZA_HILO("tareas " + std::to_string(yo));
+        std::function<void()> f;
+        for (;;)
+        {
+            if (tomar(yo, f))
+            {
+                encoladas.fetch_sub(1);
+                f();
+                f = nullptr;
+                if (pendientes.fetch_sub(1) == 1)
+                {
+                    std::lock_guard<std::mutex> g(mDormir);
+                    terminaron.notify_all();
+                }
+                continue;
+            }
+            std::unique_lock<std::mutex> g(mDormir);
+            hayTrabajo.wait(g, [&] { return salir || encoladas.load() > 0; });
+            if (salir && encoladas.load() == 0)
+                return;
+        }
+    }
+
+public:
+    /// @param n Número de hilos (por omisión, uno por núcleo)
+    explicit PoolTareas(unsigned n = std::thread::hardware_concurrency())
+        : colas(n ? n : 1)
+    {
+        for (unsigned i = 0; i < colas.size(); ++i)
+            hilos.emplace_back(&PoolTareas::trabajar, this, i);
+    }
+
+    PoolTareas(const PoolTareas &) = delete;
+    PoolTareas &operator=(const PoolTareas &) = delete;
+
+    ~PoolTareas()
+    {
+        {
+            std::lock_guard<std::mutex> g(mDormir);
+            salir = true;
+        }
+        hayTrabajo.notify_all();
+        for (std::thread &h : hilos)
+            h.join();
+    }
+
+    /**
+     * @brief Agrega una tarea. Desde una tarea del grupo va a la cola del mismo hilo; desde fuera,
+     * las tareas se reparten entre las colas.
+     */
+    void agregar(std::function<void()> f)
+    {
+        static std::atomic<unsigned> turno{0};
+        int yo = indice();
+        Cola &c = colas[yo >= 0 ? yo : turno.fetch_add(1) % colas.size()];
+        pendientes.fetch_add(1);
+        {
+            std::lock_guard<std::mutex> g(c.m);
+            c.tareas.push_back(std::move(f));
+        }
+        encoladas.fetch_add(1);
+        std::lock_guard<std::mutex> g(mDormir);
+        hayTrabajo.notify_one();
+    }
+
+    /// Espera a que terminen todas las tareas agregadas (y las que estas agreguen)
+    void esperar()
+    {
+        std::unique_lock<std::mutex> g(mDormir);
+        terminaron.wait(g, [&] { return pendientes.load() == 0; });
+    }
+
+    size_t size() const
+    {
+        return colas.size();
+    }
+};
+
+#endif
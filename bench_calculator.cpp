@@ -0,0 +1,134 @@
+// bench_calculator.cpp
+
+//
+// Compares starting the calculator from a text file of expressions with
+// starting it from a compiled module (calculator_module.h). From text, the
+// file is read and each expression is scanned, minus-fixed, converted to
+// postfix and evaluated; from a module, the file is mapped, its header
+// checked, and the stored postfix evaluated in place. For each side it
+// reports the time to the first result and to all the results (best of 5),
+// and it checks that both give the same results.
+//
+// The files come from the page cache, not from the disk.
+//
+//   g++ -std=c++17 -O2 bench_calculator.cpp -o bench_calculator
+//   ./bench_calculator [number of expressions]
+//
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include "calculator.h"
+#include "calculator_module.h"
+
+double now()
+{
+   return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// A random expression with up to depth levels of parentheses.
+string random_expression(mt19937 &rng, int depth)
+{
+   const char *ops[] = {" + ", " - ", " * ", " / "};
+   string e;
+   int terms = 1 + rng() % 4;
+   for (int i = 0; i < terms; ++i)
+   {
+      if (i > 0)
+      {
+         e += ops[rng() % 4];
+      }
+      if (rng() % 5 == 0)
+      {
+         e += "-";
+      }
+      if (depth > 0 && rng() % 3 == 0)
+      {
+         e += "(" + random_expression(rng, depth - 1) + ")";
+      }
+      else
+      {
+         e += to_string(1 + rng() % 1000);
+      }
+   }
+   return e;
+}
+
+int main(int argc, char *argv[])
+{
+   size_t n = argc > 1 ? atol(argv[1]) : 100000;
+   mt19937 rng(2022);
+   string text_path = "/tmp/bench_calculator.txt", module_path = "/tmp/bench_calculator.calm";
+   {
+      ofstream out(text_path);
+      for (size_t i = 0; i < n; ++i)
+      {
+         out << random_expression(rng, 3) << "\n";
+      }
+   }
+   vector<string> lines;
+   {
+      ifstream in(text_path);
+      string line;
+      while (getline(in, line))
+      {
+         lines.push_back(line);
+      }
+   }
+   if (!write_module(module_path.c_str(), lines))
+   {
+      cout << "Error: couldn't write " << module_path << "\n";
+      return 1;
+   }
+
+   double text_first = 1e30, text_all = 1e30, module_first = 1e30, module_all = 1e30;
+   vector<Int_result> from_text, from_module;
+   for (int r = 0; r < 5; ++r)
+   {
+      from_text.clear();
+      double t = now();
+      ifstream in(text_path);
+      string line;
+      for (size_t i = 0; getline(in, line); ++i)
+      {
+         from_text.push_back(infix_eval(line));
+         if (i == 0)
+         {
+            text_first = min(text_first, now() - t);
+         }
+      }
+      text_all = min(text_all, now() - t);
+
+      from_module.clear();
+      t = now();
+      Calc_module module;
+      module.open_module(module_path.c_str());
+      for (size_t i = 0; i < module.size(); ++i)
+      {
+         from_module.push_back(module.eval(i));
+         if (i == 0)
+         {
+            module_first = min(module_first, now() - t);
+         }
+      }
+      module_all = min(module_all, now() - t);
+   }
+
+   bool same = from_text.size() == from_module.size();
+   size_t errors = 0;
+   for (size_t i = 0; same && i < from_text.size(); ++i)
+   {
+      same = from_text[i].value == from_module[i].value && from_text[i].error_msg == from_module[i].error_msg;
+      errors += !from_text[i].okay();
+   }
+   printf("%zu expressions (%zu with errors)\n", n, errors);
+   printf("%-8s %14s %14s %14s\n", "", "first ms", "all ms", "ns/expr");
+   printf("%-8s %14.4f %14.2f %14.1f\n", "text", text_first * 1e3, text_all * 1e3, text_all / n * 1e9);
+   printf("%-8s %14.4f %14.2f %14.1f\n", "module", module_first * 1e3, module_all * 1e3, module_all / n * 1e9);
+   printf("speedup  %13.1fx %13.1fx%s\n", text_first / module_first, text_all / module_all,
+          same ? "" : "  RESULTS DIFFER!");
+   remove(text_path.c_str());
+   remove(module_path.c_str());
+   return same ? 0 : 1;
+}
@@ -0,0 +1,152 @@
+// bench_calculator_c.c
+
+//
+// Measures the calculator library through its C interface (calculator_c.h),
+// the way a C caller uses it: compiling expressions to handles, evaluating
+// one handle, evaluating arrays of handles, and compiling and evaluating
+// text in one call. Each result is checked against the value the expression
+// is built to have. Given the path of a calculatorCompiler executable, it
+// also times running it once per expression, which is what the library
+// replaces.
+//
+//   g++ -std=c++17 -O2 -fPIC -shared -fvisibility=hidden calculator_c.cpp -o libcalculator.so
+//   cc -O2 bench_calculator_c.c -L. -lcalculator -Wl,-rpath,'$ORIGIN' -o bench_calculator_c
+//   ./bench_calculator_c [path to calculatorCompiler]
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "calculator_c.h"
+
+#define N 4096
+
+static double now(void)
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char *argv[])
+{
+   static char texts[N][64];
+   static size_t lengths[N];
+   static int expected[N], values[N], errors[N];
+   static calc_expr *exprs[N];
+
+   // (a + b) * 3 - -c / 2, and a division by zero every 64 expressions
+   for (int i = 0; i < N; ++i)
+   {
+      int a = i, b = i % 97, c = i % 13 * 2;
+      if (i % 64 == 63)
+      {
+         lengths[i] = sprintf(texts[i], "(%d + %d) / (%d - %d)", a, b, c, c);
+         expected[i] = 0;
+      }
+      else
+      {
+         lengths[i] = sprintf(texts[i], "(%d + %d) * 3 - -%d / 2", a, b, c);
+         expected[i] = (a + b) * 3 + c / 2;
+      }
+   }
+   printf("library version %d\n", calc_api_version());
+
+   double t = now();
+   for (int i = 0; i < N; ++i)
+   {
+      if (calc_compile(texts[i], lengths[i], &exprs[i]) != CALC_OK)
+      {
+         printf("Error: couldn't compile %s\n", texts[i]);
+         return 1;
+      }
+   }
+   double compile = (now() - t) / N;
+
+   // one handle at a time
+   int ok = 1;
+   long long sum = 0;
+   const int rounds = 200;
+   t = now();
+   for (int r = 0; r < rounds; ++r)
+   {
+      for (int i = 0; i < N; ++i)
+      {
+         int v;
+         calc_eval(exprs[i], &v);
+         sum += v;
+      }
+   }
+   double eval = (now() - t) / rounds / N;
+
+   // arrays of handles
+   size_t failed = 0;
+   t = now();
+   for (int r = 0; r < rounds; ++r)
+   {
+      failed = calc_eval_batch((const calc_expr *const *)exprs, N, values, errors);
+   }
+   double batch = (now() - t) / rounds / N;
+   for (int i = 0; i < N; ++i)
+   {
+      int want = i % 64 == 63 ? CALC_ERROR_DIVISION_BY_ZERO : CALC_OK;
+      if (errors[i] != want || values[i] != expected[i])
+      {
+         printf("Error: %s gave %d (%s), expected %d\n", texts[i], values[i], calc_error_message(errors[i]),
+                expected[i]);
+         ok = 0;
+      }
+   }
+
+   // text in, value out
+   t = now();
+   for (int i = 0; i < N; ++i)
+   {
+      int v;
+      calc_eval_text(texts[i], lengths[i], &v);
+      sum += v;
+   }
+   double text = (now() - t) / N;
+
+   for (int i = 0; i < N; ++i)
+   {
+      calc_free(exprs[i]);
+   }
+
+   int v, e = calc_eval_text("1 + + 2", 7, &v);
+   printf("\"1 + + 2\": %d (%s)\n", e, calc_error_message(e));
+   ok = ok && e == CALC_ERROR_NOT_ENOUGH_NUMBERS;
+
+   printf("%-24s %10.1f ns\n", "calc_compile", compile * 1e9);
+   printf("%-24s %10.1f ns\n", "calc_eval", eval * 1e9);
+   printf("%-24s %10.1f ns/expr (%zu failed of %d)\n", "calc_eval_batch", batch * 1e9, failed, N);
+   printf("%-24s %10.1f ns\n", "calc_eval_text", text * 1e9);
+
+   // the old way: one process per expression
+   if (argc > 1)
+   {
+      const char *path = "/tmp/bench_calculator_c.txt";
+      FILE *f = fopen(path, "w");
+      fprintf(f, "%s\n", texts[0]);
+      fclose(f);
+      char command[4096];
+      snprintf(command, sizeof command, "'%s' %s > /dev/null", argv[1], path);
+      const int runs = 50;
+      t = now();
+      for (int r = 0; r < runs; ++r)
+      {
+         if (system(command) != 0)
+         {
+            printf("Error: %s failed\n", command);
+            ok = 0;
+            break;
+         }
+      }
+      double process = (now() - t) / runs;
+      remove(path);
+      printf("%-24s %10.1f ns (%.0fx calc_eval_text)\n", "process per expression", process * 1e9,
+             process / text);
+   }
+   return ok && sum != 0 ? 0 : 1;
+}
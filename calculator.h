@@ -0,0 +1,645 @@
+// calculator.h
+
+//
+// The core of the integer calculator in calculatorCompiler.cpp: the scanner,
+// the minus fix-up, the shunting-yard infix-to-postfix transformer and the
+// postfix evaluator. calculatorCompiler.cpp adds the REPLs and the tests on
+// top of it, and calculator_module.h stores compiled (postfix) expressions
+// on disk.
+//
+// Built with -DCON_TRAZA, each stage records a span in the trace that
+// comun/traza.h writes when the TRAZA environment variable names a file.
+// postfix_run has none, since it's the inner loop of the C interface.
+// Built with -DCON_CONTADORES, the same stages are measured with the
+// processor's counters (comun/contadores.h), per token.
+//
+
+#ifndef CALCULATOR_H
+#define CALCULATOR_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "comun/traza.h"
+#include "comun/contadores.h"
+
+using namespace std;
+
+//////////////////////////////////////////////////////////////////////////
+//
+// Helper functions
+//
+//////////////////////////////////////////////////////////////////////////
+
+// Returns true if, and only if, c is a whitespace character.
+inline bool is_whitespace(char c)
+{
+   return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+// Returns true if, and only if, c is a decimal digit.
+inline bool is_digit(char c)
+{
+   return '0' <= c && c <= '9';
+}
+
+// Returns a copy of s in double-quotes.
+inline string quote(const string &s)
+{
+   return "\"" + s + "\"";
+}
+
+//////////////////////////////////////////////////////////////////////////
+//
+// Token_type enumeration
+//
+//////////////////////////////////////////////////////////////////////////
+
+// ": char" causes each value of this enum to be represented as a char.
+enum class Token_type : char
+{
+   LEFT_PAREN = '(',
+   RIGHT_PAREN = ')',
+   PLUS = '+',
+   BINARY_MINUS = 'm',
+   UNARY_MINUS = 'u',
+   TIMES = '*',
+   DIVIDE = '/',
+   NUMBER = 'n' // n for "number"
+};
+
+// Overload operator<< so that we can easily print Token_type values.
+inline ostream &operator<<(ostream &os, const Token_type &tt)
+{
+   os << "'" << char(tt) << "'";
+   return os;
+}
+
+// Returns true if tt is an operator, and false otherwise.
+inline bool is_op(Token_type tt)
+{
+   switch (tt)
+   {
+   case Token_type::TIMES:
+      return true;
+   case Token_type::DIVIDE:
+      return true;
+   case Token_type::PLUS:
+      return true;
+   case Token_type::BINARY_MINUS:
+      return true;
+   case Token_type::UNARY_MINUS:
+      return true;
+   default:
+      return false;
+   } // switch
+}
+
+// Returns the precedence of an operator (needed for parsing).
+// * has higher precedence than +, so the expression
+// "1 + 2 * 3" is evaluated as "1 + (2 * 3)"
+inline int precedence(Token_type tt)
+{
+   switch (tt)
+   {
+   case Token_type::UNARY_MINUS:
+      return 4;
+   case Token_type::TIMES:
+      return 3;
+   case Token_type::DIVIDE:
+      return 3;
+   case Token_type::PLUS:
+      return 2;
+   case Token_type::BINARY_MINUS:
+      return 2;
+      // default: cmpt::error("precedence default case reached");
+   }          // switch
+   return -1; // can never be reached!
+}
+
+//////////////////////////////////////////////////////////////////////////
+//
+// Tokens
+//
+//////////////////////////////////////////////////////////////////////////
+
+// A Token consists of a type, and, for numbers, the value of the number.
+struct Token
+{
+   Token_type type;
+   int value; // only used when type == Token_type::NUMBER
+};
+
+// Overload operator<< so that we can easily print a single Token.
+inline ostream &operator<<(ostream &os, const Token &t)
+{
+   if (t.type == Token_type::NUMBER)
+   {
+      os << "<" << t.value << ">";
+   }
+   else
+   {
+      os << "<" << char(t.type) << ">";
+   }
+   return os;
+}
+
+// Sequence is a type synonym for vector<Token>, i.e. Sequence is another name
+// for the type vector<Token>.
+typedef vector<Token> Sequence;
+
+// Print a vector of Tokens in a nice format.
+inline ostream &operator<<(ostream &os, const Sequence &tokens)
+{
+   int n = tokens.size();
+   if (n == 0)
+   {
+      os << "{}";
+   }
+   else if (n == 1)
+   {
+      os << "{" << tokens[0] << "}";
+   }
+   else
+   {
+      os << "{" << tokens[0];
+      for (int i = 1; i < tokens.size(); ++i)
+      {
+         os << ", " << tokens[i];
+      }
+      os << "}";
+   }
+   return os;
+}
+
+//////////////////////////////////////////////////////////////////////////
+//
+// Scanning functions
+//
+//////////////////////////////////////////////////////////////////////////
+
+// Replace non-printing characters like '\\n' with the 2-character string
+// "\\n". Also, can replace spaces with '.'s (or some other char) to make them
+// easier to see.
+inline string raw(const string &s, const string &dot_char = ".")
+{
+   string result;
+   for (char c : s)
+   {
+      switch (c)
+      {
+      case '\n':
+         result += "\\n";
+         break; // break is needed to stop
+      case '\t':
+         result += "\\t";
+         break; // the flow of control
+      case '\r':
+         result += "\\r";
+         break; // from "falling through"
+      case ' ':
+         result += dot_char;
+         break; // to the next case
+      default:
+         result += c;
+      } // switch
+   }    // for
+   return result;
+}
+
+// The ways scanning, converting or evaluating an expression can fail. Every
+// error result carries one, so callers can tell errors apart without
+// comparing messages.
+enum class Error_code : char
+{
+   NONE,
+   UNKNOWN_CHARACTER,
+   NUMBER_OUT_OF_RANGE,
+   MISMATCHED_PARENTHESIS,
+   NOT_ENOUGH_NUMBERS,
+   DIVISION_BY_ZERO
+};
+
+// The result of a scan is either a Sequence object, or an error. If the value
+// is a Sequence, then okay() returns true; if it's an error, then okay()
+// returns false.
+struct Scan_result
+{
+   Sequence value;
+   string error_msg;
+   Error_code code = Error_code::NONE;
+
+   bool okay() const { return error_msg.empty(); }
+}; // struct Scan_result
+
+inline ostream &operator<<(ostream &os, const Scan_result &sr)
+{
+   os << "Scan_result{" << sr.value << ", " << quote(sr.error_msg) << "}";
+   return os;
+}
+
+// Convert s into a vector of tokens. Returns an error on unknown characters
+// and on numbers that don't fit in an int.
+// A '-' is always treat as a Token_type::BINARY_MINUS
+inline Scan_result scan(const string &s)
+{
+   TRAZA("scan");
+   CONTAR_EN(medicion, "scan");
+   Sequence result;
+   for (int i = 0; i < s.size(); i++)
+   {
+      if (is_whitespace(s[i]))
+      {
+         // skip all whitespace
+         i++;
+         while (i < s.size() && is_whitespace(s[i]))
+            i++;
+         // invariant: i >= s.size() || !is_whitespace(s[i])
+
+         // If we're not at the end of the string, then decrement i because
+         // we had to look one character ahead to see that it wasn't
+         // whitespace.
+         if (i < s.size())
+            i--;
+      }
+      else if (is_digit(s[i]))
+      {
+         string num = string(1, s[i]);
+         i++;
+         while (i < s.size() && is_digit(s[i]))
+         {
+            num += string(1, s[i]);
+            i++;
+         }
+         // invariant: i >= s.size() || !is_digit(s[i])
+
+         // If we're not at the end of the string, then decrement i because
+         // we had to look one character ahead to see that it wasn't a
+         // digit.
+         if (i < s.size())
+            i--;
+         // at most 10 digits after the leading zeros, and then no more than
+         // INT_MAX; stoi would throw instead
+         size_t z = num.find_first_not_of('0');
+         size_t digits = z == string::npos ? 0 : num.size() - z;
+         if (digits > 10 || (digits == 10 && num.compare(z, 10, "2147483647") > 0))
+         {
+            return Scan_result{Sequence{}, "number out of range: " + num, Error_code::NUMBER_OUT_OF_RANGE};
+         }
+         result.push_back(Token{Token_type::NUMBER, stoi(num)});
+      }
+      else if (s[i] == '(')
+      {
+         result.push_back(Token{Token_type::LEFT_PAREN, 0});
+      }
+      else if (s[i] == ')')
+      {
+         result.push_back(Token{Token_type::RIGHT_PAREN, 0});
+      }
+      else if (s[i] == '+')
+      {
+         result.push_back(Token{Token_type::PLUS, 0});
+      }
+      else if (s[i] == '-')
+      {
+         result.push_back(Token{Token_type::BINARY_MINUS, 0});
+      }
+      else if (s[i] == '*')
+      {
+         result.push_back(Token{Token_type::TIMES, 0});
+      }
+      else if (s[i] == '/')
+      {
+         result.push_back(Token{Token_type::DIVIDE, 0});
+      }
+      else
+      {
+         string msg = "scanner encountered unknown character '" + string(1, s[i]) + "'";
+         return Scan_result{Sequence{}, msg, Error_code::UNKNOWN_CHARACTER};
+      }
+   } // for
+   CONTAR_UNIDADES(medicion, result.size());
+   return Scan_result{result, ""};
+} // scan
+
+// Distinguishing between unary - (as in -5) and binary - (as in 1 - 2).
+// Examples of unary - :
+//
+//   -5
+//   1 + -3
+//   -1 + 3
+//  -(1 + 2)
+//  3 - -2
+//  (-2 * 6)
+//  -1--2
+//
+//  A - is unary if:
+//
+//    * it is the first token of an expression, e.g. -5, -(1 + 2)
+//    * the previous token is an operator or a (, e.g. 1 + -3, (-2 * 6)
+//
+// All other instances of - are assumed to be binary.
+//
+inline void minus_fix(Sequence &seq)
+{
+   TRAZA("minus_fix");
+   CONTAR_EN(medicion, "minus_fix");
+   CONTAR_UNIDADES(medicion, seq.size());
+   if (seq.empty())
+   {
+      return;
+   }
+   // a - at the start of a sequence is always considered unary
+   if (seq[0].type == Token_type::BINARY_MINUS)
+   {
+      seq[0].type = Token_type::UNARY_MINUS;
+   }
+   for (int i = 1; i < seq.size(); ++i)
+   {
+      Token_type prev = seq[i - 1].type;
+      if (seq[i].type == Token_type::BINARY_MINUS)
+      {
+         if (prev == Token_type::LEFT_PAREN || is_op(prev))
+         {
+            seq[i].type = Token_type::UNARY_MINUS;
+         }
+      }
+   } // for
+}
+
+//////////////////////////////////////////////////////////////////////////
+//
+// Postfix evaluator
+//
+//////////////////////////////////////////////////////////////////////////
+
+// Removes an item from the end of a vector and returns it. It is a template
+// function, which means it works a vector<T>, where T is any type.
+template <class T>
+inline T pop(vector<T> &stack)
+{
+   T result = stack.back();
+   stack.pop_back();
+   return result;
+}
+
+// The result of a scan is either a Sequence object, or an error. If the value
+// is a Sequence, then okay() returns true; if it's an error, then okay()
+// returns false.
+struct Int_result
+{
+   int value;
+   string error_msg;
+   Error_code code = Error_code::NONE;
+
+   bool okay() const { return error_msg.empty(); }
+}; // struct Int_result
+
+inline ostream &operator<<(ostream &os, const Int_result &ir)
+{
+   os << "Int_result{" << ir.value << ", " << quote(ir.error_msg) << "}";
+   return os;
+}
+
+// Evaluates tokens[0..n) like postfix_eval, but on the caller's stack, which
+// needs room for n numbers, so nothing is allocated. On success stores the
+// result in value. The arithmetic wraps around on overflow, as the hardware
+// does, instead of being undefined (and -2147483648 / -1 doesn't trap).
+inline Error_code postfix_run(const Token *tokens, size_t n, int *stack, int &value)
+{
+   size_t top = 0;
+
+   // Scan through every token. Push numbers onto the stack. For operators,
+   // pop off the necessary number of items from the stack, evaluate them,
+   // and push the result.
+   for (size_t i = 0; i < n; ++i)
+   {
+      Token tok = tokens[i];
+      if (tok.type == Token_type::NUMBER)
+      {
+         stack[top++] = tok.value;
+      }
+      else if (tok.type == Token_type::UNARY_MINUS)
+      {
+         // Unary operators take one input.
+         if (top < 1)
+         {
+            return Error_code::NOT_ENOUGH_NUMBERS;
+         }
+         stack[top - 1] = int(0u - unsigned(stack[top - 1]));
+      }
+      else
+      {
+         // Binary operators take two inputs.
+         if (top < 2)
+         {
+            return Error_code::NOT_ENOUGH_NUMBERS;
+         }
+         int a = stack[--top];
+         int b = stack[--top];
+         switch (tok.type)
+         {
+         case Token_type::PLUS:
+            stack[top++] = int(unsigned(b) + unsigned(a));
+            break;
+         case Token_type::BINARY_MINUS:
+            stack[top++] = int(unsigned(b) - unsigned(a));
+            break;
+         case Token_type::TIMES:
+            stack[top++] = int(unsigned(b) * unsigned(a));
+            break;
+         case Token_type::DIVIDE:
+            if (a == 0)
+            {
+               return Error_code::DIVISION_BY_ZERO;
+            }
+            stack[top++] = a == -1 ? int(0u - unsigned(b)) : b / a;
+            break;
+         default:
+            // parentheses only get here from postfix_eval(string); like
+            // before, they consume two numbers and push nothing
+            break;
+         } // switch
+      }    // else
+   }       // for
+   if (top == 0)
+   {
+      return Error_code::NOT_ENOUGH_NUMBERS;
+   }
+   value = stack[0];
+   return Error_code::NONE;
+} // postfix_run
+
+// Assumes tokens[0..n) form a valid postfix expression. Takes a plain array so
+// that expressions mapped straight from a module file (calculator_module.h)
+// can be evaluated in place.
+inline Int_result postfix_eval(const Token *tokens, size_t n)
+{
+   TRAZA("postfix_eval");
+   CONTAR_EN(medicion, "postfix_eval");
+   CONTAR_UNIDADES(medicion, n);
+   vector<int> stack(n + 1);
+   int value = 0;
+   Error_code code = postfix_run(tokens, n, stack.data(), value);
+   switch (code)
+   {
+   case Error_code::NONE:
+      return Int_result{value, ""};
+   case Error_code::DIVISION_BY_ZERO:
+      return Int_result{0, "division by 0", code};
+   default:
+      return Int_result{0, "not enough numbers to pop", code};
+   }
+} // postfix_eval
+
+inline Int_result postfix_eval(const Sequence &tokens)
+{
+   return postfix_eval(tokens.data(), tokens.size());
+}
+
+inline Int_result postfix_eval(const string &expr)
+{
+   Scan_result tokens = scan(expr);
+   if (tokens.okay())
+   {
+      Int_result result = postfix_eval(tokens.value);
+      return result;
+   }
+   else
+   {
+      return Int_result{0, tokens.error_msg, tokens.code};
+   }
+}
+
+//////////////////////////////////////////////////////////////////////////
+//
+// Infix evaluator
+//
+//////////////////////////////////////////////////////////////////////////
+
+//
+// Use the shunting-yard algorithm to convert infix to postfix.
+//
+// Assumes tokens vector forms a infix expression.
+// See: https://en.wikipedia.org/wiki/Shunting-yard_algorithm
+//
+// Some invalid expressions, like "(1 + 2", are caught in this function, while
+// others, like "1(+)2" or "1 + + 2", are caught only in the postfix
+// evaluation. That's pretty confusing for the user! Consistent, helpful error
+// messages would be a good improvement to this program.
+inline Scan_result infix_to_postfix(const Sequence &input)
+{
+   TRAZA("infix_to_postfix");
+   CONTAR_EN(medicion, "infix_to_postfix");
+   CONTAR_UNIDADES(medicion, input.size());
+   Sequence output;
+   Sequence stack;
+   for (const Token &tok : input)
+   {
+      switch (tok.type)
+      {
+      case Token_type::NUMBER:
+         // numbers are always immediately pushed to output
+         output.push_back(tok);
+         break;
+      case Token_type::PLUS:
+      case Token_type::UNARY_MINUS:
+      case Token_type::BINARY_MINUS:
+      case Token_type::TIMES:
+      case Token_type::DIVIDE:
+         // pop higher-precedence operators off the stack
+         while (!stack.empty() && (is_op(stack.back().type) && precedence(stack.back().type) >= precedence(tok.type)))
+         {
+            output.push_back(pop(stack));
+         } // while
+         stack.push_back(tok);
+         break;
+      case Token_type::LEFT_PAREN:
+         // left parentheses are always immediately pushed onto the stack
+         stack.push_back(tok);
+         break;
+      case Token_type::RIGHT_PAREN:
+         // pop operators until the first left parenthesis is reached
+         // (if no parenthesis is found, then there's a mis-matched
+         // parenthesis error)
+         while (!stack.empty() && (stack.back().type != Token_type::LEFT_PAREN))
+         {
+            output.push_back(pop(stack));
+         } // while
+         if (stack.empty())
+         {
+            return Scan_result{Sequence{}, "mis-matched parenthesis", Error_code::MISMATCHED_PARENTHESIS};
+         }
+         else if (stack.back().type == Token_type::LEFT_PAREN)
+         {
+            // discard the left parenthesis on the top
+            pop(stack);
+         }
+         else
+         {
+            // If the program ever gets to this line then there is a
+            // serious problem with it's design.
+            // cmpt::error("logic error in infix_to_postfix RIGHT_PAREN case!");
+         }
+         break;
+      default:
+         cout << "tok.type: '" << char(tok.type) << "'\n";
+         // cmpt::error("reached default in infix_to_postfix!");
+      } // switch
+   }    // for
+
+   // The output is all processed, but there might be tokens on the stack. So
+   // move them all to output.
+   while (!stack.empty())
+   {
+      Token t = pop(stack);
+      if (t.type == Token_type::LEFT_PAREN || t.type == Token_type::RIGHT_PAREN)
+      {
+         return Scan_result{Sequence{}, "mis-matched parenthesis", Error_code::MISMATCHED_PARENTHESIS};
+      }
+      output.push_back(t);
+   } // while
+   return Scan_result{output, ""};
+} // infix_to_postfix
+
+// Compiles an infix expression into the equivalent postfix sequence, which
+// postfix_eval can evaluate any number of times without scanning again.
+inline Scan_result infix_compile(const string &input)
+{
+   Scan_result tokens = scan(input);
+   if (!tokens.okay())
+   {
+      return tokens;
+   }
+   minus_fix(tokens.value);
+   return infix_to_postfix(tokens.value);
+}
+
+inline Int_result infix_eval(Sequence input)
+{
+   minus_fix(input);
+   Scan_result postfix = infix_to_postfix(input);
+   if (postfix.okay())
+   {
+      return postfix_eval(postfix.value);
+   }
+   else
+   {
+      return Int_result{0, postfix.error_msg, postfix.code};
+   }
+}
+
+inline Int_result infix_eval(const string &input)
+{
+   Scan_result tokens = scan(input);
+   if (tokens.okay())
+   {
+      return infix_eval(tokens.value);
+   }
+   else
+   {
+      return Int_result{0, tokens.error_msg, tokens.code};
+   }
+}
+
+#endif
@@ -0,0 +1,196 @@
+// calculator_c.cpp
+
+//
+// The C interface of calculator_c.h on top of calculator.h. A handle is the
+// postfix sequence from infix_compile plus how deep its evaluation stack
+// gets, worked out once at compile time, so calc_eval can run postfix_run on
+// a fixed array on its own stack.
+//
+//   g++ -std=c++17 -O2 -fPIC -shared -fvisibility=hidden calculator_c.cpp -o libcalculator.so
+//
+
+#include <new>
+#include "calculator.h"
+#include "calculator_c.h"
+
+static_assert(int(Error_code::UNKNOWN_CHARACTER) == CALC_ERROR_UNKNOWN_CHARACTER &&
+                  int(Error_code::NUMBER_OUT_OF_RANGE) == CALC_ERROR_NUMBER_OUT_OF_RANGE &&
+                  int(Error_code::MISMATCHED_PARENTHESIS) == CALC_ERROR_MISMATCHED_PARENTHESIS &&
+                  int(Error_code::NOT_ENOUGH_NUMBERS) == CALC_ERROR_NOT_ENOUGH_NUMBERS &&
+                  int(Error_code::DIVISION_BY_ZERO) == CALC_ERROR_DIVISION_BY_ZERO,
+              "calc_error must match Error_code");
+
+struct calc_expr
+{
+   Sequence postfix;
+};
+
+// Checks that postfix never pops more numbers than it has pushed (so
+// postfix_run can only fail with a division by zero) and that it never needs
+// more than CALC_MAX_DEPTH of them at once.
+static int check_depth(const Sequence &postfix)
+{
+   size_t depth = 0;
+   for (const Token &tok : postfix)
+   {
+      if (tok.type == Token_type::NUMBER)
+      {
+         if (++depth > CALC_MAX_DEPTH)
+         {
+            return CALC_ERROR_TOO_DEEP;
+         }
+      }
+      else if (tok.type == Token_type::UNARY_MINUS)
+      {
+         if (depth < 1)
+         {
+            return CALC_ERROR_NOT_ENOUGH_NUMBERS;
+         }
+      }
+      else if (depth < 2)
+      {
+         return CALC_ERROR_NOT_ENOUGH_NUMBERS;
+      }
+      else
+      {
+         --depth;
+      }
+   }
+   return depth == 0 ? CALC_ERROR_NOT_ENOUGH_NUMBERS : CALC_OK;
+}
+
+extern "C" {
+
+int calc_api_version(void)
+{
+   return CALC_API_VERSION;
+}
+
+int calc_compile(const char *text, size_t len, calc_expr **expr)
+{
+   if (!expr)
+   {
+      return CALC_ERROR_INVALID_ARGUMENT;
+   }
+   *expr = nullptr;
+   if (!text && len > 0)
+   {
+      return CALC_ERROR_INVALID_ARGUMENT;
+   }
+   TRAZA("calc_compile");
+   try
+   {
+      Scan_result postfix = infix_compile(string(text ? text : "", len));
+      if (!postfix.okay())
+      {
+         return int(postfix.code);
+      }
+      int error = check_depth(postfix.value);
+      if (error != CALC_OK)
+      {
+         return error;
+      }
+      *expr = new calc_expr{std::move(postfix.value)};
+      return CALC_OK;
+   }
+   catch (const std::bad_alloc &)
+   {
+      return CALC_ERROR_NO_MEMORY;
+   }
+}
+
+void calc_free(calc_expr *expr)
+{
+   delete expr;
+}
+
+int calc_eval(const calc_expr *expr, int *value)
+{
+   if (!expr || !value)
+   {
+      return CALC_ERROR_INVALID_ARGUMENT;
+   }
+   int stack[CALC_MAX_DEPTH];
+   *value = 0;
+   return int(postfix_run(expr->postfix.data(), expr->postfix.size(), stack, *value));
+}
+
+size_t calc_eval_batch(const calc_expr *const *exprs, size_t n, int *values, int *errors)
+{
+   TRAZA("calc_eval_batch");
+   size_t failed = 0;
+   if (!exprs || !values)
+   {
+      for (size_t i = 0; errors && i < n; ++i)
+      {
+         errors[i] = CALC_ERROR_INVALID_ARGUMENT;
+      }
+      return n;
+   }
+   int stack[CALC_MAX_DEPTH];
+   for (size_t i = 0; i < n; ++i)
+   {
+      int error = CALC_ERROR_INVALID_ARGUMENT;
+      values[i] = 0;
+      if (exprs[i])
+      {
+         error = int(postfix_run(exprs[i]->postfix.data(), exprs[i]->postfix.size(), stack, values[i]));
+      }
+      if (error != CALC_OK)
+      {
+         values[i] = 0;
+         ++failed;
+      }
+      if (errors)
+      {
+         errors[i] = error;
+      }
+   }
+   return failed;
+}
+
+int calc_eval_text(const char *text, size_t len, int *value)
+{
+   if (!value)
+   {
+      return CALC_ERROR_INVALID_ARGUMENT;
+   }
+   *value = 0;
+   calc_expr *expr;
+   int error = calc_compile(text, len, &expr);
+   if (error == CALC_OK)
+   {
+      error = calc_eval(expr, value);
+      calc_free(expr);
+   }
+   return error;
+}
+
+const char *calc_error_message(int error)
+{
+   switch (error)
+   {
+   case CALC_OK:
+      return "ok";
+   case CALC_ERROR_UNKNOWN_CHARACTER:
+      return "unknown character";
+   case CALC_ERROR_NUMBER_OUT_OF_RANGE:
+      return "number out of range";
+   case CALC_ERROR_MISMATCHED_PARENTHESIS:
+      return "mis-matched parenthesis";
+   case CALC_ERROR_NOT_ENOUGH_NUMBERS:
+      return "not enough numbers to pop";
+   case CALC_ERROR_DIVISION_BY_ZERO:
+      return "division by 0";
+   case CALC_ERROR_TOO_DEEP:
+      return "expression too deep";
+   case CALC_ERROR_NO_MEMORY:
+      return "out of memory";
+   case CALC_ERROR_INVALID_ARGUMENT:
+      return "invalid argument";
+   default:
+      return "unknown error";
+   }
+}
+
+} // extern "C"
@@ -0,0 +1,92 @@
+// calculator_c.h
+
+//
+// C interface to the integer calculator (calculator.h), for calling it in
+// process from C and anything else that can call C, instead of running the
+// calc executable once per expression.
+//
+// An expression is compiled once into a handle (scanned, minus-fixed and
+// converted to postfix), and the handle can then be evaluated any number of
+// times. Evaluating doesn't allocate, doesn't throw and doesn't touch any
+// global state, so a handle can be evaluated from several threads at once.
+// Every function reports failures with one of the calc_error codes.
+//
+// Build the library and link against it:
+//
+//   g++ -std=c++17 -O2 -fPIC -shared -fvisibility=hidden calculator_c.cpp -o libcalculator.so
+//   cc -O2 program.c -L. -lcalculator -Wl,-rpath,'$ORIGIN'
+//
+
+#ifndef CALCULATOR_C_H
+#define CALCULATOR_C_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__GNUC__)
+#define CALC_EXPORT __attribute__((visibility("default")))
+#else
+#define CALC_EXPORT
+#endif
+
+// Version of this interface. Functions and codes are only ever added, so a
+// program built against version N works with any library version >= N.
+#define CALC_API_VERSION 1
+
+// Error codes. The first five match the calculator's own errors.
+enum calc_error
+{
+   CALC_OK = 0,
+   CALC_ERROR_UNKNOWN_CHARACTER = 1,
+   CALC_ERROR_NUMBER_OUT_OF_RANGE = 2,
+   CALC_ERROR_MISMATCHED_PARENTHESIS = 3,
+   CALC_ERROR_NOT_ENOUGH_NUMBERS = 4,
+   CALC_ERROR_DIVISION_BY_ZERO = 5,
+   // more than CALC_MAX_DEPTH numbers pending at once, e.g. very deep nesting
+   CALC_ERROR_TOO_DEEP = 6,
+   CALC_ERROR_NO_MEMORY = 7,
+   // a NULL pointer where one isn't allowed
+   CALC_ERROR_INVALID_ARGUMENT = 8
+};
+
+// Most numbers an expression may need to keep at once while evaluating.
+#define CALC_MAX_DEPTH 1024
+
+// A compiled expression.
+typedef struct calc_expr calc_expr;
+
+// Returns CALC_API_VERSION of the library.
+CALC_EXPORT int calc_api_version(void);
+
+// Compiles text[0, len) into *expr. Errors in the expression itself (an
+// unknown character, mismatched parentheses, a missing operand) are reported
+// here; only division by zero is left for evaluation. On error *expr is set
+// to NULL.
+CALC_EXPORT int calc_compile(const char *text, size_t len, calc_expr **expr);
+
+// Frees a handle from calc_compile. NULL is allowed.
+CALC_EXPORT void calc_free(calc_expr *expr);
+
+// Evaluates expr into *value. Returns CALC_OK or CALC_ERROR_DIVISION_BY_ZERO.
+// Arithmetic wraps around on overflow.
+CALC_EXPORT int calc_eval(const calc_expr *expr, int *value);
+
+// Evaluates exprs[0, n) into values[0, n). If errors isn't NULL, errors[i]
+// gets the code of exprs[i] (values[i] is 0 when it isn't CALC_OK). Returns
+// how many expressions failed.
+CALC_EXPORT size_t calc_eval_batch(const calc_expr *const *exprs, size_t n, int *values, int *errors);
+
+// Compiles and evaluates text[0, len) in one call, without keeping a handle.
+CALC_EXPORT int calc_eval_text(const char *text, size_t len, int *value);
+
+// A short English description of an error code, as a static string.
+CALC_EXPORT const char *calc_error_message(int error);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,239 @@
+// calculator_module.h
+
+//
+// A binary file of compiled calculator expressions. Each expression is
+// stored as the postfix sequence that infix_compile produces, so running it
+// is just postfix_eval: no scanning, no minus fix-up, no shunting-yard.
+// Expressions that don't compile keep their error message instead, so the
+// i-th entry always matches the i-th input line.
+//
+// Everything in the file refers to other parts of it by index, never by
+// pointer, so it can be mapped with mmap at any address and used in place.
+//
+// File layout (every section aligned to 64 bytes):
+//
+//   Module_header | Module_entry[expression_count] | Token[token_count] |
+//   char text[text_size]
+//
+
+#ifndef CALCULATOR_MODULE_H
+#define CALCULATOR_MODULE_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "calculator.h"
+
+// Bump whenever the layout or the meaning of a Token changes.
+const uint32_t MODULE_VERSION = 2;
+
+// Alignment of each section in the file.
+const uint64_t MODULE_ALIGNMENT = 64;
+
+static_assert(sizeof(Token) == 8, "the module format assumes 8-byte Tokens");
+
+struct Module_header
+{
+   char magic[4]; // "CALM"
+   uint32_t version;
+   uint32_t token_size; // sizeof(Token) when the file was written
+   uint32_t expression_count;
+   uint32_t token_count;
+   uint32_t text_size;
+};
+
+// One compiled expression: tokens[first, first + count), or, if error_size
+// isn't 0, the error message text[error_first, error_first + error_size)
+// and its Error_code.
+struct Module_entry
+{
+   uint32_t first;
+   uint32_t count;
+   uint32_t error_first;
+   uint32_t error_size;
+   uint32_t error_code;
+};
+
+// Rounds x up to the start of the next section.
+inline uint64_t module_align(uint64_t x)
+{
+   return (x + MODULE_ALIGNMENT - 1) & ~(MODULE_ALIGNMENT - 1);
+}
+
+// Offsets of the sections of a module with header h.
+struct Module_sections
+{
+   uint64_t entries, tokens, text, end;
+
+   explicit Module_sections(const Module_header &h)
+   {
+      entries = module_align(sizeof(Module_header));
+      tokens = module_align(entries + uint64_t(h.expression_count) * sizeof(Module_entry));
+      text = module_align(tokens + uint64_t(h.token_count) * sizeof(Token));
+      end = text + h.text_size;
+   }
+};
+
+// An open module. Its entries, tokens and text point into the mapped pages.
+class Calc_module
+{
+   const char *map = nullptr;
+   size_t map_size = 0;
+
+public:
+   Module_header header = {};
+   const Module_entry *entries = nullptr;
+   const Token *tokens = nullptr;
+   const char *text = nullptr;
+
+   Calc_module() = default;
+   Calc_module(const Calc_module &) = delete;
+   Calc_module &operator=(const Calc_module &) = delete;
+   ~Calc_module() { close_module(); }
+
+   void close_module()
+   {
+      if (map)
+      {
+         munmap((void *)map, map_size);
+      }
+      map = nullptr;
+      map_size = 0;
+      entries = nullptr;
+      tokens = nullptr;
+      text = nullptr;
+   }
+
+   // Maps the module at path and checks its header and section sizes.
+   // Returns false if the file doesn't exist, isn't a module, is from another
+   // version, or is truncated. The entries aren't read here, so opening costs
+   // the same for any number of expressions; eval checks each one it uses.
+   bool open_module(const char *path)
+   {
+      close_module();
+      header = Module_header{};
+      int fd = open(path, O_RDONLY);
+      if (fd < 0)
+      {
+         return false;
+      }
+      struct stat st;
+      if (fstat(fd, &st) != 0 || size_t(st.st_size) < sizeof(Module_header))
+      {
+         close(fd);
+         return false;
+      }
+      void *m = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+      close(fd);
+      if (m == MAP_FAILED)
+      {
+         return false;
+      }
+      map = (const char *)m;
+      map_size = st.st_size;
+
+      memcpy(&header, map, sizeof header);
+      Module_sections s(header);
+      if (memcmp(header.magic, "CALM", 4) != 0 || header.version != MODULE_VERSION ||
+          header.token_size != sizeof(Token) || s.end != map_size)
+      {
+         header = Module_header{};
+         close_module();
+         return false;
+      }
+      entries = (const Module_entry *)(map + s.entries);
+      tokens = (const Token *)(map + s.tokens);
+      text = map + s.text;
+      return true;
+   }
+
+   size_t size() const { return header.expression_count; }
+
+   // Evaluates the i-th expression in place.
+   Int_result eval(size_t i) const
+   {
+      const Module_entry &e = entries[i];
+      if (uint64_t(e.first) + e.count > header.token_count ||
+          uint64_t(e.error_first) + e.error_size > header.text_size ||
+          (e.error_size > 0 && (e.error_code < uint32_t(Error_code::UNKNOWN_CHARACTER) ||
+                                e.error_code > uint32_t(Error_code::DIVISION_BY_ZERO))))
+      {
+         return Int_result{0, "corrupt module entry"};
+      }
+      if (e.error_size > 0)
+      {
+         return Int_result{0, string(text + e.error_first, e.error_size), Error_code(e.error_code)};
+      }
+      return postfix_eval(tokens + e.first, e.count);
+   }
+};
+
+// Compiles every expression and writes them as a module. The file is first
+// written to path.tmp and then renamed, so nobody ever maps a half-written
+// module. Returns false if it couldn't be written.
+inline bool write_module(const char *path, const vector<string> &expressions)
+{
+   vector<Module_entry> entries;
+   vector<Token> tokens;
+   string text;
+   for (const string &expr : expressions)
+   {
+      Scan_result postfix = infix_compile(expr);
+      Module_entry e = {uint32_t(tokens.size()), 0, uint32_t(text.size()), 0, 0};
+      if (postfix.okay())
+      {
+         for (const Token &t : postfix.value)
+         {
+            // zero the padding too, so the same input gives the same file
+            Token z;
+            memset(&z, 0, sizeof z);
+            z.type = t.type;
+            z.value = t.value;
+            tokens.push_back(z);
+         }
+         e.count = postfix.value.size();
+      }
+      else
+      {
+         text += postfix.error_msg;
+         e.error_size = postfix.error_msg.size();
+         e.error_code = uint32_t(postfix.code);
+      }
+      entries.push_back(e);
+   }
+   Module_header h = {{'C', 'A', 'L', 'M'}, MODULE_VERSION, sizeof(Token), uint32_t(entries.size()),
+                      uint32_t(tokens.size()), uint32_t(text.size())};
+
+   string tmp = string(path) + ".tmp";
+   FILE *f = fopen(tmp.c_str(), "wb");
+   if (!f)
+   {
+      return false;
+   }
+   static const char zeros[MODULE_ALIGNMENT] = {};
+   uint64_t pos = 0;
+   bool ok = true;
+   auto section = [&](const void *p, uint64_t n) {
+      uint64_t padding = module_align(pos) - pos;
+      ok = ok && fwrite(zeros, 1, padding, f) == padding && fwrite(p, 1, n, f) == n;
+      pos += padding + n;
+   };
+   section(&h, sizeof h);
+   section(entries.data(), entries.size() * sizeof(Module_entry));
+   section(tokens.data(), tokens.size() * sizeof(Token));
+   section(text.data(), text.size());
+
+   ok = fclose(f) == 0 && ok;
+   if (ok && rename(tmp.c_str(), path) == 0)
+   {
+      return true;
+   }
+   remove(tmp.c_str());
+   return false;
+}
+
+#endif
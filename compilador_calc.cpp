@@ -28,6 +28,8 @@ Reglas de derivación:
 #include <vector>
 #include <fstream>
 #include <cstring>
+#include <charconv>
+#include "2parcial/real.h"
 
 using std::cerr;
 using std::cout;
@@ -40,8 +42,8 @@ using std::vector;
 struct Token
 {
 	char type;
-	string value; // usado cuando type == Token_type::NUMBER
-	int ln;		  // número de línea
+	int ln;		// número de línea
+	double num; // valor del literal cuando type == 'n', convertido sin copiarlo a un string
 };
 
 // vector de caracteres del archivo fuente
@@ -115,6 +117,7 @@ int main(int argc, char *argv[])
 		cout << "archivo leido" << endl;
 
 	int ln = 1; // número de línea
+	int n = chars.size(); // número de caracteres
 
 	for (int i = 0; i < chars.size(); i++)
 	{
@@ -122,37 +125,44 @@ int main(int argc, char *argv[])
 
 		if (is_space(actual_char))
 		{
-			i++;
-			if (actual_char == 10)
-				ln++;
+			// el for ya avanza al siguiente caracter
 		}
 
-		else if (is_digit(actual_char))
+		else if (actual_char == '\n')
+			ln++;
+
+		else if (is_digit(actual_char) || (actual_char == '.' && i + 1 < n && is_digit(chars[i + 1])))
 		{
-			string num = string(1, actual_char);
-			i++;
-			while (i < chars.size() && is_digit(chars[i + 1]))
+			// se delimita el literal <exp entera> o <exp real> (d+, d+.d*, .d+)
+			// sobre el mismo vector de chars y se convierte sin copiarlo
+			int ini = i;
+			while (i < n && is_digit(chars[i]))
+				i++;
+			if (i < n && chars[i] == '.')
 			{
-				num += string(1, actual_char);
 				i++;
+				while (i < n && is_digit(chars[i]))
+					i++;
 			}
 
-			if (i < chars.size())
-				i--;
+			double num = 0;
+			aReal(&chars[ini], chars.data() + i, num);
+			tokens.push_back(Token{'n', ln, num});
 
-			tokens.push_back(Token{'n', num, ln});
+			// el for avanza al siguiente caracter
+			i--;
 		}
 
 		else if (actual_char == '(')
 		{
-			tokens.push_back(Token{actual_char, string(1, 0), ln});
+			tokens.push_back(Token{actual_char, ln, 0});
 		}
 
 		else if (actual_char == ')')
-			tokens.push_back(Token{actual_char, string(1, 0), ln});
+			tokens.push_back(Token{actual_char, ln, 0});
 
 		else if (is_op(actual_char))
-			tokens.push_back(Token{actual_char, string(1, 0), ln});
+			tokens.push_back(Token{actual_char, ln, 0});
 
 		else
 			cout << "caracter invalido" << endl;
@@ -162,8 +172,13 @@ int main(int argc, char *argv[])
 
 	for (int i = 0; i < tokens.size(); i++)
 	{
-		if (tokens[i].value.size() > 0)
-			cout << " | Tipo: " << string(1, tokens[i].type) << " | Val: " << tokens[i].value << endl;
+		if (tokens[i].type == 'n')
+		{
+			// la representación más corta que vuelve a dar el mismo double
+			char val[32];
+			char *fin = std::to_chars(val, val + sizeof val, tokens[i].num).ptr;
+			cout << " | Tipo: " << string(1, tokens[i].type) << " | Val: " << string(val, fin) << endl;
+		}
 		else
 			cout << " | Tipo: " << string(1, tokens[i].type) << endl;
 	}
@@ -0,0 +1,313 @@
+/**
+ * @file    contadores.h
+ * @version 1.0
+ * @date    19/10/2026
+ * @title   Contadores del procesador por etapa
+ * @brief   Mide cada etapa (léxico, sintáctico, semántico y las etapas de la calculadora) con los
+ *          contadores del procesador que abre perf_event_open: ciclos, instrucciones, saltos mal
+ *          predichos y fallos de lectura en L1 de datos y en el último nivel de caché. Al terminar
+ *          el programa escribe en cerr una tabla con, por etapa, cuántas veces se ejecutó, cuántas
+ *          unidades procesó, y por unidad los nanosegundos, ciclos y fallos, más las instrucciones
+ *          por ciclo (IPC). Las unidades son tokens, salvo en el semántico, que cuenta nodos del
+ *          árbol; una etapa que no indica unidades muestra los valores por llamada.
+ *
+ *          Solo se compila con -DCON_CONTADORES; sin esa macro CONTAR y CONTAR_EN no generan
+ *          código.
+ *          Con ella, se mide si la variable de ambiente CONTADORES no está vacía
+ *          (CONTADORES=1 ./programa ...). Si el kernel no permite abrir los contadores
+ *          (perf_event_paranoid, un contenedor sin perf_event_open, una máquina virtual sin los
+ *          del procesador), la tabla dice por qué y muestra solo los tiempos y las unidades.
+ *
+ *          Cada hilo abre sus contadores como un grupo, la primera vez que mide, y los deja
+ *          corriendo; una etapa lee el grupo (una llamada al sistema) al empezar y al terminar y
+ *          suma la diferencia. Solo se cuenta el espacio de usuario, así que la lectura no se
+ *          mide a sí misma, pero en etapas que tardan menos de un microsegundo, como
+ *          postfix_eval con una expresión, el tiempo sí la incluye. Las etapas anidadas se
+ *          cuentan completas en cada nivel.
+ */
+
+#ifndef CONTADORES_H
+#define CONTADORES_H
+
+#ifdef CON_CONTADORES
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <vector>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace contadores
+{
+    struct Contador
+    {
+        const char *nombre;
+        uint32_t tipo;
+        uint64_t config;
+    };
+
+    enum
+    {
+        CICLOS,
+        INSTRUCCIONES,
+        SALTOS,
+        L1D,
+        LLC,
+        N
+    };
+
+    /// En el orden del enum
+    inline const Contador CONTADORES[N] = {
+        {"ciclos", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {"instrucciones", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {"saltos mal predichos", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {"fallos L1d", PERF_TYPE_HW_CACHE,
+         PERF_COUNT_HW_CACHE_L1D | PERF_COUNT_HW_CACHE_OP_READ << 8 | PERF_COUNT_HW_CACHE_RESULT_MISS << 16},
+        {"fallos LLC", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    };
+
+    /// Lectura del grupo con PERF_FORMAT_GROUP | TOTAL_TIME_ENABLED | TOTAL_TIME_RUNNING
+    struct Lectura
+    {
+        uint64_t n, habilitado, corriendo;
+        uint64_t valor[N];
+        uint64_t ns;
+    };
+
+    /// Lo acumulado por una etapa en un hilo
+    struct Etapa
+    {
+        const char *nombre;
+        uint64_t llamadas, unidades, ns;
+        double valor[N];
+        /// Llamadas en que el contador estuvo disponible
+        uint64_t medidas[N];
+    };
+
+    struct Hilo
+    {
+        /// Descriptor del primer contador que se abrió (el líder del grupo), o -1
+        int lider = -1;
+        /// Posición de cada contador en la lectura del grupo, o -1 si no se abrió
+        int pos[N];
+        std::vector<int> fds;
+        /// Las referencias a una deque no cambian al agregar etapas (las mediciones anidadas las guardan)
+        std::deque<Etapa> etapas;
+        Hilo *siguiente = nullptr;
+    };
+
+    inline std::atomic<Hilo *> hilos{nullptr};
+    /// errno del primer contador que no se pudo abrir, para explicarlo en la tabla
+    inline std::atomic<int> error{0};
+
+    inline void reportar();
+
+    /// Si se mide
+    inline const bool activo = [] {
+        const char *c = getenv("CONTADORES");
+        if (!c || !*c)
+            return false;
+        atexit(reportar);
+        return true;
+    }();
+
+    inline uint64_t ahora()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+    }
+
+    /// Abre el grupo de contadores del hilo actual; los que no se pueden abrir quedan fuera
+    inline Hilo *registrar()
+    {
+        Hilo *h = new Hilo;
+        for (int i = 0; i < N; ++i)
+        {
+            perf_event_attr a;
+            memset(&a, 0, sizeof a);
+            a.size = sizeof a;
+            a.type = CONTADORES[i].tipo;
+            a.config = CONTADORES[i].config;
+            a.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            a.exclude_kernel = 1;
+            a.exclude_hv = 1;
+            int fd = syscall(SYS_perf_event_open, &a, 0, -1, h->lider, PERF_FLAG_FD_CLOEXEC);
+            h->pos[i] = -1;
+            if (fd < 0)
+            {
+                int cero = 0;
+                error.compare_exchange_strong(cero, errno);
+                continue;
+            }
+            if (h->lider < 0)
+                h->lider = fd;
+            h->pos[i] = h->fds.size();
+            h->fds.push_back(fd);
+        }
+        h->siguiente = hilos.load(std::memory_order_relaxed);
+        while (!hilos.compare_exchange_weak(h->siguiente, h, std::memory_order_release, std::memory_order_relaxed))
+            ;
+        return h;
+    }
+
+    inline Hilo &actual()
+    {
+        static thread_local Hilo *h = registrar();
+        return *h;
+    }
+
+    inline Etapa &etapa(Hilo &h, const char *nombre)
+    {
+        for (Etapa &e : h.etapas)
+            if (e.nombre == nombre)
+                return e;
+        h.etapas.push_back(Etapa{nombre, 0, 0, 0, {}, {}});
+        return h.etapas.back();
+    }
+
+    inline void leer(const Hilo &h, Lectura &l)
+    {
+        if (h.lider < 0 || read(h.lider, &l, sizeof l) < ssize_t(3 + h.fds.size()) * 8)
+            l.n = 0;
+    }
+
+    /// Medición de una etapa desde que se construye hasta que se destruye
+    class Medicion
+    {
+        Hilo *h = nullptr;
+        Etapa *e = nullptr;
+        Lectura antes;
+
+    public:
+        /// Unidades que procesó la etapa (tokens o nodos); con 0 la tabla muestra valores por llamada
+        uint64_t unidades = 0;
+
+        explicit Medicion(const char *nombre)
+        {
+            if (!activo)
+                return;
+            h = &actual();
+            e = &etapa(*h, nombre);
+            antes.ns = ahora();
+            leer(*h, antes);
+        }
+
+        ~Medicion()
+        {
+            if (!e)
+                return;
+            Lectura despues;
+            leer(*h, despues);
+            despues.ns = ahora();
+            ++e->llamadas;
+            e->unidades += unidades;
+            e->ns += despues.ns - antes.ns;
+            // si el kernel alternó el grupo con otros, se escala por la fracción del tiempo que corrió
+            uint64_t corrio = despues.corriendo - antes.corriendo;
+            if (antes.n == 0 || despues.n == 0 || corrio == 0)
+                return;
+            double escala = double(despues.habilitado - antes.habilitado) / corrio;
+            for (int i = 0; i < N; ++i)
+                if (h->pos[i] >= 0)
+                {
+                    e->valor[i] += (despues.valor[h->pos[i]] - antes.valor[h->pos[i]]) * escala;
+                    ++e->medidas[i];
+                }
+        }
+
+        Medicion(const Medicion &) = delete;
+        Medicion &operator=(const Medicion &) = delete;
+    };
+
+    /// Suma las etapas de todos los hilos por nombre y escribe la tabla en cerr
+    inline void reportar()
+    {
+        std::vector<Etapa> total;
+        bool alguno = false;
+        for (Hilo *h = hilos.load(std::memory_order_acquire); h; h = h->siguiente)
+        {
+            alguno = alguno || h->lider >= 0;
+            for (const Etapa &e : h->etapas)
+            {
+                size_t k = 0;
+                while (k < total.size() && strcmp(total[k].nombre, e.nombre) != 0)
+                    ++k;
+                if (k == total.size())
+                    total.push_back(Etapa{e.nombre, 0, 0, 0, {}, {}});
+                Etapa &t = total[k];
+                t.llamadas += e.llamadas;
+                t.unidades += e.unidades;
+                t.ns += e.ns;
+                for (int i = 0; i < N; ++i)
+                {
+                    t.valor[i] += e.valor[i];
+                    t.medidas[i] += e.medidas[i];
+                }
+            }
+        }
+
+        // después de lo que el programa haya escrito
+        fflush(stdout);
+        fprintf(stderr, "\ncontadores por etapa, por unidad (o por llamada si no hay unidades): nanosegundos, "
+                        "ciclos,\nsaltos mal predichos y fallos de lectura en L1d y LLC; solo en espacio de usuario\n");
+        if (int err = error.load())
+        {
+            const char *causa = strerror(err);
+            if (err == EACCES || err == EPERM)
+                causa = "el kernel no lo permite (ver /proc/sys/kernel/perf_event_paranoid)";
+            else if (err == ENOENT || err == EOPNOTSUPP)
+                causa = "el procesador o la máquina virtual no los tiene";
+            else if (err == ENOSYS)
+                causa = "el kernel no tiene perf_event_open";
+            const char *cuales = alguno ? "algunos contadores no se pudieron abrir"
+                                        : "no se pudo abrir ningún contador, solo hay tiempos";
+            fprintf(stderr, "%s: %s\n", cuales, causa);
+        }
+        fprintf(stderr, "%-30s %9s %12s %11s %9s %6s %9s %9s %9s\n", "etapa", "llamadas", "unidades", "ns", "ciclos",
+                "IPC", "saltos", "L1d", "LLC");
+        for (const Etapa &t : total)
+        {
+            double d = t.unidades ? t.unidades : t.llamadas;
+            fprintf(stderr, "%-30s %9llu %12llu %11.2f", t.nombre, (unsigned long long)t.llamadas,
+                    (unsigned long long)t.unidades, t.ns / d);
+            auto columna = [&](int i, double v) {
+                if (t.medidas[i])
+                    fprintf(stderr, i == INSTRUCCIONES ? " %6.2f" : " %9.3f", v);
+                else
+                    fprintf(stderr, i == INSTRUCCIONES ? " %6s" : " %9s", "-");
+            };
+            columna(CICLOS, t.valor[CICLOS] / d);
+            columna(INSTRUCCIONES, t.valor[CICLOS] > 0 ? t.valor[INSTRUCCIONES] / t.valor[CICLOS] : 0);
+            columna(SALTOS, t.valor[SALTOS] / d);
+            columna(L1D, t.valor[L1D] / d);
+            columna(LLC, t.valor[LLC] / d);
+            fprintf(stderr, "\n");
+        }
+    }
+} // namespace contadores
+
+#define CONTADORES_CONCATENAR2(a, b) a##b
+#define CONTADORES_CONCATENAR(a, b) CONTADORES_CONCATENAR2(a, b)
+/// Mide desde aquí hasta el final del bloque como la etapa nombre, sin unidades
+#define CONTAR(nombre) contadores::Medicion CONTADORES_CONCATENAR(medicionContadores, __LINE__)(nombre)
+/// Igual, en la medición m, a la que CONTAR_UNIDADES(m, n) le indica las unidades procesadas
+#define CONTAR_EN(m, nombre) contadores::Medicion m(nombre)
+#define CONTAR_UNIDADES(m, n) ((m).unidades = (n))
+
+#else
+
+#define CONTAR(nombre) ((void)0)
+#define CONTAR_EN(m, nombre) ((void)0)
+#define CONTAR_UNIDADES(m, n) ((void)sizeof(n))
+
+#endif
+
+#endif
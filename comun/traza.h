@@ -0,0 +1,209 @@
+/**
+ * @file    traza.h
+ * @version 1.0
+ * @date    19/10/2026
+ * @title   Traza de las etapas en formato de Chrome
+ * @brief   Registra cuánto dura cada etapa (léxico, sintáctico, semántico, lectura de archivos y
+ *          las etapas de la calculadora) y en qué hilo corre, y al terminar el programa lo escribe
+ *          como JSON de trace events, que se abre en chrome://tracing o en Perfetto.
+ *
+ *          Solo se compila con -DCON_TRAZA; sin esa macro TRAZA(nombre) no genera código. Con
+ *          ella, la traza se registra si la variable de ambiente TRAZA tiene la ruta del archivo
+ *          donde escribirla (TRAZA=traza.json ./programa ...); si no, cada tramo cuesta una
+ *          comparación.
+ *
+ *          Cada hilo escribe sus tramos en sus propios bloques de eventos, sin candados ni
+ *          operaciones atómicas salvo al publicar cuántos eventos lleva; un hilo nuevo se agrega a
+ *          la lista de hilos con compare_exchange. Los bloques no se liberan: al salir, una función
+ *          registrada con atexit recorre la lista y escribe todos los eventos.
+ */
+
+#ifndef TRAZA_H
+#define TRAZA_H
+
+#ifdef CON_TRAZA
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+namespace traza
+{
+    struct Evento
+    {
+        /// Nombre del tramo; debe ser una literal (se guarda el apuntador)
+        const char *nombre;
+        /// Nanosegundos desde el inicio del programa
+        uint64_t inicio, fin;
+    };
+
+    /// Eventos de un hilo; cuando se llena, el hilo encadena otro
+    struct Bloque
+    {
+        static const uint32_t CAPACIDAD = 1 << 14;
+        Evento eventos[CAPACIDAD];
+        /// Eventos ya escritos (se publica después de escribir cada uno)
+        std::atomic<uint32_t> n{0};
+        std::atomic<Bloque *> siguiente{nullptr};
+    };
+
+    struct Hilo
+    {
+        uint32_t id;
+        std::string nombre;
+        Bloque *primero, *actual;
+        Hilo *siguiente;
+    };
+
+    inline std::atomic<Hilo *> hilos{nullptr};
+    inline std::atomic<uint32_t> nHilos{0};
+    inline const std::chrono::steady_clock::time_point origen = std::chrono::steady_clock::now();
+    /// La inicialización de variables globales corre en el hilo principal
+    inline const std::thread::id principal = std::this_thread::get_id();
+
+    inline uint64_t ahora()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origen)
+            .count();
+    }
+
+    inline void escribir();
+
+    /// Ruta del archivo de la traza, o nulo si no se registra
+    inline const char *const ruta = [] {
+        const char *r = getenv("TRAZA");
+        if (!r || !*r)
+            return (const char *)nullptr;
+        atexit(escribir);
+        return r;
+    }();
+
+    /// Hilo que ejecuta el código; se registra la primera vez que escribe un tramo
+    inline Hilo *&actual()
+    {
+        static thread_local Hilo *h = nullptr;
+        return h;
+    }
+
+    inline Hilo *registrar()
+    {
+        Hilo *h = new Hilo{nHilos.fetch_add(1), "", new Bloque, nullptr, nullptr};
+        h->actual = h->primero;
+        h->nombre = std::this_thread::get_id() == principal ? "principal" : "hilo " + std::to_string(h->id);
+        h->siguiente = hilos.load(std::memory_order_relaxed);
+        while (!hilos.compare_exchange_weak(h->siguiente, h, std::memory_order_release, std::memory_order_relaxed))
+            ;
+        return actual() = h;
+    }
+
+    inline void agregar(const char *nombre, uint64_t inicio, uint64_t fin)
+    {
+        Hilo *h = actual() ? actual() : registrar();
+        Bloque *b = h->actual;
+        uint32_t n = b->n.load(std::memory_order_relaxed);
+        if (n == Bloque::CAPACIDAD)
+        {
+            Bloque *nuevo = new Bloque;
+            b->siguiente.store(nuevo, std::memory_order_release);
+            h->actual = b = nuevo;
+            n = 0;
+        }
+        b->eventos[n] = Evento{nombre, inicio, fin};
+        b->n.store(n + 1, std::memory_order_release);
+    }
+
+    /// Nombre con el que aparece el hilo actual en la traza
+    inline void nombrarHilo(const std::string &nombre)
+    {
+        if (!ruta)
+            return;
+        (actual() ? actual() : registrar())->nombre = nombre;
+    }
+
+    /// Tramo desde que se construye hasta que se destruye
+    class Tramo
+    {
+        const char *nombre;
+        uint64_t inicio;
+
+    public:
+        explicit Tramo(const char *n) : nombre(n), inicio(ruta ? ahora() : 0) {}
+        ~Tramo()
+        {
+            if (ruta)
+                agregar(nombre, inicio, ahora());
+        }
+    };
+
+    /// Escribe s como cadena de JSON, escapando comillas, diagonales invertidas y caracteres de control
+    inline void escribirCadena(FILE *f, const char *s)
+    {
+        fputc('"', f);
+        for (; *s; ++s)
+        {
+            unsigned char c = *s;
+            if (c == '"' || c == '\\')
+                fprintf(f, "\\%c", c);
+            else if (c < 0x20)
+                fprintf(f, "\\u%04x", c);
+            else
+                fputc(c, f);
+        }
+        fputc('"', f);
+    }
+
+    /// Escribe todos los eventos registrados en ruta (los hilos ya deberían haber terminado)
+    inline void escribir()
+    {
+        FILE *f = fopen(ruta, "w");
+        if (!f)
+        {
+            fprintf(stderr, "traza: no se pudo escribir %s\n", ruta);
+            return;
+        }
+        fprintf(f, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+        const char *sep = "";
+        for (Hilo *h = hilos.load(std::memory_order_acquire); h; h = h->siguiente)
+        {
+            fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", sep,
+                    h->id);
+            escribirCadena(f, h->nombre.c_str());
+            fprintf(f, "}}");
+            sep = ",\n";
+            for (Bloque *b = h->primero; b; b = b->siguiente.load(std::memory_order_acquire))
+            {
+                uint32_t n = b->n.load(std::memory_order_acquire);
+                for (uint32_t i = 0; i < n; ++i)
+                {
+                    const Evento &e = b->eventos[i];
+                    fprintf(f, "%s{\"name\":", sep);
+                    escribirCadena(f, e.nombre);
+                    fprintf(f, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", h->id, e.inicio / 1e3,
+                            (e.fin - e.inicio) / 1e3);
+                }
+            }
+        }
+        fprintf(f, "\n]}\n");
+        fclose(f);
+    }
+} // namespace traza
+
+#define TRAZA_CONCATENAR2(a, b) a##b
+#define TRAZA_CONCATENAR(a, b) TRAZA_CONCATENAR2(a, b)
+/// Registra un tramo con el nombre dado desde aquí hasta el final del bloque
+#define TRAZA(nombre) traza::Tramo TRAZA_CONCATENAR(tramoTraza, __LINE__)(nombre)
+/// Nombre del hilo actual en la traza
+#define TRAZA_HILO(nombre) traza::nombrarHilo(nombre)
+
+#else
+
+#define TRAZA(nombre) ((void)0)
+#define TRAZA_HILO(nombre) ((void)0)
+
+#endif
+
+#endif